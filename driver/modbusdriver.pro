@@ -35,6 +35,21 @@ SOURCES += \
     src/main.cpp \
     src/mainwindow.cpp \
     src/modbusmanager.cpp \
+    src/modbus_tcp_engine.cpp \
+    src/modbus_request_pacer.cpp \
+    src/modbus_request_scheduler.cpp \
+    src/modbus_submission_queue.cpp \
+    src/poll_timing_wheel.cpp \
+    src/poll_deadline_queue.cpp \
+    src/poll_plan.cpp \
+    src/poll_point_table.cpp \
+    src/consistent_hash_ring.cpp \
+    src/pending_request_table.cpp \
+    src/block_decode_plan.cpp \
+    src/register_decode_kernels.cpp \
+    src/modbus_bit_buffer.cpp \
+    src/report_by_exception_filter.cpp \
+    src/single_flight_table.cpp \
     src/scada_core_service.cpp \
     src/connection_resilience_manager.cpp \
     src/modbus_worker.cpp \
@@ -44,6 +59,23 @@ SOURCES += \
 HEADERS += \
     include/mainwindow.h \
     include/modbusmanager.h \
+    include/modbus_tcp_engine.h \
+    include/modbus_request_pacer.h \
+    include/modbus_request_scheduler.h \
+    include/modbus_submission_queue.h \
+    include/poll_timing_wheel.h \
+    include/poll_deadline_queue.h \
+    include/poll_plan.h \
+    include/poll_point_table.h \
+    include/consistent_hash_ring.h \
+    include/bounded_stage_queue.h \
+    include/pending_request_table.h \
+    include/block_decode_plan.h \
+    include/register_byte_order.h \
+    include/register_decode_kernels.h \
+    include/modbus_bit_buffer.h \
+    include/report_by_exception_filter.h \
+    include/single_flight_table.h \
     include/scada_core_service.h \
     include/connection_resilience_manager.h \
     include/modbus_worker.h
@@ -0,0 +1,87 @@
+#ifndef BLOCK_DECODE_PLAN_H
+#define BLOCK_DECODE_PLAN_H
+
+#include <QMap>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include "modbusmanager.h"
+#include "data_processing_task.h"
+
+// Where one original point of an optimized block sits in the block's registers
+struct BlockDecodeEntry {
+    int offset;                 // Registers from the block start
+    int width;                  // Registers the value spans (1, 2 or 4)
+    ModbusDataType dataType;
+    RegisterByteOrder byteOrder;
+    RegisterValueDecoder decoder; // Instantiated for dataType and byteOrder at compile time
+    int slot;                   // Output slot: index of the point in BlockDecodePlan::points()
+    int span;                   // Index in BlockDecodePlan::spans(), or -1 when decoded alone
+};
+
+// Run of back-to-back FLOAT32, INT32 or DOUBLE64 entries decoded by one
+// RegisterDecodeKernels call
+struct BlockDecodeSpan {
+    int offset;                 // Registers from the block start
+    int values;                 // Number of entries in the run
+    ModbusDataType dataType;
+    RegisterByteOrder byteOrder;
+    int firstSlot;              // Slots are consecutive within a run
+};
+
+// Typed layout of an optimized block read, parsed once from the block's
+// original_* tags when DatabaseManager::optimizeModbusReadBlocks() creates the
+// block. ScadaCoreService::handleBlockReadResult() decodes a reply with one
+// pass over the entries instead of splitting and comparing tag strings.
+// Immutable once compiled; shared between copies of the block point.
+class BlockDecodePlan
+{
+public:
+    // Per-point output metadata, prepared at compile time
+    struct Point {
+        QString name;
+        QString measurement;
+        QString description;
+        QString dataTypeName;             // Original database data_type string
+        int address;
+        QMap<QString, QString> tags;      // Block tags plus this point's mapping tags
+        DataAcquisitionPoint source;      // Source point used for InfluxDB tag validation
+    };
+
+    // Null when the block's metadata tags are missing or inconsistent
+    static QSharedPointer<const BlockDecodePlan> compile(const DataAcquisitionPoint &blockPoint);
+
+    static ModbusDataType dataTypeFromName(const QString &name);
+    static int registerWidth(ModbusDataType dataType);
+
+    // Accepts ABCD, CDAB, BADC and DCBA (any case); anything else is ABCD with ok = false
+    static RegisterByteOrder byteOrderFromName(const QString &name, bool *ok = nullptr);
+    static QString byteOrderName(RegisterByteOrder order);
+
+    // Decoder specialized for the type and order; single-register types ignore the order
+    static RegisterValueDecoder valueDecoder(ModbusDataType dataType, RegisterByteOrder order);
+
+    const QVector<BlockDecodeEntry> &entries() const { return m_entries; }
+    const QVector<BlockDecodeSpan> &spans() const { return m_spans; }
+    const QVector<Point> &points() const { return m_points; }
+    int requiredRegisters() const { return m_requiredRegisters; }  // Highest offset + width
+
+    // Writes each entry's value to values[entry.slot]; entries that don't fit
+    // in count registers are left invalid. No allocation.
+    void decode(const quint16 *registers, int count, QVariant *values) const;
+    // Coil/discrete blocks: each entry reads the bit at its offset (0 or 1)
+    void decodeBits(const ModbusBitBuffer &bits, QVariant *values) const;
+
+private:
+    BlockDecodePlan() : m_requiredRegisters(0) {}
+
+    void groupSpans();
+
+    QVector<BlockDecodeEntry> m_entries;
+    QVector<BlockDecodeSpan> m_spans;
+    QVector<Point> m_points;
+    int m_requiredRegisters;
+};
+
+#endif // BLOCK_DECODE_PLAN_H
@@ -0,0 +1,162 @@
+#ifndef BOUNDED_STAGE_QUEUE_H
+#define BOUNDED_STAGE_QUEUE_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// What a full pipeline stage queue does with the next item
+enum class StageQueuePolicy {
+    Block,          // Keep it and report backpressure so the producer slows down
+    DropOldest,     // Drop the oldest queued item
+    CoalesceLatest  // Replace the queued item of the same point; drop the oldest when none
+};
+
+struct StageQueueMetrics {
+    int depth;
+    int capacity;
+    int highWater;      // Deepest the queue has been
+    qint64 accepted;
+    qint64 dropped;
+    qint64 coalesced;
+
+    StageQueueMetrics() : depth(0), capacity(0), highWater(0), accepted(0), dropped(0), coalesced(0) {}
+};
+
+// FIFO between two pipeline stages (acquisition -> decode -> sink) with a
+// capacity and a full policy. Items carry a point key for CoalesceLatest.
+// With Block the queue keeps accepting items already in flight, but reports
+// backpressure from capacity until it drains to half of it. Past twice the
+// capacity it drops the oldest item anyway, so memory stays bounded.
+// Not thread-safe; the owner serializes access. ParallelDataProcessor guards its
+// decode queue with m_taskCountMutex; ScadaCoreService's sink queue is only
+// touched on the service thread.
+template <typename T>
+class BoundedStageQueue
+{
+public:
+    enum PushResult {
+        Queued,
+        Coalesced,          // Replaced the queued item with the same key (copied to *displaced)
+        QueuedDroppedOldest // Queued after dropping the oldest item (copied to *displaced)
+    };
+
+    explicit BoundedStageQueue(int capacity = 1024, StageQueuePolicy policy = StageQueuePolicy::Block)
+        : m_headSequence(0), m_backpressure(false)
+    {
+        configure(capacity, policy);
+    }
+
+    void configure(int capacity, StageQueuePolicy policy)
+    {
+        m_metrics.capacity = qMax(1, capacity);
+        m_policy = policy;
+        m_keyIndex.clear();
+        if (m_policy == StageQueuePolicy::CoalesceLatest) {
+            for (int i = 0; i < m_items.size(); ++i) {
+                m_keyIndex.insert(m_items.at(i).key, m_headSequence + i);
+            }
+        }
+        updateBackpressure();
+    }
+
+    StageQueuePolicy policy() const { return m_policy; }
+    int capacity() const { return m_metrics.capacity; }
+    int size() const { return m_items.size(); }
+    bool isEmpty() const { return m_items.isEmpty(); }
+    bool isBackpressured() const { return m_backpressure; }
+
+    PushResult push(const QString &key, const T &item, T *displaced = nullptr)
+    {
+        m_metrics.accepted++;
+
+        if (m_policy == StageQueuePolicy::CoalesceLatest) {
+            auto queued = m_keyIndex.constFind(key);
+            if (queued != m_keyIndex.constEnd()) {
+                T &slot = m_items[static_cast<int>(queued.value() - m_headSequence)].item;
+                if (displaced) {
+                    *displaced = slot;
+                }
+                slot = item;
+                m_metrics.coalesced++;
+                return Coalesced;
+            }
+        }
+
+        const int limit = m_policy == StageQueuePolicy::Block ? 2 * m_metrics.capacity : m_metrics.capacity;
+        PushResult result = Queued;
+        if (m_items.size() >= limit) {
+            T oldest = take();
+            if (displaced) {
+                *displaced = oldest;
+            }
+            m_metrics.dropped++;
+            result = QueuedDroppedOldest;
+        }
+
+        if (m_policy == StageQueuePolicy::CoalesceLatest) {
+            m_keyIndex.insert(key, m_headSequence + m_items.size());
+        }
+        m_items.append(Entry{key, item});
+        m_metrics.highWater = qMax(m_metrics.highWater, m_items.size());
+        updateBackpressure();
+        return result;
+    }
+
+    const T &head() const { return m_items.first().item; }
+
+    T take()
+    {
+        Entry entry = m_items.takeFirst();
+        if (m_policy == StageQueuePolicy::CoalesceLatest) {
+            auto indexed = m_keyIndex.find(entry.key);
+            if (indexed != m_keyIndex.end() && indexed.value() == m_headSequence) {
+                m_keyIndex.erase(indexed);
+            }
+        }
+        m_headSequence++;
+        updateBackpressure();
+        return entry.item;
+    }
+
+    void clear()
+    {
+        m_headSequence += m_items.size();
+        m_items.clear();
+        m_keyIndex.clear();
+        updateBackpressure();
+    }
+
+    StageQueueMetrics metrics() const
+    {
+        StageQueueMetrics metrics = m_metrics;
+        metrics.depth = m_items.size();
+        return metrics;
+    }
+
+private:
+    struct Entry {
+        QString key;
+        T item;
+    };
+
+    void updateBackpressure()
+    {
+        if (m_policy != StageQueuePolicy::Block) {
+            m_backpressure = false;
+        } else if (m_items.size() >= m_metrics.capacity) {
+            m_backpressure = true;
+        } else if (m_items.size() <= m_metrics.capacity / 2) {
+            m_backpressure = false;
+        }
+    }
+
+    QList<Entry> m_items;
+    QHash<QString, quint64> m_keyIndex;  // CoalesceLatest: key -> sequence of its queued item
+    quint64 m_headSequence;              // Sequence of m_items.first()
+    StageQueuePolicy m_policy;
+    StageQueueMetrics m_metrics;
+    bool m_backpressure;
+};
+
+#endif // BOUNDED_STAGE_QUEUE_H
@@ -0,0 +1,39 @@
+#ifndef CONSISTENT_HASH_RING_H
+#define CONSISTENT_HASH_RING_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+
+// Consistent hash ring mapping device keys to nodes (ModbusWorkerManager I/O
+// loop indexes). Each node owns several virtual points on a 32-bit ring, so
+// keys spread evenly and adding or removing a node only moves the keys that
+// node gains or loses. The hash is stable across runs and platforms.
+// Not thread-safe; ModbusWorkerManager guards it with m_workersMutex.
+class ConsistentHashRing
+{
+public:
+    explicit ConsistentHashRing(int virtualNodes = DEFAULT_VIRTUAL_NODES);
+
+    void addNode(int node);
+    void removeNode(int node);
+    void clear();
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+    int nodeCount() const { return m_nodes.size(); }
+
+    // Node owning key, or -1 when the ring is empty
+    int nodeFor(const QString &key) const;
+
+    static quint32 hashKey(const QString &key);
+
+private:
+    static const int DEFAULT_VIRTUAL_NODES = 64;
+
+    static quint32 mix(quint32 h);
+
+    QMap<quint32, int> m_ring;  // Ring position -> node
+    QList<int> m_nodes;
+    int m_virtualNodes;
+};
+
+#endif // CONSISTENT_HASH_RING_H
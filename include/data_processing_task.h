@@ -6,10 +6,18 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include <QThreadPool>
+#include <QSharedPointer>
 #include "modbusmanager.h"
+#include "bounded_stage_queue.h"
+#include "register_byte_order.h"
+#include "report_by_exception_filter.h"
 
 // Forward declarations
 class ScadaCoreService;
+class BlockDecodePlan;
+
+// Decodes one value of a point's data type and byte order from its first register
+typedef QVariant (*RegisterValueDecoder)(const quint16 *registers);
 
 // Data structures (moved from scada_core_service.h to avoid circular dependency)
 struct DataAcquisitionPoint {
@@ -24,9 +32,13 @@ struct DataAcquisitionPoint {
     QString measurement;             // InfluxDB measurement name
     QMap<QString, QString> tags;     // InfluxDB tags
     bool enabled;                    // Enable/disable this point
+    QSharedPointer<const BlockDecodePlan> blockDecodePlan; // Optimized blocks: decode layout compiled from the original_* tags
+    RegisterByteOrder byteOrder;     // Byte/word order of multi-register values
+    RegisterValueDecoder valueDecoder; // Compiled from dataType and byteOrder; null until compiled
+    ReportDeadband deadband;         // Report-by-exception band; disabled reports every sample
     
     DataAcquisitionPoint() : port(502), address(0), unitId(1), dataType(ModbusDataType::HoldingRegister), 
-                           pollInterval(1000), enabled(true) {}
+                           pollInterval(1000), enabled(true), byteOrder(RegisterByteOrder::ABCD), valueDecoder(nullptr) {}
 };
 
 struct AcquiredDataPoint {
@@ -114,9 +126,11 @@ private:
      * @param rawData Raw register values from Modbus response
      * @param dataType Target data type for conversion
      * @param offset Starting offset in raw data array
+     * @param decoder Point's compiled decoder; multi-register values use its byte order
      * @return QVariant Decoded value or invalid QVariant on error
      */
-    QVariant decodeModbusData(const QVector<quint16> &rawData, ModbusDataType dataType, int offset = 0);
+    QVariant decodeModbusData(const ModbusRegisterBuffer &rawData, ModbusDataType dataType, int offset = 0,
+                              RegisterValueDecoder decoder = nullptr);
     
     /**
      * @brief Validate decoded data value and range
@@ -152,7 +166,8 @@ private:
  * @brief Parallel data processing coordinator
  * 
  * Manages parallel data processing tasks using QThreadPool to ensure
- * simultaneous processing of responses from multiple devices.
+ * simultaneous processing of responses from multiple devices. At most one
+ * task per pool thread runs at a time; the rest wait in a bounded queue.
  */
 class ParallelDataProcessor : public QObject
 {
@@ -192,6 +207,25 @@ public:
      * @return bool True if all tasks completed within timeout
      */
     bool waitForCompletion(int timeoutMs = 5000);
+    
+    /**
+     * @brief Bound the queue of tasks waiting for a free thread
+     * @param capacity Maximum number of waiting tasks
+     * @param policy What a full queue does with the next task
+     */
+    void setQueueLimits(int capacity, StageQueuePolicy policy);
+    
+    /**
+     * @brief Get depth, drop and coalesce counters of the waiting queue
+     * @return StageQueueMetrics Queue metrics snapshot
+     */
+    StageQueueMetrics getQueueMetrics() const;
+    
+    /**
+     * @brief Check whether the waiting queue asks producers to slow down
+     * @return bool True while a Block-policy queue is full (until half drained)
+     */
+    bool isBackpressured() const;
 
 signals:
     /**
@@ -209,6 +243,16 @@ signals:
      * @param deviceKey Device identifier
      */
     void taskFailed(qint64 requestId, const QString &errorMessage, const QString &deviceKey);
+    
+    /**
+     * @brief Emitted when a queued task is coalesced or dropped before it runs
+     * @param requestId Request identifier
+     * @param reason Why the task left the queue
+     * @param deviceKey Device identifier
+     *
+     * Not a processing failure; the queue counts these in StageQueueMetrics.
+     */
+    void taskDiscarded(qint64 requestId, const QString &reason, const QString &deviceKey);
 
 private slots:
     /**
@@ -222,10 +266,30 @@ private slots:
     void onTaskFailed(qint64 requestId, const QString &errorMessage, const QString &deviceKey);
 
 private:
+    struct PendingTask {
+        qint64 requestId;
+        ModbusReadResult result;
+        DataAcquisitionPoint point;
+        ScadaCoreService *service;
+        
+        PendingTask() : requestId(0), service(nullptr) {}
+    };
+    
+    /**
+     * @brief Start queued tasks while pool threads are free
+     */
+    void startPendingTasks();
+    
+    /**
+     * @brief Report a task that left the queue without running
+     */
+    void discardTask(const PendingTask &task, const QString &reason);
+    
     QThreadPool *m_threadPool;             ///< Thread pool for parallel processing
     mutable QMutex m_taskCountMutex;       ///< Mutex for task counting
     QWaitCondition m_completionCondition;  ///< Condition for waiting completion
     int m_activeTaskCount;                 ///< Current active task count
+    BoundedStageQueue<PendingTask> m_pendingTasks; ///< Tasks waiting for a free thread (guarded by m_taskCountMutex)
 };
 
 #endif // DATA_PROCESSING_TASK_H
\ No newline at end of file
@@ -76,6 +76,8 @@ private:
     QString m_executionMode;
     
     void setLastError(const QString &error);
+    RegisterByteOrder byteOrderFor(const QString &deviceName, const QString &tagName) const;
+    ReportDeadband deadbandFor(const QString &deviceName, const QString &tagName) const;
     
     // Helper methods for block optimization
     bool isDataTypeCompatibleForBlock(ModbusDataType type1, ModbusDataType type2) const;
@@ -0,0 +1,66 @@
+#ifndef MODBUS_BIT_BUFFER_H
+#define MODBUS_BIT_BUFFER_H
+
+#include <QByteArray>
+#include <QVector>
+
+// Packed coil / discrete-input states of one read: bit i of the read is bit
+// (i % 64) of word i / 64. Bits past size() are kept clear, so whole-word
+// operations (popcount, XOR against the previous frame) need no tail masking.
+// Replaces the one-quint16-per-bit register payload for FC 1/2 reads.
+class ModbusBitBuffer
+{
+public:
+    ModbusBitBuffer() : m_size(0) {}
+    explicit ModbusBitBuffer(int bitCount);  // All bits clear
+
+    // Modbus PDU layout: bit i at bit (i % 16) of words[i / 16], i.e. the response's
+    // data bytes taken two at a time, low byte first. Reads (bitCount + 15) / 16 words.
+    static ModbusBitBuffer fromPackedWords(const quint16 *words, int bitCount);
+    // One value per bit, non-zero meaning set (QModbusDataUnit layout)
+    static ModbusBitBuffer fromBitValues(const quint16 *values, int count);
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    bool testBit(int index) const { return (m_words.at(index >> 6) >> (index & 63)) & 1; }
+    void setBit(int index, bool value);
+
+    int wordCount() const { return m_words.size(); }
+    const quint64 *words() const { return m_words.constData(); }
+
+    int count() const;  // Set bits
+    ModbusBitBuffer mid(int position, int length) const;
+
+    // Change detection against the previous frame of the same read. A frame
+    // of a different size counts every bit as changed.
+    ModbusBitBuffer changedSince(const ModbusBitBuffer &previous) const;  // Set where the state flipped
+    int changedCountSince(const ModbusBitBuffer &previous) const;         // Without allocating
+
+    // Calls function(index) for every set bit, skipping clear words
+    template <typename Function>
+    void forEachSetBit(Function function) const
+    {
+        for (int w = 0; w < m_words.size(); ++w) {
+            quint64 word = m_words.at(w);
+            while (word) {
+                function(w * 64 + countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    QByteArray toPackedBytes() const;      // PDU byte order, (size() + 7) / 8 bytes
+    QVector<quint16> toBitValues() const;  // One 0/1 value per bit
+
+    bool operator==(const ModbusBitBuffer &other) const { return m_size == other.m_size && m_words == other.m_words; }
+    bool operator!=(const ModbusBitBuffer &other) const { return !(*this == other); }
+
+private:
+    static int countTrailingZeros(quint64 word);
+    void clearTail();
+
+    QVector<quint64> m_words;
+    int m_size;
+};
+
+#endif // MODBUS_BIT_BUFFER_H
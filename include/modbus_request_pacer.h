@@ -0,0 +1,57 @@
+#ifndef MODBUS_REQUEST_PACER_H
+#define MODBUS_REQUEST_PACER_H
+
+#include <QtGlobal>
+
+// Token-bucket rate limiter for one Modbus device (unit ID on a connection).
+// A rate of 0 means unlimited: requests go out at line rate until the device
+// reports it is busy. A busy response halves the allowed rate (starting from the
+// observed request rate when unlimited), at most once per window: replies to
+// requests sent before the last cut were paced at the old rate and are ignored.
+// Sustained success raises the rate again in small steps until the configured
+// rate (or unlimited) is restored.
+class ModbusRequestPacer
+{
+public:
+    explicit ModbusRequestPacer(double ratePerSecond = 0.0, int burst = 1);
+
+    void configure(double ratePerSecond, int burst);
+    void setAdaptive(bool adaptive) { m_adaptive = adaptive; }
+
+    // Milliseconds until a token is available (0 = send now)
+    int msUntilAvailable(qint64 nowMs);
+    // Consumes one token; call only when msUntilAvailable() returned 0
+    void consume(qint64 nowMs);
+
+    // Response feedback for adaptive pacing. sentMs is when the refused request
+    // went out; returns false when the reply predates the last cut and was ignored.
+    bool onDeviceBusy(qint64 nowMs, qint64 sentMs);
+    void onSuccess(qint64 nowMs);
+
+    double currentRate() const { return m_rate; }   // 0 = unlimited
+    double configuredRate() const { return m_configuredRate; }
+    bool isThrottled() const { return m_rate > 0.0 && m_rate != m_configuredRate; }
+
+private:
+    static constexpr double MIN_RATE = 0.5;              // Requests/s floor when learning
+    static constexpr double RECOVERY_FACTOR = 0.1;       // Additive increase per step (of current rate)
+    static constexpr qint64 RECOVERY_HOLDOFF_MS = 5000;  // Quiet period after a busy reply
+    static constexpr qint64 RECOVERY_STEP_MS = 1000;     // Minimum spacing of increases
+
+    void refill(qint64 nowMs);
+
+    double m_configuredRate;   // Requests/s from configuration (0 = unlimited)
+    double m_rate;             // Current allowed rate (0 = unlimited)
+    double m_unthrottleRate;   // Observed rate at the last busy reply when unlimited
+    int m_burst;
+    double m_tokens;
+    qint64 m_lastRefill;
+    bool m_adaptive;
+
+    double m_observedInterval; // EWMA of the spacing between sends (ms)
+    qint64 m_lastSend;
+    qint64 m_lastBusy;
+    qint64 m_lastIncrease;
+};
+
+#endif // MODBUS_REQUEST_PACER_H
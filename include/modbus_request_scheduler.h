@@ -0,0 +1,100 @@
+#ifndef MODBUS_REQUEST_SCHEDULER_H
+#define MODBUS_REQUEST_SCHEDULER_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QVector>
+#include "modbusmanager.h"
+
+// PriorityModbusRequest structure for queue management
+struct PriorityModbusRequest {
+    ModbusRequest request;
+    RequestPriority priority;
+    qint64 requestId;
+    qint64 queueTime;
+    qint64 dispatchTime;  // Set when handed to ModbusManager
+    bool interruptible;
+
+    PriorityModbusRequest() : priority(RequestPriority::Normal), requestId(0),
+                             queueTime(0), dispatchTime(0), interruptible(false) {}
+
+    // Comparison operator for priority queue (higher priority first)
+    bool operator<(const PriorityModbusRequest &other) const {
+        if (priority != other.priority) {
+            return static_cast<int>(priority) < static_cast<int>(other.priority);
+        }
+        // Same priority: FIFO order (earlier queue time first)
+        return queueTime > other.queueTime;
+    }
+};
+
+// Request scheduler for ModbusWorker.
+// One binary min-heap per (priority, unit lane) keyed by effective deadline and
+// arrival sequence, so push and pop are O(log n). Within a priority, requests
+// run earliest deadline first. Requests without a deadline are due on arrival,
+// which keeps them in FIFO order. Superseded polls are dropped lazily when they
+// reach the top of their heap. With unit fairness each unit ID gets its own lane
+// and lanes are served round-robin within a priority. Without it all requests
+// share one lane.
+// Not thread-safe; ModbusWorker guards it with m_queueMutex.
+class ModbusRequestScheduler
+{
+public:
+    ModbusRequestScheduler();
+
+    // Round-robin across unit IDs within a priority (shared gateway connections).
+    // Only change while the scheduler is empty.
+    void setUnitFairness(bool enabled) { m_unitFairness = enabled; }
+    bool isUnitFairness() const { return m_unitFairness; }
+
+    // Queues a request. A queued poll of the same range (same priority, function,
+    // unit, address, count and data type; both with deadlines) is superseded: it is
+    // removed and copied to *superseded, and true is returned.
+    bool push(const PriorityModbusRequest &request, PriorityModbusRequest *superseded = nullptr);
+
+    // Most urgent request, or one with requestId 0 when empty. Polls whose
+    // deadline passed before now are skipped and appended to *expired.
+    PriorityModbusRequest pop(qint64 now, QList<PriorityModbusRequest> *expired = nullptr);
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+    bool hasPriorityAbove(RequestPriority priority) const;
+
+    // Removes every queued request, returned in arrival order
+    QList<PriorityModbusRequest> takeAll();
+    void clear();
+
+private:
+    static const int PRIORITY_LEVELS = 4;  // RequestPriority::Low .. Critical
+
+    struct HeapEntry {
+        qint64 deadline;    // Effective deadline (queue time when the request has none)
+        quint64 sequence;   // Arrival order, breaks ties FIFO
+
+        bool operator>(const HeapEntry &other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    struct Level {
+        QMap<int, QVector<HeapEntry>> lanes;  // Unit ID (or 0 without fairness) -> heap
+        int lastUnit;                         // Round-robin cursor
+        int live;                             // Queued requests not yet superseded
+
+        Level() : lastUnit(-1), live(0) {}
+    };
+
+    static int levelIndex(RequestPriority priority);
+    static quint64 pollKey(const PriorityModbusRequest &request);
+    QMap<int, QVector<HeapEntry>>::iterator selectLane(Level &level);
+
+    Level m_levels[PRIORITY_LEVELS];
+    QHash<quint64, PriorityModbusRequest> m_entries;  // Live requests by sequence
+    QHash<quint64, quint64> m_pollIndex;              // Poll key -> sequence of the queued poll
+    quint64 m_nextSequence;
+    int m_size;
+    bool m_unitFairness;
+};
+
+#endif // MODBUS_REQUEST_SCHEDULER_H
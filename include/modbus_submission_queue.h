@@ -0,0 +1,40 @@
+#ifndef MODBUS_SUBMISSION_QUEUE_H
+#define MODBUS_SUBMISSION_QUEUE_H
+
+#include <QAtomicInteger>
+#include <QScopedArrayPointer>
+#include "modbus_request_scheduler.h"
+
+// Bounded lock-free multi-producer/single-consumer queue for handing requests
+// to a ModbusWorker. Producers (service thread, worker poll generation, tests)
+// claim a slot with one compare-and-swap and never block; a full queue is
+// reported instead of waited on. Each slot carries a sequence number that says
+// whether it is free for the producer of that lap or published for the consumer.
+// Only one thread may pop at a time; ModbusWorker pops under m_queueMutex.
+class ModbusSubmissionQueue
+{
+public:
+    explicit ModbusSubmissionQueue(int capacity);  // Rounded up to a power of two
+
+    // Any thread. Returns false without waiting when the queue is full.
+    bool tryPush(const PriorityModbusRequest &request);
+    // Consumer only. Returns false when empty (or the next slot is still being written).
+    bool tryPop(PriorityModbusRequest &request);
+
+    int capacity() const { return static_cast<int>(m_mask + 1); }
+
+private:
+    struct Slot {
+        QAtomicInteger<quint32> sequence;
+        PriorityModbusRequest request;
+    };
+
+    Q_DISABLE_COPY(ModbusSubmissionQueue)
+
+    QScopedArrayPointer<Slot> m_slots;
+    quint32 m_mask;
+    alignas(64) QAtomicInteger<quint32> m_enqueuePos;  // Shared by producers
+    alignas(64) quint32 m_dequeuePos;                   // Consumer only
+};
+
+#endif // MODBUS_SUBMISSION_QUEUE_H
@@ -0,0 +1,116 @@
+#ifndef MODBUS_TCP_ENGINE_H
+#define MODBUS_TCP_ENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include <QModbusDevice>
+#include <QHostAddress>
+
+class QHostInfo;
+class QSocketNotifier;
+class QTimer;
+
+// Native Modbus TCP client engine (Linux only).
+// Does its own MBAP framing on a non-blocking socket driven by epoll, reusing
+// preallocated frame and receive buffers. The epoll descriptor is watched by a
+// single QSocketNotifier, so the engine runs in the owning thread's event loop
+// without allocating a QModbusReply per transaction. Responses are reported by
+// MBAP transaction ID; request bookkeeping stays with ModbusManager.
+class ModbusTcpEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum FunctionCode : quint8 {
+        ReadCoils = 0x01,
+        ReadDiscreteInputs = 0x02,
+        ReadHoldingRegisters = 0x03,
+        ReadInputRegisters = 0x04,
+        WriteSingleCoil = 0x05,
+        WriteSingleRegister = 0x06,
+        WriteMultipleCoils = 0x0F,
+        WriteMultipleRegisters = 0x10
+    };
+
+    explicit ModbusTcpEngine(QObject *parent = nullptr);
+    ~ModbusTcpEngine();
+
+    // True when the engine is compiled in for this platform
+    static bool isSupported();
+
+    // Connection management. Host names are resolved asynchronously: the engine
+    // stays in ConnectingState until the lookup and handshake finish or time out.
+    bool connectToHost(const QString &host, int port, int timeoutMs);
+    void disconnectFromHost();
+    bool isConnected() const { return m_state == QModbusDevice::ConnectedState; }
+    QModbusDevice::State state() const { return m_state; }
+
+    // Transactions (frames are queued on the socket immediately; no reply object)
+    bool sendReadRequest(quint16 transactionId, int unitId, FunctionCode functionCode,
+                         int startAddress, int count);
+    bool sendWriteRegisters(quint16 transactionId, int unitId, int startAddress,
+                            const QVector<quint16> &values);
+    bool sendWriteCoils(quint16 transactionId, int unitId, int startAddress,
+                        const QVector<bool> &values);
+
+    // Runs bytes through the MBAP parser as if they had arrived on the socket;
+    // lets protocol tests drive framing without a connection
+    void processReceivedData(const char *data, int length);
+
+signals:
+    // values holds registers for FC 3/4, the packed bit bytes two per value (low
+    // byte first, see ModbusBitBuffer::fromPackedWords) for FC 1/2 and the echoed
+    // address/value pair for write function codes. byteCount is the byte count
+    // of a read response (0 for writes); matching it against the request is left
+    // to ModbusManager.
+    void responseReceived(quint16 transactionId, quint8 unitId, quint8 functionCode,
+                          int byteCount, const QVector<quint16> &values);
+    // Well-framed ADU whose PDU does not parse (byte count disagrees with the
+    // MBAP length, truncated write echo); the connection stays up
+    void malformedResponse(quint16 transactionId, quint8 functionCode, const QString &error);
+    void exceptionReceived(quint16 transactionId, quint8 functionCode, quint8 exceptionCode);
+    void stateChanged(QModbusDevice::State state);
+    void errorOccurred(const QString &error);
+
+private slots:
+    void onEpollActivated();
+    void onConnectTimeout();
+    void onHostResolved(const QHostInfo &hostInfo);
+
+private:
+    static const int MBAP_HEADER_SIZE = 7;         // Transaction, protocol, length, unit
+    static const int MAX_ADU_SIZE = 260;           // MBAP header + 253 byte PDU
+    static const int RX_BUFFER_SIZE = 64 * 1024;   // Preallocated receive buffer
+    static const int MAX_EPOLL_EVENTS = 4;
+
+    bool openSocket(const QHostAddress &address, int port);  // Starts a non-blocking connect
+    bool queueFrame(int length);
+    bool flushTransmitBuffer();
+    void readAvailable();
+    void parseFrames();
+    void updateEpollInterest(bool wantWrite);
+    void finishConnect();
+    void setState(QModbusDevice::State state);
+    void closeSocket(const QString &error = QString());
+
+    int m_socketFd;
+    int m_epollFd;
+    QSocketNotifier *m_notifier;   // Watches the epoll descriptor
+    QTimer *m_connectTimer;
+    QModbusDevice::State m_state;
+    bool m_wantWrite;              // EPOLLOUT currently registered
+
+    quint8 m_frame[MAX_ADU_SIZE];  // Request frame assembly buffer
+    QByteArray m_txBuffer;         // Pending outbound bytes (capacity reserved once)
+    int m_txOffset;
+    QByteArray m_rxBuffer;         // Fixed-size inbound buffer
+    int m_rxLength;
+    quint32 m_socketGeneration;    // Bumped by closeSocket(); detects a close from a signal handler
+    QVector<quint16> m_values;     // Reused decode buffer for responses
+    int m_lookupId;                // Pending QHostInfo lookup (-1 = none)
+    int m_lookupPort;
+};
+
+#endif // MODBUS_TCP_ENGINE_H
@@ -4,13 +4,17 @@
 #include <QObject>
 #include <QThread>
 #include <QTimer>
-#include <QQueue>
 #include <QMutex>
 #include <QWaitCondition>
 #include <QMap>
+#include <QHash>
 #include <QAtomicInteger>
 #include <QSemaphore>
 #include "modbusmanager.h"
+#include "modbus_request_scheduler.h"
+#include "modbus_submission_queue.h"
+#include "single_flight_table.h"
+#include "poll_timing_wheel.h"
 
 // Forward declaration
 struct DataAcquisitionPoint;
@@ -30,27 +34,6 @@ enum class ModbusErrorType {
 };
 Q_DECLARE_METATYPE(ModbusErrorType)
 
-// PriorityModbusRequest structure for queue management
-struct PriorityModbusRequest {
-    ModbusRequest request;
-    RequestPriority priority;
-    qint64 requestId;
-    qint64 queueTime;
-    bool interruptible;
-    
-    PriorityModbusRequest() : priority(RequestPriority::Normal), requestId(0), 
-                             queueTime(0), interruptible(false) {}
-    
-    // Comparison operator for priority queue (higher priority first)
-    bool operator<(const PriorityModbusRequest &other) const {
-        if (priority != other.priority) {
-            return static_cast<int>(priority) < static_cast<int>(other.priority);
-        }
-        // Same priority: FIFO order (earlier queue time first)
-        return queueTime > other.queueTime;
-    }
-};
-
 // Forward declarations
 class ModbusWorkerManager;
 
@@ -72,12 +55,17 @@ public:
         qint64 failedRequests;
         qint64 interruptedRequests;
         qint64 highPriorityRequests;
+        qint64 expiredRequests;     // Polls dropped because their deadline passed in the queue
+        qint64 mergedRequests;      // Queued polls superseded by a newer poll of the same range
+        qint64 rejectedRequests;    // Submissions refused because the submission queue was full
+        qint64 sharedRequests;      // Reads answered by an identical read already in flight
         double averageResponseTime;
         qint64 lastActivityTime;
         bool isConnected;
         
         WorkerStatistics() : totalRequests(0), successfulRequests(0), failedRequests(0),
                            interruptedRequests(0), highPriorityRequests(0), 
+                           expiredRequests(0), mergedRequests(0), rejectedRequests(0), sharedRequests(0),
                            averageResponseTime(0.0), lastActivityTime(0), isConnected(false) {}
     };
 
@@ -86,6 +74,11 @@ public:
     
     // Device identification
     QString getDeviceKey() const;
+    
+    // Gateway connection sharing: one connection and scheduler for every unit ID on
+    // host:port. Must be set before the worker is started; the device key becomes host:port.
+    void setSharedConnection(bool shared);
+    bool isSharedConnection() const { return m_sharedConnection; }
     QString getHost() const { return m_host; }
     int getPort() const { return m_port; }
     int getUnitId() const { return m_unitId; }
@@ -97,13 +90,16 @@ public:
     WorkerStatistics getStatistics() const;
     void resetStatistics();
     
-    // Request queuing (thread-safe)
+    // Request queuing (thread-safe, never blocks; interrupted if the submission queue is full)
     qint64 queueReadRequest(const ModbusRequest &request, RequestPriority priority = RequestPriority::Normal);
     qint64 queueWriteRequest(const ModbusRequest &request, RequestPriority priority = RequestPriority::Normal, bool interruptible = true);
     
     // Polling control
     int getPollInterval() const;
     
+    // Concurrency limit for requests outstanding on the connection
+    int getMaxConcurrentRequests() const;
+    
     // Request batching configuration
     void setBatchingEnabled(bool enabled);
     bool isBatchingEnabled() const;
@@ -146,6 +142,7 @@ public slots:
     // Polling control (thread-safe)
     void setPollInterval(int intervalMs);
     void setPollingEnabled(bool enabled);
+    void setMaxConcurrentRequests(int maxRequests);
     
     // Data point management methods (setters - must be slots for cross-thread calls)
     void setDataPointCount(int count);
@@ -181,7 +178,6 @@ private slots:
     void onModbusWriteCompleted(const ModbusWriteResult &result);
     void onModbusConnectionStateChanged(bool connected);
     void onModbusError(const QString &error);
-    void onBatchTimeout();  // Handle batch timeout
     void onHealthCheckTimer();  // Handle health check timer
     void onHeartbeatTimer();  // Handle keep-alive heartbeat timer
 private:
@@ -196,13 +192,28 @@ private:
     
     // Request queue management
     mutable QMutex m_queueMutex;
-    QQueue<PriorityModbusRequest> m_requestQueue;
+    ModbusRequestScheduler m_requestQueue;  // Priority/deadline heaps, per-unit lanes when shared
+    
+    // Submissions from any thread; drained into m_requestQueue on the worker thread
+    ModbusSubmissionQueue m_submissionQueue;
+    QAtomicInteger<int> m_drainScheduled;    // 1 while a processRequestQueue call is pending
+    static const int SUBMISSION_QUEUE_CAPACITY = 4096;
+    
     QAtomicInteger<qint64> m_nextRequestId;
     
-    // Current request tracking
-    PriorityModbusRequest m_currentRequest;
-    bool m_requestInProgress;
-    QTimer *m_requestTimeoutTimer;
+    // In-flight request tracking, keyed by ModbusManager transaction ID
+    QHash<quint16, PriorityModbusRequest> m_inFlightRequests;
+    int m_maxConcurrentRequests;     // Outstanding requests allowed on the connection
+    QTimer *m_requestTimeoutTimer;   // Armed for the oldest in-flight request
+    
+    // Coalesced reads: original requests answered from one merged read, by its transaction ID
+    QHash<quint16, QList<PriorityModbusRequest>> m_coalescedReads;
+    
+    // Single-flight reads: duplicates of a read on the wire wait for its result
+    SingleFlightTable m_singleFlights;
+    
+    // Gateway connection sharing
+    bool m_sharedConnection;         // Serves every unit ID on host:port
     
     // Polling
     QTimer *m_pollTimer;
@@ -236,9 +247,7 @@ private:
     // Request batching
     bool m_batchingEnabled;          // Enable/disable request batching
     int m_maxBatchSize;              // Maximum requests per batch
-    QTimer *m_batchTimer;            // Timer for batch processing
-    QQueue<PriorityModbusRequest> m_batchQueue;  // Temporary batch queue
-    static const int BATCH_TIMEOUT_MS = 100;     // Batch collection timeout
+    static const int COALESCE_MAX_GAP = 5;       // Unrequested addresses allowed between coalesced reads
     
     // Connection health monitoring
     bool m_healthMonitoringEnabled;  // Enable/disable health monitoring
@@ -262,30 +271,45 @@ private:
     // Data point management for automatic polling
     mutable QMutex m_dataPointsMutex;
     QVector<DataAcquisitionPoint> m_dataPoints;
-    QMap<QString, qint64> m_lastPollTimes;  // Track last poll time for each data point
+    QVector<qint64> m_nextPollTimes;        // Next due time per data point (parallel to m_dataPoints)
+    PollTimingWheel m_pollWheel;            // Data point indexes by next due time
     bool m_automaticPollingEnabled;         // Enable/disable automatic data point polling
     
     // Connection coordination
     static QSemaphore s_connectionSemaphore;                 // Limit simultaneous connections
     
     // Private methods
-    void executeRequest(const PriorityModbusRequest &request);
-    void completeCurrentRequest(bool success, const QString &error = QString());
+    quint16 executeRequest(const PriorityModbusRequest &request);  // Transaction ID, 0 if rejected (reported)
+    void rejectRequest(const PriorityModbusRequest &request, const QString &reason);
+    void completeRequest(quint16 transactionId, bool success, const QString &error = QString());
+    void armRequestTimeout();
+    int requestTimeoutMs() const;
     void updateStatistics(bool success, qint64 responseTime = 0);
+    qint64 submitRequest(const ModbusRequest &request, RequestPriority priority, bool interruptible);
+    void drainSubmissionQueue();
     void insertRequestByPriority(const PriorityModbusRequest &request);
+    void reportExpiredRequests(const QList<PriorityModbusRequest> &expired);
     PriorityModbusRequest getNextRequest();
     bool hasHigherPriorityRequest(RequestPriority currentPriority) const;
     void emitStatisticsUpdate();
     void generateAutomaticPollingRequests();
+    void rebuildPollWheel();  // After m_dataPoints indexes shift
     void handleConnectionFailure(const QString &errorMessage);
     void adjustAdaptivePollInterval(bool success);  // Adjust polling based on connection health
-    void processBatchQueue();                       // Process batched requests
-    void executeBatchedRequests(const QList<PriorityModbusRequest> &batch);  // Execute a batch of requests
-    bool canBatchRequests(const PriorityModbusRequest &req1, const PriorityModbusRequest &req2) const;  // Check if requests can be batched
+    bool executeBatchedRequests(const QList<PriorityModbusRequest> &batch);  // Execute a batch, coalescing adjacent reads; false once the window is full
+    void dispatchCoalescedRead(const QList<PriorityModbusRequest> &span);  // One PDU for an address-sorted span
+    void completeCoalescedRead(const ModbusReadResult &result);              // Split a coalesced read back per request
+    bool joinSingleFlight(const PriorityModbusRequest &request);             // True if attached to an identical read in flight
+    void resolveSingleFlight(qint64 leaderId, const ModbusReadResult &result);  // Answer the leader's followers
+    void abortSingleFlight(qint64 leaderId, const QString &reason);          // Leader produced no data
+    void abortAllSingleFlights(const QString &reason);
+    void interruptQueuedRequests(const QString &reason);                     // Queue emptied; each request interrupted (m_queueMutex held)
+    void interruptInFlightRequest(quint16 transactionId, const QString &reason);  // No result will arrive; interrupt what the PDU carries
     void updateConnectionHealth(bool success);      // Update connection health score
     void performHealthCheck();                      // Perform periodic health check
     bool shouldAttemptReconnection() const;         // Check if reconnection should be attempted
     void resetConnectionHealth();                   // Reset health monitoring state
+    void recoverFromRequestTimeout(const QString &timeoutReason);  // Health update and stale connection recovery
     ModbusErrorType classifyError(const QString &errorMessage) const;  // Classify error types for enhanced handling
     void emitClassifiedError(const QString &errorMessage);             // Emit both regular and classified error signals
     void sendHeartbeat();                                              // Send keep-alive heartbeat request
@@ -7,6 +7,9 @@
 #include <QTimer>
 #include <QThread>
 #include <QStringList>
+#include <QVector>
+#include <QElapsedTimer>
+#include "consistent_hash_ring.h"
 
 // Forward declarations
 class ModbusWorker;
@@ -19,6 +22,10 @@ namespace ModbusWorkerTypes {
         qint64 failedRequests;
         qint64 interruptedRequests;
         qint64 highPriorityRequests;
+        qint64 expiredRequests;
+        qint64 mergedRequests;
+        qint64 rejectedRequests;
+        qint64 sharedRequests;
         double averageResponseTime;
         qint64 lastActivityTime;
         bool isConnected;
@@ -44,6 +51,8 @@ public:
     struct WorkerInfo {
         ModbusWorker* worker;
         QThread* thread;
+        int loopIndex;                  // Shared I/O loop when sharded, -1 for a dedicated thread
+        qint64 requestsAtRebalance;     // lastStats.totalRequests at the previous loop rebalance
         bool isConnected;
         ModbusWorkerTypes::WorkerStatistics lastStats;
     };
@@ -58,6 +67,7 @@ public:
     void removeAllWorkers();
 
     // Device management
+    QString deviceKeyFor(const QString &host, int port, int unitId) const;  // Key of the worker serving this device
     QStringList getActiveDevices() const;
     QStringList getConnectedDevices() const;
     int getWorkerCount() const;
@@ -69,6 +79,24 @@ public:
     // Configuration
     void setDefaultPollInterval(int intervalMs);
     void setWorkerPollInterval(const QString &deviceKey, int intervalMs);
+    
+    // Gateway mode: one worker and connection per host:port shared by every unit ID
+    // behind a Modbus TCP gateway, with a per-host limit on outstanding requests.
+    // Applies to workers created after the call.
+    void setGatewayModeEnabled(bool enabled);
+    bool isGatewayModeEnabled() const;
+    void setGatewayConcurrencyLimit(int maxRequests);
+    int getGatewayConcurrencyLimit() const;
+    
+    // Event-loop sharding: workers run on a fixed pool of I/O threads (loopCount 0 =
+    // one per core) instead of one thread each. A device's loop is picked by
+    // consistent hashing of its key, and workers move off a loop whose event
+    // dispatch lag runs high. Applies to workers created after the call; a new loop
+    // count takes effect once all workers are removed.
+    void setEventLoopSharding(bool enabled, int loopCount = 0);
+    bool isEventLoopSharding() const;
+    int getIoLoopCount() const;
+    QVector<double> getIoLoopLags() const;  // Smoothed event dispatch lag per loop (ms)
 
     // Load balancing and coordination
     QString getLeastLoadedWorker() const;
@@ -96,6 +124,7 @@ private slots:
     void onWorkerStatisticsUpdated(const QString &deviceKey, const ModbusWorkerTypes::WorkerStatistics &stats);
     void updateGlobalStatistics();
     void handleDelayedStartup(const QString &deviceKey);
+    void probeIoLoops();
 
 private:
     // Helper methods
@@ -104,6 +133,11 @@ private:
     void cleanupWorker(const QString &deviceKey);
     void calculateWorkerLoads() const;
     void rebalanceWorkerLoads();
+    int loopForDevice(const QString &deviceKey);  // Caller holds m_workersMutex
+    void startIoLoops();                          // Caller holds m_workersMutex
+    void stopIoLoops();                           // Caller holds m_workersMutex
+    void onIoLoopProbed(int loop, qint64 lagMs);
+    void rebalanceIoLoops();
 
     // Member variables
     QHash<QString, WorkerInfo> m_workers;
@@ -114,8 +148,21 @@ private:
     QTimer* m_statsUpdateTimer;
     bool m_loadBalancingEnabled;
     QTimer* m_loadBalancingTimer;
+    bool m_gatewayModeEnabled;
+    int m_gatewayConcurrencyLimit;
     mutable QMutex m_loadBalancingMutex;
     
+    // Event-loop sharding (guarded by m_workersMutex)
+    bool m_shardingEnabled;
+    int m_ioLoopCount;                          // Configured pool size (0 = ideal thread count)
+    QVector<QThread*> m_ioLoops;
+    QVector<QObject*> m_ioLoopProbes;           // One per loop, living in it, for lag probes
+    QVector<double> m_ioLoopLags;               // EWMA of probe dispatch lag (ms)
+    ConsistentHashRing m_loopRing;
+    QHash<QString, int> m_loopOverrides;        // Devices moved off their ring loop by rebalancing
+    QTimer* m_ioLoopProbeTimer;
+    QElapsedTimer m_ioLoopClock;
+    
     // Pending startup tracking
     struct PendingStartup {
         ModbusWorker* worker;
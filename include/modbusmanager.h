@@ -8,11 +8,16 @@
 #include <QTimer>
 #include <QQueue>
 #include <QMap>
+#include <QHash>
 #include <QVector>
 #include <QVariant>
 #include <QVariantMap>
 #include <QSettings>
 #include <QDateTime>
+#include "modbus_request_pacer.h"
+#include "modbus_bit_buffer.h"
+
+class ModbusTcpEngine;
 
 // Forward declarations
 enum class RequestPriority {
@@ -35,6 +40,12 @@ enum class ModbusDataType {
     BOOL
 };
 
+// Coils and discrete inputs travel as packed bits (ModbusReadResult::bits)
+inline bool isBitDataType(ModbusDataType dataType)
+{
+    return dataType == ModbusDataType::Coil || dataType == ModbusDataType::DiscreteInput;
+}
+
 // Modbus request structure
 struct ModbusRequest {
     enum Type {
@@ -60,10 +71,40 @@ struct ModbusRequest {
     QString requestId;
     bool isInterruptible;
     QString deviceKey;  // host:port identifier
+    quint16 transactionId;  // Assigned by ModbusManager when the request is queued
+    qint64 deadline;        // Epoch ms after which a poll's data is stale (0 = no deadline)
     
     ModbusRequest() : type(ReadHoldingRegisters), startAddress(0), count(1), 
                      unitId(1), dataType(ModbusDataType::HoldingRegister), requestTime(0),
-                     priority(RequestPriority::Normal), isInterruptible(true) {}
+                     priority(RequestPriority::Normal), isInterruptible(true), transactionId(0),
+                     deadline(0) {}
+};
+
+// Immutable, reference-counted register payload.
+// Filled once from the reply and shared by every stage a ModbusReadResult passes
+// through (queued signals, worker, core service, processing tasks). Only const
+// access is exposed, so copies never detach the underlying storage.
+class ModbusRegisterBuffer {
+public:
+    ModbusRegisterBuffer() {}
+    explicit ModbusRegisterBuffer(const QVector<quint16> &registers) : m_registers(registers) {}
+    explicit ModbusRegisterBuffer(QVector<quint16> &&registers) : m_registers(std::move(registers)) {}
+    
+    int size() const { return m_registers.size(); }
+    bool isEmpty() const { return m_registers.isEmpty(); }
+    quint16 at(int index) const { return m_registers.at(index); }
+    quint16 operator[](int index) const { return m_registers.at(index); }
+    quint16 first() const { return m_registers.first(); }
+    const quint16 *constData() const { return m_registers.constData(); }
+    ModbusRegisterBuffer mid(int position, int length) const { return ModbusRegisterBuffer(m_registers.mid(position, length)); }
+    QVector<quint16>::const_iterator begin() const { return m_registers.constBegin(); }
+    QVector<quint16>::const_iterator end() const { return m_registers.constEnd(); }
+    
+    // Shared view for APIs that take a vector; never copies the registers
+    const QVector<quint16> &registers() const { return m_registers; }
+    
+private:
+    QVector<quint16> m_registers;
 };
 
 // Modbus read result structure
@@ -71,13 +112,15 @@ struct ModbusReadResult {
     bool success;
     QString errorString;
     QModbusDevice::Error errorType;
-    QVector<quint16> rawData;
-    QVariantMap processedData;
+    ModbusRegisterBuffer rawData;   // Register reads; empty for coil/discrete reads
+    ModbusBitBuffer bits;           // Coil/discrete reads, one bit per input
+    QVariantMap processedData;  // Empty when ModbusManager eager decode is disabled
     int startAddress;
     int registerCount;
     ModbusDataType dataType;
     qint64 timestamp;
     bool hasValidData;
+    quint16 transactionId;  // Matches ModbusRequest::transactionId of the originating request
     
     // IEEE 754 validation flags
     bool hasNaN;
@@ -87,8 +130,13 @@ struct ModbusReadResult {
     ModbusReadResult() : success(false), errorType(QModbusDevice::NoError), 
                         startAddress(0), registerCount(0), 
                         dataType(ModbusDataType::HoldingRegister), timestamp(0), 
-                        hasValidData(false), hasNaN(false), hasInf(false), 
+                        hasValidData(false), transactionId(0), hasNaN(false), hasInf(false), 
                         hasDenormalized(false) {}
+    
+    // Typed on-demand view over rawData, decoded according to dataType.
+    // Indexes are value positions (e.g. one Float32 per two registers), not registers.
+    int valueCount() const;
+    QVariant valueAt(int index) const;
 };
 
 // Modbus write result structure
@@ -99,9 +147,10 @@ struct ModbusWriteResult {
     int startAddress;
     int registerCount;
     qint64 timestamp;
+    quint16 transactionId;  // Matches the ID returned by the ModbusManager write call
     
     ModbusWriteResult() : success(false), errorType(QModbusDevice::NoError), 
-                         startAddress(0), registerCount(0), timestamp(0) {}
+                         startAddress(0), registerCount(0), timestamp(0), transactionId(0) {}
 };
 
 class ModbusManager : public QObject
@@ -109,6 +158,10 @@ class ModbusManager : public QObject
     Q_OBJECT
 
 public:
+    // Modbus application protocol limits per read PDU
+    static const int MAX_READ_REGISTERS = 125;   // FC 3/4
+    static const int MAX_READ_BITS = 2000;       // FC 1/2
+    
     explicit ModbusManager(QObject *parent = nullptr);
     ~ModbusManager();
     
@@ -119,6 +172,24 @@ public:
     bool loadConfigurationFromFile(const QString &configPath);
     int getConnectionTimeout() const { return m_connectionTimeout; }
     int getRequestTimeout() const { return m_requestTimeout; }
+    int getMaxInFlight() const { return m_maxInFlight; }
+    void setMaxInFlight(int maxInFlight);
+    int inFlightCount() const { return m_inFlight.size(); }
+    
+    // Optional native epoll engine (Linux). Takes effect on the next connectToServer().
+    void setNativeEngineEnabled(bool enabled) { m_useNativeEngine = enabled; }
+    bool isNativeEngineEnabled() const { return m_useNativeEngine; }
+    
+    // Eager decode fills ModbusReadResult::processedData; when disabled results carry
+    // only raw registers and consumers use the typed view (valueAt) instead.
+    void setEagerDecodeEnabled(bool enabled) { m_eagerDecode = enabled; }
+    bool isEagerDecodeEnabled() const { return m_eagerDecode; }
+    
+    // Per-device pacing: token bucket per unit ID (rate 0 = unlimited). With adaptive
+    // pacing, device-busy exceptions lower a unit's rate and success restores it.
+    void setPacing(double ratePerSecond, int burst);
+    void setAdaptivePacingEnabled(bool enabled);
+    double getPacingRate(int unitId) const;
     
     // Connection management
     bool connectToServer(const QString &host, int port = 502);
@@ -126,33 +197,36 @@ public:
     bool isConnected() const;
     bool isClientInitialized() const;
     
+    // Read and write operations return the transaction ID assigned to the request
+    // (reported back in the result's transactionId), or 0 if it was rejected.
+    
     // Single read operations
-    void readHoldingRegister(int address, ModbusDataType dataType, int unitId = 1);
-    void readInputRegister(int address, ModbusDataType dataType, int unitId = 1);
-    void readCoil(int address, int unitId = 1);
-    void readDiscreteInput(int address, int unitId = 1);
+    quint16 readHoldingRegister(int address, ModbusDataType dataType, int unitId = 1);
+    quint16 readInputRegister(int address, ModbusDataType dataType, int unitId = 1);
+    quint16 readCoil(int address, int unitId = 1);
+    quint16 readDiscreteInput(int address, int unitId = 1);
     
     // Multiple read operations
-    void readHoldingRegisters(int startAddress, int count, ModbusDataType dataType, int unitId = 1);
-    void readInputRegisters(int startAddress, int count, ModbusDataType dataType, int unitId = 1);
-    void readCoils(int startAddress, int count, int unitId = 1);
-    void readDiscreteInputs(int startAddress, int count, int unitId = 1);
+    quint16 readHoldingRegisters(int startAddress, int count, ModbusDataType dataType, int unitId = 1);
+    quint16 readInputRegisters(int startAddress, int count, ModbusDataType dataType, int unitId = 1);
+    quint16 readCoils(int startAddress, int count, int unitId = 1);
+    quint16 readDiscreteInputs(int startAddress, int count, int unitId = 1);
     
     // Single write operations
-    void writeHoldingRegister(int address, quint16 value, int unitId = 1);
-    void writeHoldingRegisterFloat32(int address, float value, int unitId = 1);
-    void writeHoldingRegisterDouble64(int address, double value, int unitId = 1);
-    void writeHoldingRegisterLong32(int address, qint32 value, int unitId = 1);
-    void writeHoldingRegisterLong64(int address, qint64 value, int unitId = 1);
-    void writeCoil(int address, bool value, int unitId = 1);
+    quint16 writeHoldingRegister(int address, quint16 value, int unitId = 1);
+    quint16 writeHoldingRegisterFloat32(int address, float value, int unitId = 1);
+    quint16 writeHoldingRegisterDouble64(int address, double value, int unitId = 1);
+    quint16 writeHoldingRegisterLong32(int address, qint32 value, int unitId = 1);
+    quint16 writeHoldingRegisterLong64(int address, qint64 value, int unitId = 1);
+    quint16 writeCoil(int address, bool value, int unitId = 1);
     
     // Multiple write operations
-    void writeHoldingRegisters(int startAddress, const QVector<quint16> &values, int unitId = 1);
-    void writeHoldingRegistersFloat32(int startAddress, const QVector<float> &values, int unitId = 1);
-    void writeHoldingRegistersDouble64(int startAddress, const QVector<double> &values, int unitId = 1);
-    void writeHoldingRegistersLong32(int startAddress, const QVector<qint32> &values, int unitId = 1);
-    void writeHoldingRegistersLong64(int startAddress, const QVector<qint64> &values, int unitId = 1);
-    void writeCoils(int startAddress, const QVector<bool> &values, int unitId = 1);
+    quint16 writeHoldingRegisters(int startAddress, const QVector<quint16> &values, int unitId = 1);
+    quint16 writeHoldingRegistersFloat32(int startAddress, const QVector<float> &values, int unitId = 1);
+    quint16 writeHoldingRegistersDouble64(int startAddress, const QVector<double> &values, int unitId = 1);
+    quint16 writeHoldingRegistersLong32(int startAddress, const QVector<qint32> &values, int unitId = 1);
+    quint16 writeHoldingRegistersLong64(int startAddress, const QVector<qint64> &values, int unitId = 1);
+    quint16 writeCoils(int startAddress, const QVector<bool> &values, int unitId = 1);
     
     // IEEE 754 validation functions
     static bool isFloat32Valid(float value);
@@ -182,6 +256,16 @@ public:
     
     // Data processing functions
     static QVariantMap convertRawData(const QVector<quint16> &rawData, ModbusDataType dataType);
+    static QVariantMap convertBitData(const ModbusBitBuffer &bits);  // "bits" (packed PDU bytes) and "bit_count"
+    
+    // Result for a sub-range of a coalesced read, decoded as dataType
+    ModbusReadResult sliceReadResult(const ModbusReadResult &result, int startAddress, int count,
+                                     ModbusDataType dataType);
+    
+    // Why a native engine response cannot answer request (function code, unit or
+    // read byte count differ); empty when it matches
+    static QString nativeResponseMismatch(const ModbusRequest &request, quint8 unitId,
+                                          quint8 functionCode, int byteCount);
 
 signals:
     void readCompleted(const ModbusReadResult &result);
@@ -196,20 +280,41 @@ private slots:
     void onErrorOccurred(QModbusDevice::Error error);
     void processNextRequest();
     void onRequestTimeout();
+    
+    // Native engine callbacks
+    void onNativeResponse(quint16 transactionId, quint8 unitId, quint8 functionCode,
+                          int byteCount, const QVector<quint16> &values);
+    void onNativeException(quint16 transactionId, quint8 functionCode, quint8 exceptionCode);
+    void onNativeMalformedResponse(quint16 transactionId, quint8 functionCode, const QString &error);
+    void onNativeStateChanged(QModbusDevice::State state);
 
 private:
     // Core components
     QModbusTcpClient *m_modbusClient;
     QTimer *m_requestTimer;
     QTimer *m_timeoutTimer;
+    ModbusTcpEngine *m_nativeEngine;  // Created on connect when m_useNativeEngine is set
+    bool m_useNativeEngine;
+    
+    // Pipelined transaction tracking: every outstanding read is one MBAP transaction,
+    // keyed by our transaction ID. With QModbusTcpClient the reply object carries the
+    // wire-level match; the native engine uses our ID as the MBAP transaction ID.
+    struct InFlightTransaction {
+        ModbusRequest request;
+        QModbusReply *reply;  // nullptr on the native engine
+        qint64 sentTime;
+        qint64 deadline;
+        
+        InFlightTransaction() : reply(nullptr), sentTime(0), deadline(0) {}
+    };
     
     // Request management
     QQueue<ModbusRequest> m_requestQueue;
-    bool m_requestInProgress;
-    QModbusReply *m_currentReply;
-    qint64 m_currentRequestTime;
+    QHash<quint16, InFlightTransaction> m_inFlight;     // Outstanding transactions by ID
+    QHash<QModbusReply*, quint16> m_replyTransactions;  // Qt reply -> transaction ID
+    int m_maxInFlight;                                  // In-flight window (1 = strict request/response)
+    quint16 m_nextTransactionId;
     QMap<QModbusReply*, QPair<int, int>> m_replyAddressMap;
-    QMap<QModbusReply*, ModbusDataType> m_pendingReads;
     
     // Configuration
     QSettings *m_settings;
@@ -220,15 +325,31 @@ private:
     int m_requestTimeout;
     int m_connectionTimeout;
     QString m_networkType;
-    int m_requestInterval;
+    bool m_eagerDecode;
+    
+    // Request pacing
+    static const int SEND_RETRY_DELAY_MS = 100;  // Retry spacing when nothing could be sent
+    QHash<int, ModbusRequestPacer> m_pacers;     // Token bucket per unit ID
+    double m_pacingRate;                         // Requests/s per unit (0 = unlimited)
+    int m_pacingBurst;
+    bool m_adaptivePacing;                       // Learn from device-busy exceptions
     
     // Helper methods
-    void queueRequest(const ModbusRequest &request);
-    void executeRequest(const ModbusRequest &request);
-    void completeCurrentRequest();
+    quint16 queueRequest(const ModbusRequest &request);
+    quint16 nextTransactionId();
+    bool executeRequest(const ModbusRequest &request);
+    bool executeNativeRequest(const ModbusRequest &request);
+    void trackTransaction(const ModbusRequest &request, QModbusReply *reply);
+    void completeTransaction(quint16 transactionId);
+    void failTransaction(quint16 transactionId, const ModbusRequest &request,
+                         QModbusDevice::Error errorType, const QString &errorString);
     void handleRequestTimeout();
+    void armTimeoutTimer();
+    ModbusRequestPacer &pacerFor(int unitId);
+    void updatePacing(int unitId, bool success, bool deviceBusy, qint64 sentTime = 0);  // sentTime 0 = now
     ModbusReadResult processReadReply(QModbusReply *reply, ModbusDataType dataType);
     ModbusWriteResult processWriteReply(QModbusReply *reply, int startAddress, int count);
+    void finalizeReadResult(ModbusReadResult &result);
     void validateIEEE754Data(ModbusReadResult &result);
 };
 
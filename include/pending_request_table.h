@@ -0,0 +1,56 @@
+#ifndef PENDING_REQUEST_TABLE_H
+#define PENDING_REQUEST_TABLE_H
+
+#include <QVector>
+
+// In-flight read requests of ScadaCoreService: (issuing worker, request id) ->
+// compact handle into the data point table. Worker request ids restart at 1
+// for every worker, so the worker is part of the key. One flat array with
+// linear probing and backward-shift deletion: no per-request allocations,
+// no tombstones, no rebalancing.
+// Not thread-safe; ScadaCoreService guards it with m_requestTrackingMutex.
+class PendingRequestTable
+{
+public:
+    struct Handle {
+        quint32 pointIndex;   // Index into m_dataPoints (kept current by removePoint())
+        quint32 generation;   // The point's generation when the request was sent
+
+        Handle() : pointIndex(0), generation(0) {}
+        Handle(quint32 index, quint32 gen) : pointIndex(index), generation(gen) {}
+    };
+
+    explicit PendingRequestTable(int initialCapacity = 64);
+
+    // source identifies the issuer and must not be 0. Replaces an existing entry.
+    void insert(quintptr source, qint64 requestId, Handle handle);
+    bool take(quintptr source, qint64 requestId, Handle *handle = nullptr);
+    void clear();
+
+    // The point at pointIndex was removed: handles of later points move down one
+    // index with their point. Handles of the removed point are left to fail the
+    // generation check. Linear in capacity; point removal is rare.
+    void removePoint(quint32 pointIndex);
+
+    int size() const { return m_size; }
+    int capacity() const { return m_slots.size(); }
+
+private:
+    struct Slot {
+        quintptr source;      // 0 = empty
+        qint64 requestId;
+        Handle handle;
+
+        Slot() : source(0), requestId(0) {}
+    };
+
+    int homeSlot(quintptr source, qint64 requestId) const;
+    int findSlot(quintptr source, qint64 requestId) const;  // -1 when absent
+    void grow();
+
+    QVector<Slot> m_slots;    // Power-of-two size
+    int m_mask;
+    int m_size;
+};
+
+#endif // PENDING_REQUEST_TABLE_H
@@ -0,0 +1,49 @@
+#ifndef POLL_DEADLINE_QUEUE_H
+#define POLL_DEADLINE_QUEUE_H
+
+#include <QHash>
+#include <QVector>
+
+// Min-heap of data point indexes by next poll deadline (epoch ms).
+// ScadaCoreService arms one timer for nextDeadline() and takes exactly the
+// due points when it fires. Rescheduling or cancelling an index leaves the old
+// heap entry behind; stale entries are dropped when they reach the top.
+// Not thread-safe; ScadaCoreService guards it with m_dataPointsMutex.
+class PollDeadlineQueue
+{
+public:
+    PollDeadlineQueue();
+
+    void schedule(int index, qint64 deadlineMs);  // (Re)schedules index
+    void cancel(int index);
+    bool isScheduled(int index) const { return m_live.contains(index); }
+    int size() const { return m_live.size(); }
+    bool isEmpty() const { return m_live.isEmpty(); }
+    void clear();
+
+    // Earliest live deadline, or -1 when nothing is scheduled
+    qint64 nextDeadline();
+    // Removes and returns the indexes due at nowMs, earliest deadline first.
+    // At most maxCount when it is not negative; the rest stay due.
+    QVector<int> takeDue(qint64 nowMs, int maxCount = -1);
+
+private:
+    struct Entry {
+        qint64 deadline;
+        quint64 sequence;  // Unique per schedule(); FIFO among equal deadlines
+
+        bool operator>(const Entry &other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    void dropStaleTop();
+    void compact();
+
+    QVector<Entry> m_heap;
+    QHash<quint64, int> m_indexBySequence;  // Live entries only
+    QHash<int, quint64> m_live;             // Index -> sequence of its current entry
+    quint64 m_nextSequence;
+};
+
+#endif // POLL_DEADLINE_QUEUE_H
@@ -0,0 +1,37 @@
+#ifndef POLL_PLAN_H
+#define POLL_PLAN_H
+
+#include <QPointer>
+#include <QString>
+#include "modbusmanager.h"
+#include "data_processing_task.h"
+
+class ModbusWorker;
+
+// Read request for one data point, compiled once from its tags when the poll
+// schedule is rebuilt. ScadaCoreService dispatches polls from the plan, so the
+// per-poll path does no tag lookups, string parsing or device key formatting.
+// Single-threaded and multi-threaded mode derive the function code, data type
+// and count differently, so a plan is only valid for the mode it was compiled for.
+struct PollPlan {
+    ModbusRequest::Type functionType;
+    ModbusDataType dataType;          // Decode type of the response
+    int unitId;
+    int startAddress;
+    int count;                        // Registers or bits (blocks clamped to 125)
+    int rank;                         // Dispatch order among points due together (lower first)
+    bool isBlock;                     // Optimized block read
+    bool simulated;                   // simulation_mode tag: no Modbus traffic
+    QString deviceKey;                // host:port:unit
+    QPointer<ModbusWorker> worker;    // Multi-threaded mode; resolved on first poll
+
+    PollPlan() : functionType(ModbusRequest::ReadHoldingRegisters), dataType(ModbusDataType::HoldingRegister),
+                 unitId(1), startAddress(0), count(1), rank(0), isBlock(false), simulated(false) {}
+
+    static PollPlan compile(const DataAcquisitionPoint &point, bool singleThreaded);
+
+    // Fresh read request for this plan
+    ModbusRequest request(qint64 nowMs) const;
+};
+
+#endif // POLL_PLAN_H
@@ -0,0 +1,47 @@
+#ifndef POLL_POINT_TABLE_H
+#define POLL_POINT_TABLE_H
+
+#include <QVector>
+
+// Hot polling state of ScadaCoreService's data points, kept as parallel
+// contiguous arrays (struct of arrays) indexed like m_dataPoints. Dispatching a
+// poll only touches these arrays, never the point structs with their strings
+// and tag maps.
+// Not thread-safe; ScadaCoreService guards it with m_dataPointsMutex.
+class PollPointTable
+{
+public:
+    PollPointTable() : m_nextGeneration(1) {}
+
+    int size() const { return m_nextDue.size(); }
+
+    void append(int intervalMs, bool enabled);  // Due immediately
+    void setPoint(int index, int intervalMs, bool enabled);  // Keeps the next due time; new generation
+    void removeAt(int index);
+    void clear();
+
+    qint64 nextDue(int index) const { return m_nextDue.at(index); }
+    int intervalMs(int index) const { return m_intervalMs.at(index); }
+    bool isEnabled(int index) const { return m_enabled.at(index) != 0; }
+    qint64 lastPolled(int index) const { return m_lastPolled.at(index); }  // Epoch ms, 0 = never
+
+    // Changes whenever the point at index is added or redefined, and is never
+    // reused by another point, so a reply tagged with it still belongs to the
+    // same point definition only if the generations match
+    quint32 generation(int index) const { return m_generation.at(index); }
+
+    // Records a poll at nowMs, moves index to its next slot and returns it:
+    // previous due + interval (at least minIntervalMs), so polls don't drift;
+    // nowMs + interval when behind
+    qint64 reschedule(int index, qint64 nowMs, int minIntervalMs);
+
+private:
+    QVector<qint64> m_nextDue;    // Epoch ms
+    QVector<qint32> m_intervalMs;
+    QVector<qint64> m_lastPolled; // Epoch ms
+    QVector<quint8> m_enabled;
+    QVector<quint32> m_generation;
+    quint32 m_nextGeneration;     // Survives clear() so old replies never match
+};
+
+#endif // POLL_POINT_TABLE_H
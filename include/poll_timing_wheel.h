@@ -0,0 +1,65 @@
+#ifndef POLL_TIMING_WHEEL_H
+#define POLL_TIMING_WHEEL_H
+
+#include <QHash>
+#include <QVector>
+
+// Hierarchical timing wheel for periodic point polls.
+// Level 0 has one slot per tick (256 ticks), level 1 one slot per 256 ticks
+// (64 slots), and anything further out waits in an unsorted overflow list;
+// once per level 1 revolution every overflow entry is re-placed, dropping into
+// the wheel when it comes within range. advance() only visits the slots for
+// the ticks that passed, so its cost follows the number of due points rather
+// than the number of scheduled points. Entries fire at the first advance()
+// at or after their due time, never early.
+// Rescheduling or cancelling an ID leaves the old entry in place; stale
+// entries are skipped when their slot is reached.
+// Not thread-safe; ModbusWorker guards it with m_dataPointsMutex.
+class PollTimingWheel
+{
+public:
+    explicit PollTimingWheel(qint64 tickMs = DEFAULT_TICK_MS);
+
+    // (Re)schedules id to fire at dueMs (epoch ms). Due times in the past fire on the next advance().
+    void schedule(int id, qint64 dueMs);
+    void cancel(int id);
+    bool isScheduled(int id) const { return m_live.contains(id); }
+    int size() const { return m_live.size(); }
+    void clear();
+
+    // Moves the wheel to nowMs and returns the IDs that became due, each removed from the wheel
+    QVector<int> advance(qint64 nowMs);
+
+    static const qint64 DEFAULT_TICK_MS = 100;
+
+private:
+    struct Entry {
+        int id;
+        quint32 generation;  // Must match m_live[id], otherwise the entry is stale
+        qint64 dueTick;
+    };
+
+    static const int LEVEL0_BITS = 8;
+    static const int LEVEL0_SLOTS = 1 << LEVEL0_BITS;  // 256 ticks
+    static const int LEVEL1_BITS = 6;
+    static const int LEVEL1_SLOTS = 1 << LEVEL1_BITS;  // 64 x 256 ticks
+    static const qint64 WHEEL_SPAN = qint64(LEVEL0_SLOTS) * LEVEL1_SLOTS;
+
+    bool isLive(const Entry &entry) const;
+    void place(const Entry &entry);
+    void cascade(QVector<Entry> &slot);
+    void rebuild(qint64 targetTick);
+    void expire(QVector<Entry> &slot, QVector<int> &due);
+
+    qint64 m_tickMs;
+    qint64 m_currentTick;
+    bool m_started;                      // Ticks are anchored at the first advance()
+    QVector<Entry> m_level0[LEVEL0_SLOTS];
+    QVector<Entry> m_level1[LEVEL1_SLOTS];
+    QVector<Entry> m_overflow;           // Beyond the wheel span (or scheduled before the first advance)
+    QVector<Entry> m_ready;              // Already due when scheduled
+    QHash<int, quint32> m_live;          // ID -> generation of its current entry
+    quint32 m_nextGeneration;
+};
+
+#endif // POLL_TIMING_WHEEL_H
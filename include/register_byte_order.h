@@ -0,0 +1,54 @@
+#ifndef REGISTER_BYTE_ORDER_H
+#define REGISTER_BYTE_ORDER_H
+
+#include <QtGlobal>
+
+// Byte order of a multi-register value, spelled for a 32-bit value whose
+// most significant byte is A. ABCD is the Modbus default (high word first);
+// CDAB swaps words, BADC swaps the bytes within each word, DCBA does both.
+// 64-bit values extend the same rule: CDAB and DCBA send the low word first.
+enum class RegisterByteOrder {
+    ABCD,
+    CDAB,
+    BADC,
+    DCBA
+};
+
+// Compile-time word assembly for one byte order. Every decoder is instantiated
+// per order, so picking the order costs one lookup when a point or block plan
+// is compiled instead of a branch per value.
+template <RegisterByteOrder Order>
+struct RegisterWordOrder
+{
+    static constexpr bool wordSwapped = Order == RegisterByteOrder::CDAB || Order == RegisterByteOrder::DCBA;
+    static constexpr bool byteSwapped = Order == RegisterByteOrder::BADC || Order == RegisterByteOrder::DCBA;
+
+    // Word 'index' of a 'words'-register value, counting from the most significant
+    static quint16 word(const quint16 *registers, int index, int words)
+    {
+        const quint16 raw = registers[wordSwapped ? words - 1 - index : index];
+        return byteSwapped ? static_cast<quint16>((raw >> 8) | (raw << 8)) : raw;
+    }
+
+    static quint32 combine32(const quint16 *registers)
+    {
+        return (static_cast<quint32>(word(registers, 0, 2)) << 16) | word(registers, 1, 2);
+    }
+
+    static quint64 combine64(const quint16 *registers)
+    {
+        return (static_cast<quint64>(word(registers, 0, 4)) << 48) |
+               (static_cast<quint64>(word(registers, 1, 4)) << 32) |
+               (static_cast<quint64>(word(registers, 2, 4)) << 16) |
+               word(registers, 3, 4);
+    }
+
+    // Source byte (within a 'words'-register lane in little-endian host memory) of value
+    // byte 'position', counting from the least significant; drives the SIMD shuffles
+    static constexpr int sourceByte(int position, int words)
+    {
+        return 2 * (wordSwapped ? position / 2 : words - 1 - position / 2) + ((position % 2) ^ (byteSwapped ? 1 : 0));
+    }
+};
+
+#endif // REGISTER_BYTE_ORDER_H
@@ -0,0 +1,44 @@
+#ifndef REGISTER_DECODE_KERNELS_H
+#define REGISTER_DECODE_KERNELS_H
+
+#include <QtGlobal>
+#include "register_byte_order.h"
+
+// Batch decoders turning a span of Modbus registers into a typed array. The
+// default ABCD order matches ModbusManager::registersToFloat32; every order
+// has its own instantiation of each kernel. The AVX2 or SSE4.1
+// kernel is picked once at runtime from the CPU's features, with a portable
+// scalar fallback. Float kernels also produce a finite mask in the same
+// pass: bit i of finiteMask[i / 64] is set when value i is neither NaN nor
+// infinite. Callers size out for count / width values and finiteMask for
+// (values + 63) / 64 words. Return the number of values decoded.
+class RegisterDecodeKernels
+{
+public:
+    enum class Isa {
+        Scalar,
+        Sse41,
+        Avx2
+    };
+
+    static Isa activeIsa();  // Best instruction set this CPU supports
+    static bool isSupported(Isa isa);
+    static const char *isaName(Isa isa);
+
+    static int decodeFloat32(const quint16 *registers, int count, float *out, quint64 *finiteMask = nullptr,
+                             RegisterByteOrder order = RegisterByteOrder::ABCD);
+    static int decodeInt32(const quint16 *registers, int count, qint32 *out,
+                           RegisterByteOrder order = RegisterByteOrder::ABCD);
+    static int decodeDouble64(const quint16 *registers, int count, double *out, quint64 *finiteMask = nullptr,
+                              RegisterByteOrder order = RegisterByteOrder::ABCD);
+
+    // Same on a given instruction set (tests and benchmarks); isa must be supported
+    static int decodeFloat32(Isa isa, const quint16 *registers, int count, float *out, quint64 *finiteMask = nullptr,
+                             RegisterByteOrder order = RegisterByteOrder::ABCD);
+    static int decodeInt32(Isa isa, const quint16 *registers, int count, qint32 *out,
+                           RegisterByteOrder order = RegisterByteOrder::ABCD);
+    static int decodeDouble64(Isa isa, const quint16 *registers, int count, double *out, quint64 *finiteMask = nullptr,
+                              RegisterByteOrder order = RegisterByteOrder::ABCD);
+};
+
+#endif // REGISTER_DECODE_KERNELS_H
@@ -0,0 +1,92 @@
+#ifndef REPORT_BY_EXCEPTION_FILTER_H
+#define REPORT_BY_EXCEPTION_FILTER_H
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+// When a point's new sample is worth sending to the sink. A numeric sample is
+// reported once it moves more than max(absolute, percent% of the last reported
+// magnitude) away from the last *reported* value, so slow drift still gets
+// through; the absolute band keeps the percent band from collapsing near zero.
+// With both bands at 0 any change is reported. Booleans and non-numeric values
+// report on any change.
+struct ReportDeadband {
+    double absolute;    // Engineering units
+    double percent;     // Of |last reported value|
+    int maxSilenceMs;   // Heartbeat: report an unchanged value after this long (0 = never)
+
+    ReportDeadband() : absolute(0), percent(0), maxSilenceMs(0) {}
+
+    // All zero means no filtering: every sample is reported
+    bool isEnabled() const { return absolute > 0 || percent > 0 || maxSilenceMs > 0; }
+
+    // "absolute:percent:max_silence_ms", the form stored in the original_deadbands block tag
+    QString toString() const;
+    // Missing fields are 0; malformed or negative fields give a disabled band with ok = false
+    static ReportDeadband fromString(const QString &text, bool *ok = nullptr);
+};
+
+struct ReportFilterMetrics {
+    int trackedPoints;  // Points with an enabled deadband
+    qint64 reported;
+    qint64 suppressed;
+
+    ReportFilterMetrics() : trackedPoints(0), reported(0), suppressed(0) {}
+};
+
+// Report-by-exception filter applied right after decode. It gates only the
+// Telegraf sink: a suppressed sample is never formatted or queued for the
+// socket, but dataPointAcquired subscribers still see it. The last reported
+// state of every tracked point lives in parallel contiguous arrays (struct of
+// arrays); a sample costs one name lookup and a few loads. Points without an
+// enabled deadband are not tracked and always pass.
+// Not thread-safe; ScadaCoreService guards it with m_reportFilterMutex.
+class ReportByExceptionFilter
+{
+public:
+    ReportByExceptionFilter() : m_reported(0), m_suppressed(0) {}
+
+    // A disabled band stops tracking the point. Changing a band keeps the last
+    // reported value, so the next sample is judged against the new band.
+    void setDeadband(const QString &pointName, const ReportDeadband &deadband);
+    void remove(const QString &pointName);
+    void clear();                       // Forgets the points; metrics are kept
+
+    int size() const { return m_names.size(); }
+    bool isTracked(const QString &pointName) const { return m_slots.contains(pointName); }
+
+    // True when the sample should go to the sink; a reported sample becomes the
+    // new reference. The first sample of a point, a change of value type and a
+    // timestamp earlier than the last report are always reported.
+    bool shouldReport(const QString &pointName, const QVariant &value, qint64 timestampMs);
+
+    ReportFilterMetrics metrics() const;
+
+private:
+    enum ValueKind : quint8 {
+        NoValue,    // Nothing reported yet
+        Numeric,
+        Boolean,
+        Opaque      // Compared as a QVariant, kept in m_lastOpaque
+    };
+
+    static ValueKind kindOf(const QVariant &value);
+    void record(int slot, ValueKind kind, const QVariant &value, double number, qint64 timestampMs);
+
+    QHash<QString, int> m_slots;        // Point name -> index in the arrays below
+    QVector<QString> m_names;
+    QVector<double> m_lastValue;        // Last reported numeric or boolean (0/1) value
+    QVector<qint64> m_lastReportMs;     // Sample timestamp of the last report
+    QVector<double> m_absolute;
+    QVector<double> m_percent;
+    QVector<qint32> m_maxSilenceMs;
+    QVector<quint8> m_kind;             // ValueKind of the last report
+    QHash<int, QVariant> m_lastOpaque;  // Slot -> last reported non-numeric value
+
+    qint64 m_reported;
+    qint64 m_suppressed;
+};
+
+#endif // REPORT_BY_EXCEPTION_FILTER_H
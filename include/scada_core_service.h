@@ -21,6 +21,11 @@
 #include "modbus_worker.h"
 #include "modbus_worker_manager.h"
 #include "data_processing_task.h"
+#include "poll_deadline_queue.h"
+#include "poll_plan.h"
+#include "poll_point_table.h"
+#include "bounded_stage_queue.h"
+#include "pending_request_table.h"
 
 Q_DECLARE_METATYPE(DataAcquisitionPoint)
 Q_DECLARE_METATYPE(AcquiredDataPoint)
@@ -56,12 +61,27 @@ public:
         int connectionTimeoutMs;        // Connection timeout
         int maxRetryAttempts;          // Maximum retry attempts
         QString configFilePath;         // Path to configuration file
+        bool shareGatewayConnections;   // One connection per host:port for all unit IDs
+        int gatewayConcurrencyLimit;    // Outstanding requests per shared gateway connection
+        int pollDispatchBudget;         // Both modes: polls dispatched per poll timer firing (0 = no limit)
+        int singleThreadMaxInFlight;    // Single-threaded mode: pipelined requests on the connection
+        bool shardEventLoops;           // Multi-threaded mode: workers share a fixed pool of I/O threads
+        int ioLoopThreads;              // Size of that pool (0 = one per core)
+        int decodeQueueCapacity;        // Read results waiting for a parallel processing thread
+        StageQueuePolicy decodeQueuePolicy;
+        int sinkQueueCapacity;          // Points waiting for the Telegraf socket
+        StageQueuePolicy sinkQueuePolicy;
         
         DeploymentConfig() : threadingMode(ThreadingMode::Auto), maxWorkerThreads(10),
                            deviceCountThreshold(1), pollIntervalMs(1000),
                            enableLoadBalancing(true), enablePerformanceMonitoring(false),
                            connectionTimeoutMs(5000), maxRetryAttempts(3),
-                           configFilePath("scada_config.json") {}
+                           configFilePath("scada_config.json"),
+                           shareGatewayConnections(false), gatewayConcurrencyLimit(1),
+                           pollDispatchBudget(64), singleThreadMaxInFlight(1),
+                           shardEventLoops(false), ioLoopThreads(0),
+                           decodeQueueCapacity(1024), decodeQueuePolicy(StageQueuePolicy::Block),
+                           sinkQueueCapacity(4096), sinkQueuePolicy(StageQueuePolicy::Block) {}
     };
     
     void setThreadingMode(ThreadingMode mode);
@@ -162,6 +182,19 @@ public:
     int getParallelProcessingThreads() const;
     int getActiveProcessingTasks() const;
     
+    // Bounded stage queues between acquisition, decode and sink
+    struct PipelineMetrics {
+        StageQueueMetrics decodeQueue;
+        StageQueueMetrics sinkQueue;
+        qint64 acquisitionPauses;       // Poll timer firings deferred by backpressure
+        ReportFilterMetrics reportFilter; // Samples kept from the sink by report-by-exception
+        
+        PipelineMetrics() : acquisitionPauses(0) {}
+    };
+    
+    // Service thread only: the sink queue is not locked (the decode queue and report filter are)
+    PipelineMetrics getPipelineMetrics() const;
+    
     // Modbus write operations with priority support
     qint64 writeHoldingRegister(const QString &host, int port, int address, quint16 value, RequestPriority priority = RequestPriority::Normal);
     qint64 writeHoldingRegisterFloat32(const QString &host, int port, int address, float value, RequestPriority priority = RequestPriority::Normal);
@@ -182,7 +215,7 @@ public:
 signals:
     void serviceStarted();
     void serviceStopped();
-    void dataPointAcquired(const AcquiredDataPoint &dataPoint);
+    void dataPointAcquired(const AcquiredDataPoint &dataPoint);  // Every decoded sample; deadbands gate only the sink
     void dataPointSentToInflux(const QString &pointName, bool success);
     
     // Worker-related signals
@@ -210,6 +243,7 @@ private slots:
     // Parallel data processing slots
     void onParallelProcessingCompleted(qint64 requestId, const AcquiredDataPoint &dataPoint, const QString &deviceKey);
     void onParallelProcessingFailed(qint64 requestId, const QString &errorMessage, const QString &deviceKey);
+    void onParallelProcessingDiscarded(qint64 requestId, const QString &reason, const QString &deviceKey);
     
     // Single-threaded mode handlers
     void onSingleThreadReadCompleted(const ModbusReadResult &result);
@@ -227,17 +261,37 @@ private:
     bool m_serviceRunning;
     
     // State management
-    QMap<QString, qint64> m_lastPollTimes;  // Track last poll time for each point
     QMap<QString, bool> m_connectionStates; // Track connection state for each device
-    int m_currentPointIndex;                // Current point being processed
+    
+    // Deadline-driven polling: m_pollTimer is single-shot, armed for the earliest deadline
+    PollDeadlineQueue m_pollSchedule;       // Point indexes by next poll deadline
+    PollPointTable m_pollPoints;            // Hot next-due/last-poll/interval/enabled arrays (parallel to m_dataPoints)
+    int m_minPollIntervalMs;                // Floor for per-point poll intervals (optimizePollInterval)
+    bool m_servicePollingActive;            // Service-level polling runs (single-threaded mode only)
+    bool m_pollScheduleDirty;               // Points changed; m_pollSchedule is rebuilt before next use
+    QVector<PollPlan> m_pollPlans;          // Compiled read per data point (parallel to m_dataPoints)
+    quint32 m_pollPlanGeneration;           // Bumped whenever m_pollPlans is recompiled
+    
+    // Block coverage index: "host:port:REGISTER_TYPE" -> sorted, merged [start, end) address ranges
+    QHash<QString, QVector<QPair<int, int>>> m_blockCoverage;
+    bool m_coverageIndexDirty;
+    QHash<QString, ModbusBitBuffer> m_previousBitFrames;  // Coil/discrete block name -> last frame, for change detection
+    ReportByExceptionFilter m_reportFilter; // Last reported value per point name; checked right after decode
+    
+    // Sink stage: points are written to Telegraf from the event loop without blocking
+    BoundedStageQueue<AcquiredDataPoint> m_sinkQueue;
+    QTimer *m_sinkDrainTimer;               // Single-shot; immediate after a push, delayed after EAGAIN
+    qint64 m_acquisitionPauses;
+    static const int SINK_DRAIN_BATCH = 256;        // Socket writes per drainSinkQueue() pass
+    static const int SINK_RETRY_DELAY_MS = 10;      // After the Telegraf socket reported EAGAIN
+    static const int BACKPRESSURE_RETRY_MS = 50;    // Poll deferral while a stage queue is backpressured
     
     // Request tracking
-    QMap<qint64, DataAcquisitionPoint> m_pendingReadRequests; // Track pending read requests
+    PendingRequestTable m_pendingReadRequests;    // (worker, request id) -> data point handle
     QMap<qint64, QString> m_pendingWriteRequests; // Track pending write requests
     
     // Statistics
     ServiceStatistics m_statistics;
-    QMap<QString, qint64> m_responseTimers; // Track response times
     QSet<ModbusWorker*> m_connectedWorkers; // Track connected workers
     
     // Performance monitoring
@@ -249,8 +303,9 @@ private:
     
     // Thread safety
     mutable QMutex m_dataPointsMutex;        // Protects m_dataPoints and related data
-    mutable QMutex m_statisticsMutex;        // Protects m_statistics and m_responseTimers
+    mutable QMutex m_statisticsMutex;        // Protects m_statistics
     mutable QMutex m_requestTrackingMutex;   // Protects request tracking maps
+    mutable QMutex m_reportFilterMutex;      // Protects m_reportFilter
     
     // Parallel data processing
     ParallelDataProcessor *m_dataProcessor;  // Parallel data processing coordinator
@@ -264,17 +319,27 @@ private:
     
     // Helper methods
     bool writeToInflux(const QString& measurement, const QString& device, const QVariant& value, const QString& description = QString());
-    bool writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint);
-    bool writeToTelegrafSocket(const QString& socketPath, const QByteArray& message);
-    bool sendDataToInflux(const AcquiredDataPoint &dataPoint);
-    void processNextDataPoint();
-    void processDataPoint(const DataAcquisitionPoint &point, qint64 currentTime);
+    bool writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint, bool *wouldBlock = nullptr);
+    bool writeToTelegrafSocket(const QString& socketPath, const QByteArray& message, bool *wouldBlock = nullptr);
+    bool sendDataToInflux(const AcquiredDataPoint &dataPoint);  // Queues for drainSinkQueue()
+    void drainSinkQueue();
+    bool isPipelineBackpressured() const;
+    void processDueDataPoints();
+    void rebuildPollSchedule();   // Caller holds m_dataPointsMutex
+    void invalidatePollSchedule(); // Caller holds m_dataPointsMutex
+    void armPollTimer();
+    void processDataPoint(const DataAcquisitionPoint &point, PollPlan &plan, PendingRequestTable::Handle handle, qint64 currentTime);
     bool connectToModbusHost(const QString &host, int port);
     void updateStatistics(bool success, qint64 responseTime = 0);
     QJsonObject dataPointToJson(const AcquiredDataPoint &dataPoint);
     void handleBlockReadResult(const ModbusReadResult &result, const DataAcquisitionPoint &blockPoint);
     bool isPointCoveredByBlock(const DataAcquisitionPoint &point);
+    void rebuildCoverageIndex();
     void validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, const DataAcquisitionPoint &sourcePoint);
+    void trackReportDeadbands(const DataAcquisitionPoint &point);   // Blocks register their original points
+    void untrackReportDeadbands(const DataAcquisitionPoint &point);
+    bool reportByException(const AcquiredDataPoint &dataPoint);     // False when the sample is suppressed
+    void resetBitFrames(const QString &deviceKey);                  // Empty key: every device
     qint64 generateRequestId();
     void connectWorkerSignals(ModbusWorker* worker);
 };
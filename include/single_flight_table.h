@@ -0,0 +1,48 @@
+#ifndef SINGLE_FLIGHT_TABLE_H
+#define SINGLE_FLIGHT_TABLE_H
+
+#include <QHash>
+#include <QList>
+#include "modbus_request_scheduler.h"
+
+// Single-flight reads of one ModbusWorker: one wire read per (function, unit,
+// start, count) at a time. A queued read becomes the leader of its key, but
+// duplicates only join a leader once it is on the wire. While the leader is
+// still queued a newer poll supersedes it in the scheduler instead, so a stale
+// leader that expires or is rejected never takes fresh polls down with it.
+// Not thread-safe; ModbusWorker uses it from its own thread only.
+class SingleFlightTable
+{
+public:
+    // Makes leaderId the leader of key; an older leader keeps its followers
+    // but no longer accepts new ones
+    void lead(quint64 key, qint64 leaderId, RequestPriority priority);
+    void markDispatched(qint64 leaderId);  // The leader's read was sent
+
+    // Attaches follower to the dispatched leader of key when that leader has
+    // at least the follower's priority; a more urgent duplicate must not wait
+    bool join(quint64 key, const PriorityModbusRequest &follower);
+
+    // Forgets the leader; returns the followers to answer or release
+    QList<PriorityModbusRequest> take(qint64 leaderId);
+    QList<qint64> leaders() const { return m_flights.keys(); }
+
+    bool isLeader(qint64 leaderId) const { return m_flights.contains(leaderId); }
+    int size() const { return m_flights.size(); }
+    void clear();
+
+private:
+    struct Flight {
+        quint64 key;
+        RequestPriority priority;
+        bool dispatched;
+        QList<PriorityModbusRequest> followers;    // Duplicates answered with the leader's result
+
+        Flight() : key(0), priority(RequestPriority::Normal), dispatched(false) {}
+    };
+
+    QHash<quint64, qint64> m_index;     // Read key -> current leader request ID
+    QHash<qint64, Flight> m_flights;    // Leader request ID -> flight
+};
+
+#endif // SINGLE_FLIGHT_TABLE_H
@@ -0,0 +1,357 @@
+#include "../include/block_decode_plan.h"
+#include "../include/register_decode_kernels.h"
+#include <QDebug>
+#include <QStringList>
+#include <cstring>
+
+namespace {
+
+// Shorter runs aren't worth a kernel call
+const int MIN_SPAN_VALUES = 4;
+
+bool isBatchable(ModbusDataType dataType)
+{
+    return dataType == ModbusDataType::Float32 ||
+           dataType == ModbusDataType::Long32 ||
+           dataType == ModbusDataType::Double64;
+}
+
+QString readModeName(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::HoldingRegister:
+    case ModbusDataType::InputRegister:
+        return "single_register";
+    case ModbusDataType::Float32:
+    case ModbusDataType::Long32:
+        return "dual_register";
+    case ModbusDataType::Double64:
+    case ModbusDataType::Long64:
+        return "quad_register";
+    case ModbusDataType::Coil:
+    case ModbusDataType::DiscreteInput:
+        return "single_bit";
+    default:
+        return "single_register";
+    }
+}
+
+template <RegisterByteOrder Order>
+QVariant decodeFloat32Value(const quint16 *registers)
+{
+    const quint32 bits = RegisterWordOrder<Order>::combine32(registers);
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+template <RegisterByteOrder Order>
+QVariant decodeDouble64Value(const quint16 *registers)
+{
+    const quint64 bits = RegisterWordOrder<Order>::combine64(registers);
+    double value;
+    std::memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+template <RegisterByteOrder Order>
+QVariant decodeLong32Value(const quint16 *registers)
+{
+    return static_cast<qint32>(RegisterWordOrder<Order>::combine32(registers));
+}
+
+template <RegisterByteOrder Order>
+QVariant decodeLong64Value(const quint16 *registers)
+{
+    return static_cast<qint64>(RegisterWordOrder<Order>::combine64(registers));
+}
+
+QVariant decodeBoolValue(const quint16 *registers)
+{
+    return registers[0] != 0;
+}
+
+QVariant decodeRegisterValue(const quint16 *registers)
+{
+    return static_cast<int>(registers[0]);
+}
+
+template <RegisterByteOrder Order>
+RegisterValueDecoder decoderFor(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::Float32:
+        return decodeFloat32Value<Order>;
+    case ModbusDataType::Double64:
+        return decodeDouble64Value<Order>;
+    case ModbusDataType::Long32:
+        return decodeLong32Value<Order>;
+    case ModbusDataType::Long64:
+        return decodeLong64Value<Order>;
+    case ModbusDataType::BOOL:
+        return decodeBoolValue;
+    default:
+        return decodeRegisterValue;
+    }
+}
+
+} // namespace
+
+ModbusDataType BlockDecodePlan::dataTypeFromName(const QString &name)
+{
+    if (name == "FLOAT32" || name == "Float32") {
+        return ModbusDataType::Float32;
+    } else if (name == "DOUBLE" || name == "Double64" || name == "DOUBLE64") {
+        return ModbusDataType::Double64;
+    } else if (name == "INT16" || name == "Int16") {
+        return ModbusDataType::HoldingRegister;
+    } else if (name == "INT32" || name == "Int32") {
+        return ModbusDataType::Long32;
+    } else if (name == "INT64" || name == "Int64") {
+        return ModbusDataType::Long64;
+    } else if (name == "COIL" || name == "Coil") {
+        return ModbusDataType::Coil;
+    } else if (name == "DISCRETE_INPUT" || name == "DiscreteInput") {
+        return ModbusDataType::DiscreteInput;
+    } else if (name == "BOOL" || name == "Bool" || name == "Boolean") {
+        return ModbusDataType::BOOL;
+    }
+    return ModbusDataType::HoldingRegister; // Default
+}
+
+RegisterByteOrder BlockDecodePlan::byteOrderFromName(const QString &name, bool *ok)
+{
+    const QString upper = name.trimmed().toUpper();
+    if (ok) {
+        *ok = true;
+    }
+    if (upper == "ABCD") {
+        return RegisterByteOrder::ABCD;
+    } else if (upper == "CDAB") {
+        return RegisterByteOrder::CDAB;
+    } else if (upper == "BADC") {
+        return RegisterByteOrder::BADC;
+    } else if (upper == "DCBA") {
+        return RegisterByteOrder::DCBA;
+    }
+    if (ok) {
+        *ok = false;
+    }
+    return RegisterByteOrder::ABCD;
+}
+
+QString BlockDecodePlan::byteOrderName(RegisterByteOrder order)
+{
+    switch (order) {
+    case RegisterByteOrder::CDAB:
+        return "CDAB";
+    case RegisterByteOrder::BADC:
+        return "BADC";
+    case RegisterByteOrder::DCBA:
+        return "DCBA";
+    default:
+        return "ABCD";
+    }
+}
+
+RegisterValueDecoder BlockDecodePlan::valueDecoder(ModbusDataType dataType, RegisterByteOrder order)
+{
+    switch (order) {
+    case RegisterByteOrder::CDAB:
+        return decoderFor<RegisterByteOrder::CDAB>(dataType);
+    case RegisterByteOrder::BADC:
+        return decoderFor<RegisterByteOrder::BADC>(dataType);
+    case RegisterByteOrder::DCBA:
+        return decoderFor<RegisterByteOrder::DCBA>(dataType);
+    default:
+        return decoderFor<RegisterByteOrder::ABCD>(dataType);
+    }
+}
+
+int BlockDecodePlan::registerWidth(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::Float32:
+    case ModbusDataType::Long32:
+        return 2;
+    case ModbusDataType::Double64:
+    case ModbusDataType::Long64:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+QSharedPointer<const BlockDecodePlan> BlockDecodePlan::compile(const DataAcquisitionPoint &blockPoint)
+{
+    const QStringList addresses = blockPoint.tags.value("original_addresses").split(",", Qt::SkipEmptyParts);
+    const QStringList names = blockPoint.tags.value("original_names").split(",", Qt::SkipEmptyParts);
+    const QStringList dataTypes = blockPoint.tags.value("original_data_types").split(",", Qt::SkipEmptyParts);
+    const QStringList descriptions = blockPoint.tags.value("original_descriptions").split(",", Qt::SkipEmptyParts);
+    const QStringList measurements = blockPoint.tags.value("original_measurements").split(",", Qt::SkipEmptyParts);
+    // Optional: blocks built before per-tag byte orders use the block's own order
+    const QStringList byteOrders = blockPoint.tags.value("original_byte_orders").split(",", Qt::SkipEmptyParts);
+    // Optional: without it the original points report every sample
+    const QStringList deadbands = blockPoint.tags.value("original_deadbands").split(",", Qt::SkipEmptyParts);
+
+    if (addresses.isEmpty() ||
+        addresses.size() != names.size() ||
+        addresses.size() != dataTypes.size() ||
+        addresses.size() != descriptions.size() ||
+        addresses.size() != measurements.size() ||
+        (!byteOrders.isEmpty() && addresses.size() != byteOrders.size()) ||
+        (!deadbands.isEmpty() && addresses.size() != deadbands.size())) {
+        qWarning() << "Inconsistent original point metadata in block" << blockPoint.name;
+        return QSharedPointer<const BlockDecodePlan>();
+    }
+
+    QSharedPointer<BlockDecodePlan> plan(new BlockDecodePlan());
+    plan->m_entries.reserve(addresses.size());
+    plan->m_points.reserve(addresses.size());
+
+    const QString deviceName = blockPoint.tags.value("device_name", "STATION_TEST");
+
+    for (int i = 0; i < addresses.size(); ++i) {
+        const ModbusDataType dataType = dataTypeFromName(dataTypes.at(i));
+
+        Point point;
+        point.name = names.at(i);
+        point.measurement = measurements.at(i);
+        point.description = descriptions.at(i);
+        point.dataTypeName = dataTypes.at(i);
+        point.address = addresses.at(i).toInt();
+
+        point.tags = blockPoint.tags;
+        point.tags["device_name"] = deviceName;
+        point.tags["address"] = QString::number(point.address);
+        point.tags["description"] = point.description;
+        point.tags["read_mode"] = readModeName(dataType);
+        point.tags["data_type"] = point.dataTypeName;
+
+        point.source.address = point.address;
+        point.source.host = blockPoint.host;
+        point.source.dataType = dataType;
+        point.source.name = point.name;
+        point.source.tags = blockPoint.tags;
+        point.source.byteOrder = byteOrders.isEmpty() ? blockPoint.byteOrder : byteOrderFromName(byteOrders.at(i));
+        if (!deadbands.isEmpty()) {
+            point.source.deadband = ReportDeadband::fromString(deadbands.at(i));
+        }
+
+        BlockDecodeEntry entry;
+        entry.offset = point.address - blockPoint.address;
+        entry.width = registerWidth(dataType);
+        entry.dataType = dataType;
+        entry.byteOrder = point.source.byteOrder;
+        entry.decoder = valueDecoder(dataType, entry.byteOrder);
+        entry.slot = plan->m_points.size();
+        entry.span = -1;
+
+        if (entry.offset < 0) {
+            qWarning() << "Address" << point.address << "precedes block start" << blockPoint.address
+                       << "in block" << blockPoint.name;
+        } else {
+            plan->m_requiredRegisters = qMax(plan->m_requiredRegisters, entry.offset + entry.width);
+        }
+
+        plan->m_points.append(point);
+        plan->m_entries.append(entry);
+    }
+
+    plan->groupSpans();
+    return plan;
+}
+
+void BlockDecodePlan::groupSpans()
+{
+    int runStart = 0;
+    for (int i = 1; i <= m_entries.size(); ++i) {
+        const BlockDecodeEntry &first = m_entries.at(runStart);
+        const bool extends = i < m_entries.size() &&
+                             isBatchable(first.dataType) &&
+                             first.offset >= 0 &&
+                             m_entries.at(i).dataType == first.dataType &&
+                             m_entries.at(i).byteOrder == first.byteOrder &&
+                             m_entries.at(i).offset == m_entries.at(i - 1).offset + first.width &&
+                             m_entries.at(i).slot == m_entries.at(i - 1).slot + 1;
+        if (extends) {
+            continue;
+        }
+
+        if (isBatchable(first.dataType) && first.offset >= 0 && i - runStart >= MIN_SPAN_VALUES) {
+            BlockDecodeSpan span;
+            span.offset = first.offset;
+            span.values = i - runStart;
+            span.dataType = first.dataType;
+            span.byteOrder = first.byteOrder;
+            span.firstSlot = first.slot;
+            for (int j = runStart; j < i; ++j) {
+                m_entries[j].span = m_spans.size();
+            }
+            m_spans.append(span);
+        }
+        runStart = i;
+    }
+}
+
+void BlockDecodePlan::decode(const quint16 *registers, int count, QVariant *values) const
+{
+    // Blocks hold at most 125 registers, so every run fits these buffers
+    float floats[64];
+    qint32 longs[64];
+    double doubles[32];
+
+    for (const BlockDecodeSpan &span : m_spans) {
+        const int width = registerWidth(span.dataType);
+        if (span.offset + span.values * width > count) {
+            continue;  // Entries fall back to the per-entry path below
+        }
+
+        const quint16 *word = registers + span.offset;
+        QVariant *value = values + span.firstSlot;
+        for (int done = 0; done < span.values;) {
+            const int chunk = qMin(span.values - done, span.dataType == ModbusDataType::Double64 ? 32 : 64);
+            if (span.dataType == ModbusDataType::Float32) {
+                RegisterDecodeKernels::decodeFloat32(word, chunk * width, floats, nullptr, span.byteOrder);
+                for (int i = 0; i < chunk; ++i) value[i] = floats[i];
+            } else if (span.dataType == ModbusDataType::Long32) {
+                RegisterDecodeKernels::decodeInt32(word, chunk * width, longs, span.byteOrder);
+                for (int i = 0; i < chunk; ++i) value[i] = longs[i];
+            } else {
+                RegisterDecodeKernels::decodeDouble64(word, chunk * width, doubles, nullptr, span.byteOrder);
+                for (int i = 0; i < chunk; ++i) value[i] = doubles[i];
+            }
+            done += chunk;
+            word += chunk * width;
+            value += chunk;
+        }
+    }
+
+    for (const BlockDecodeEntry &entry : m_entries) {
+        if (entry.span >= 0) {
+            const BlockDecodeSpan &span = m_spans.at(entry.span);
+            if (span.offset + span.values * entry.width <= count) {
+                continue;
+            }
+        }
+
+        QVariant &value = values[entry.slot];
+        if (entry.offset < 0 || entry.offset + entry.width > count) {
+            value = QVariant();
+            continue;
+        }
+
+        value = entry.decoder(registers + entry.offset);
+    }
+}
+
+void BlockDecodePlan::decodeBits(const ModbusBitBuffer &bits, QVariant *values) const
+{
+    for (const BlockDecodeEntry &entry : m_entries) {
+        if (entry.offset < 0 || entry.offset >= bits.size()) {
+            values[entry.slot] = QVariant();
+        } else {
+            values[entry.slot] = static_cast<int>(bits.testBit(entry.offset));
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "../include/consistent_hash_ring.h"
+
+ConsistentHashRing::ConsistentHashRing(int virtualNodes)
+    : m_virtualNodes(qMax(1, virtualNodes))
+{
+}
+
+quint32 ConsistentHashRing::mix(quint32 h)
+{
+    // Murmur3 finalizer: spreads nearby inputs across the whole ring
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+quint32 ConsistentHashRing::hashKey(const QString &key)
+{
+    // FNV-1a over the UTF-16 code units; qHash() is seeded per process
+    quint32 h = 2166136261U;
+    for (const QChar ch : key) {
+        h ^= ch.unicode();
+        h *= 16777619U;
+    }
+    return mix(h);
+}
+
+void ConsistentHashRing::addNode(int node)
+{
+    if (m_nodes.contains(node)) {
+        return;
+    }
+    m_nodes.append(node);
+
+    for (int replica = 0; replica < m_virtualNodes; ++replica) {
+        quint32 position = mix(static_cast<quint32>(node) * 0x9e3779b9U + static_cast<quint32>(replica));
+        // Collisions are rare; probe forward so every virtual node gets a slot
+        while (m_ring.contains(position)) {
+            position++;
+        }
+        m_ring.insert(position, node);
+    }
+}
+
+void ConsistentHashRing::removeNode(int node)
+{
+    if (!m_nodes.removeOne(node)) {
+        return;
+    }
+
+    for (auto it = m_ring.begin(); it != m_ring.end();) {
+        if (it.value() == node) {
+            it = m_ring.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ConsistentHashRing::clear()
+{
+    m_ring.clear();
+    m_nodes.clear();
+}
+
+int ConsistentHashRing::nodeFor(const QString &key) const
+{
+    if (m_ring.isEmpty()) {
+        return -1;
+    }
+
+    // First virtual node clockwise from the key, wrapping around
+    auto it = m_ring.lowerBound(hashKey(key));
+    if (it == m_ring.end()) {
+        it = m_ring.begin();
+    }
+    return it.value();
+}
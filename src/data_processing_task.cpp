@@ -1,5 +1,6 @@
 #include "../include/data_processing_task.h"
 #include "../include/scada_core_service.h"
+#include "../include/block_decode_plan.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QThread>
@@ -37,13 +38,14 @@ void DataProcessingTask::run()
             return;
         }
         
-        if (m_result.rawData.isEmpty()) {
+        const bool bitRead = isBitDataType(m_result.dataType);
+        if (bitRead ? m_result.bits.isEmpty() : m_result.rawData.isEmpty()) {
             emit dataProcessingFailed(m_requestId, "Empty raw data in Modbus result", m_deviceKey);
             return;
         }
         
         // Log raw Modbus data for debugging (similar to single-threaded mode)
-        QString rawDataStr;
+        QString rawDataStr = bitRead ? QString::fromLatin1(m_result.bits.toPackedBytes().toHex()) : QString();
         for (int i = 0; i < m_result.rawData.size(); ++i) {
             if (i > 0) rawDataStr += ", ";
             rawDataStr += QString("0x%1").arg(m_result.rawData[i], 4, 16, QChar('0'));
@@ -61,8 +63,9 @@ void DataProcessingTask::run()
         acquiredPoint.tags = createInfluxTags(m_point);
         acquiredPoint.isValid = false; // Will be set to true if processing succeeds
         
-        // Decode raw Modbus data based on data type
-        QVariant decodedValue = decodeModbusData(m_result.rawData, m_point.dataType);
+        // Decode raw Modbus data based on data type; coil/discrete points read their first bit
+        QVariant decodedValue = bitRead ? QVariant(static_cast<int>(m_result.bits.testBit(0)))
+                                        : decodeModbusData(m_result.rawData, m_point.dataType, 0, m_point.valueDecoder);
         
         if (!decodedValue.isValid()) {
             emit dataProcessingFailed(m_requestId, 
@@ -131,13 +134,26 @@ qint64 DataProcessingTask::getRequestId() const
     return m_requestId;
 }
 
-QVariant DataProcessingTask::decodeModbusData(const QVector<quint16> &rawData, ModbusDataType dataType, int offset)
+QVariant DataProcessingTask::decodeModbusData(const ModbusRegisterBuffer &rawData, ModbusDataType dataType, int offset,
+                                               RegisterValueDecoder decoder)
 {
     if (offset < 0 || offset >= rawData.size()) {
         qWarning() << "[DataProcessingTask] Invalid offset" << offset << "for data size" << rawData.size();
         return QVariant();
     }
     
+    // Multi-register values take the decoder specialized for the point's byte order
+    const int width = BlockDecodePlan::registerWidth(dataType);
+    if (decoder && width > 1 && offset + width <= rawData.size()) {
+        const QVariant value = decoder(rawData.constData() + offset);
+        if ((dataType == ModbusDataType::Float32 || dataType == ModbusDataType::Double64) &&
+            (std::isnan(value.toDouble()) || std::isinf(value.toDouble()))) {
+            qWarning() << "[DataProcessingTask] Invalid floating point value detected:" << value;
+            return QVariant();
+        }
+        return value;
+    }
+    
     switch (dataType) {
     case ModbusDataType::Float32:
         if (offset + 1 < rawData.size()) {
@@ -354,7 +370,11 @@ ParallelDataProcessor::ParallelDataProcessor(QObject *parent)
 
 ParallelDataProcessor::~ParallelDataProcessor()
 {
-    // Wait for all tasks to complete before destruction
+    // Queued tasks never start; wait for the running ones before destruction
+    {
+        QMutexLocker locker(&m_taskCountMutex);
+        m_pendingTasks.clear();
+    }
     waitForCompletion(10000); // 10 second timeout
 }
 
@@ -363,30 +383,67 @@ void ParallelDataProcessor::submitProcessingTask(qint64 requestId,
                                                const DataAcquisitionPoint &point,
                                                ScadaCoreService *service)
 {
-    // Create processing task
-    DataProcessingTask *task = new DataProcessingTask(requestId, result, point, service);
+    PendingTask task;
+    task.requestId = requestId;
+    task.result = result;
+    task.point = point;
+    task.service = service;
     
-    // Connect signals for result handling
-    connect(task, &DataProcessingTask::dataProcessingCompleted,
-            this, &ParallelDataProcessor::onTaskCompleted,
-            Qt::QueuedConnection);
-    
-    connect(task, &DataProcessingTask::dataProcessingFailed,
-            this, &ParallelDataProcessor::onTaskFailed,
-            Qt::QueuedConnection);
-    
-    // Increment active task count
+    // Queue first so a full queue applies its policy, then fill free threads
+    PendingTask displaced;
+    BoundedStageQueue<PendingTask>::PushResult pushResult;
     {
         QMutexLocker locker(&m_taskCountMutex);
-        m_activeTaskCount++;
+        pushResult = m_pendingTasks.push(point.name, task, &displaced);
     }
     
-    // Submit to thread pool
-    m_threadPool->start(task);
+    if (pushResult == BoundedStageQueue<PendingTask>::Coalesced) {
+        discardTask(displaced, "Superseded by a newer reading of the same point");
+    } else if (pushResult == BoundedStageQueue<PendingTask>::QueuedDroppedOldest) {
+        qWarning() << "[ParallelDataProcessor] ⚠️ Processing queue full, dropped request" << displaced.requestId
+                   << "point:" << displaced.point.name;
+        discardTask(displaced, "Dropped by full processing queue");
+    }
     
-    qDebug() << "[ParallelDataProcessor] 🚀 Submitted task for request" << requestId 
-             << "point:" << point.name << "device:" << task->getDeviceKey() 
-             << "active tasks:" << m_activeTaskCount << "/" << m_threadPool->maxThreadCount() << "threads";
+    startPendingTasks();
+}
+
+void ParallelDataProcessor::startPendingTasks()
+{
+    QMutexLocker locker(&m_taskCountMutex);
+    
+    while (!m_pendingTasks.isEmpty() && m_activeTaskCount < m_threadPool->maxThreadCount()) {
+        const PendingTask pending = m_pendingTasks.take();
+        
+        // Create processing task
+        DataProcessingTask *task = new DataProcessingTask(pending.requestId, pending.result, pending.point, pending.service);
+        
+        // Connect signals for result handling
+        connect(task, &DataProcessingTask::dataProcessingCompleted,
+                this, &ParallelDataProcessor::onTaskCompleted,
+                Qt::QueuedConnection);
+        
+        connect(task, &DataProcessingTask::dataProcessingFailed,
+                this, &ParallelDataProcessor::onTaskFailed,
+                Qt::QueuedConnection);
+        
+        m_activeTaskCount++;
+        
+        // Submit to thread pool
+        m_threadPool->start(task);
+        
+        qDebug() << "[ParallelDataProcessor] 🚀 Submitted task for request" << pending.requestId 
+                 << "point:" << pending.point.name << "device:" << task->getDeviceKey() 
+                 << "active tasks:" << m_activeTaskCount << "/" << m_threadPool->maxThreadCount() << "threads"
+                 << "queued:" << m_pendingTasks.size();
+    }
+}
+
+void ParallelDataProcessor::discardTask(const PendingTask &task, const QString &reason)
+{
+    // Coalesced and dropped tasks are counted by the queue metrics, not as failures
+    const QString deviceKey = QString("%1:%2").arg(task.point.host).arg(task.point.port);
+    emit taskDiscarded(task.requestId, reason, deviceKey);
 }
 
 int ParallelDataProcessor::getActiveTaskCount() const
@@ -399,6 +456,28 @@ void ParallelDataProcessor::setMaxThreads(int maxThreads)
 {
     m_threadPool->setMaxThreadCount(qMax(1, qMin(maxThreads, 16))); // Between 1-16 threads
     qDebug() << "[ParallelDataProcessor] Thread count set to" << m_threadPool->maxThreadCount();
+    
+    startPendingTasks();
+}
+
+void ParallelDataProcessor::setQueueLimits(int capacity, StageQueuePolicy policy)
+{
+    QMutexLocker locker(&m_taskCountMutex);
+    m_pendingTasks.configure(capacity, policy);
+    qDebug() << "[ParallelDataProcessor] Processing queue capacity set to" << m_pendingTasks.capacity()
+             << "policy:" << static_cast<int>(policy);
+}
+
+StageQueueMetrics ParallelDataProcessor::getQueueMetrics() const
+{
+    QMutexLocker locker(&m_taskCountMutex);
+    return m_pendingTasks.metrics();
+}
+
+bool ParallelDataProcessor::isBackpressured() const
+{
+    QMutexLocker locker(&m_taskCountMutex);
+    return m_pendingTasks.isBackpressured();
 }
 
 bool ParallelDataProcessor::waitForCompletion(int timeoutMs)
@@ -428,6 +507,8 @@ void ParallelDataProcessor::onTaskCompleted(qint64 requestId, const AcquiredData
              << "point:" << dataPoint.pointName << "value:" << dataPoint.value.toString()
              << "device:" << deviceKey << "remaining tasks:" << m_activeTaskCount;
     
+    startPendingTasks();
+    
     // Forward the signal
     emit taskCompleted(requestId, dataPoint, deviceKey);
 }
@@ -448,6 +529,8 @@ void ParallelDataProcessor::onTaskFailed(qint64 requestId, const QString &errorM
                << "device:" << deviceKey << "error:" << errorMessage 
                << "remaining tasks:" << m_activeTaskCount;
     
+    startPendingTasks();
+    
     // Forward the signal
     emit taskFailed(requestId, errorMessage, deviceKey);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../include/database_manager.h"
+#include "../include/block_decode_plan.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
@@ -140,6 +141,44 @@ QVector<ModbusDeviceConfig> DatabaseManager::loadModbusDevices()
     return devices;
 }
 
+// [ByteOrder] in the config file: "<device_name>/<tag_name>" overrides
+// "<device_name>", which overrides "default"; ABCD when none is set
+RegisterByteOrder DatabaseManager::byteOrderFor(const QString &deviceName, const QString &tagName) const
+{
+    if (!m_settings) {
+        return RegisterByteOrder::ABCD;
+    }
+    
+    const QString name = m_settings->value(QString("ByteOrder/%1/%2").arg(deviceName, tagName),
+                         m_settings->value(QString("ByteOrder/%1").arg(deviceName),
+                         m_settings->value("ByteOrder/default", "ABCD"))).toString();
+    bool ok = false;
+    const RegisterByteOrder order = BlockDecodePlan::byteOrderFromName(name, &ok);
+    if (!ok) {
+        qWarning() << "Unknown byte order" << name << "for" << deviceName << tagName << "- using ABCD";
+    }
+    return order;
+}
+
+// [Deadband] in the config file, same lookup as [ByteOrder]; each value is
+// "absolute:percent:max_silence_ms". No filtering when none is set.
+ReportDeadband DatabaseManager::deadbandFor(const QString &deviceName, const QString &tagName) const
+{
+    if (!m_settings) {
+        return ReportDeadband();
+    }
+    
+    const QString spec = m_settings->value(QString("Deadband/%1/%2").arg(deviceName, tagName),
+                         m_settings->value(QString("Deadband/%1").arg(deviceName),
+                         m_settings->value("Deadband/default"))).toString();
+    bool ok = false;
+    const ReportDeadband deadband = ReportDeadband::fromString(spec, &ok);
+    if (!ok) {
+        qWarning() << "Invalid deadband" << spec << "for" << deviceName << tagName << "- reporting every sample";
+    }
+    return deadband;
+}
+
 QVector<DataAcquisitionPoint> DatabaseManager::loadDataPoints()
 {
     QVector<DataAcquisitionPoint> dataPoints;
@@ -233,6 +272,9 @@ QVector<DataAcquisitionPoint> DatabaseManager::loadDataPoints()
             point.tags["protocol_type"] = query.value("protocol_type").toString();
             point.tags["station_name"] = "field_site";
             
+            point.byteOrder = byteOrderFor(deviceName, tagName);
+            point.deadband = deadbandFor(deviceName, tagName);
+            
             dataPoints.append(point);
         }
         
@@ -387,6 +429,8 @@ QVector<DataAcquisitionPoint> DatabaseManager::optimizeModbusReadBlocks(const QV
                 QStringList originalDataTypes;
                 QStringList originalDescriptions;
                 QStringList originalMeasurements;
+                QStringList originalByteOrders;
+                QStringList originalDeadbands;
                 
                 for (int k = i; k < j; k++) {
                     originalAddresses << QString::number(devicePoints[k].address);
@@ -395,6 +439,8 @@ QVector<DataAcquisitionPoint> DatabaseManager::optimizeModbusReadBlocks(const QV
                     originalDataTypes << devicePoints[k].tags.value("data_type", "UNKNOWN");
                     originalDescriptions << devicePoints[k].tags.value("description", QString("CURRENT_RTU_%1").arg(devicePoints[k].address));
                     originalMeasurements << devicePoints[k].measurement;
+                    originalByteOrders << BlockDecodePlan::byteOrderName(devicePoints[k].byteOrder);
+                    originalDeadbands << devicePoints[k].deadband.toString();
                 }
                 
                 optimizedBlock.tags["original_addresses"] = originalAddresses.join(",");
@@ -402,6 +448,11 @@ QVector<DataAcquisitionPoint> DatabaseManager::optimizeModbusReadBlocks(const QV
                 optimizedBlock.tags["original_data_types"] = originalDataTypes.join(",");
                 optimizedBlock.tags["original_descriptions"] = originalDescriptions.join(",");
                 optimizedBlock.tags["original_measurements"] = originalMeasurements.join(",");
+                optimizedBlock.tags["original_byte_orders"] = originalByteOrders.join(",");
+                optimizedBlock.tags["original_deadbands"] = originalDeadbands.join(",");
+                
+                // Parse the metadata once so replies decode without touching these strings
+                optimizedBlock.blockDecodePlan = BlockDecodePlan::compile(optimizedBlock);
                 
                 qDebug() << "=== BLOCK CREATION DEBUG ===";
                 qDebug() << "Created optimized block:" << optimizedBlock.name;
@@ -0,0 +1,187 @@
+#include "../include/modbus_bit_buffer.h"
+#include <QtAlgorithms>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MODBUS_BIT_BUFFER_X86 1
+#endif
+
+namespace {
+
+typedef int (*XorPopcount)(const quint64 *, const quint64 *, int);
+
+int xorPopcountPortable(const quint64 *a, const quint64 *b, int words)
+{
+    int changed = 0;
+    for (int i = 0; i < words; ++i) {
+        changed += qPopulationCount(a[i] ^ b[i]);
+    }
+    return changed;
+}
+
+#ifdef MODBUS_BIT_BUFFER_X86
+// Single POPCNT per word; the portable fallback is a bit-twiddling sequence
+__attribute__((target("popcnt")))
+int xorPopcountHardware(const quint64 *a, const quint64 *b, int words)
+{
+    int changed = 0;
+    for (int i = 0; i < words; ++i) {
+        changed += __builtin_popcountll(a[i] ^ b[i]);
+    }
+    return changed;
+}
+#endif
+
+XorPopcount xorPopcount()
+{
+#ifdef MODBUS_BIT_BUFFER_X86
+    static const XorPopcount function = __builtin_cpu_supports("popcnt") ? xorPopcountHardware : xorPopcountPortable;
+    return function;
+#else
+    return xorPopcountPortable;
+#endif
+}
+
+} // namespace
+
+ModbusBitBuffer::ModbusBitBuffer(int bitCount)
+    : m_words((qMax(0, bitCount) + 63) / 64, 0)
+    , m_size(qMax(0, bitCount))
+{
+}
+
+ModbusBitBuffer ModbusBitBuffer::fromPackedWords(const quint16 *words, int bitCount)
+{
+    ModbusBitBuffer buffer(bitCount);
+    const int sourceWords = (buffer.m_size + 15) / 16;
+    quint64 *out = buffer.m_words.data();
+
+    int w = 0;
+    for (; w + 4 <= sourceWords; w += 4) {
+        out[w / 4] = quint64(words[w]) | (quint64(words[w + 1]) << 16) |
+                     (quint64(words[w + 2]) << 32) | (quint64(words[w + 3]) << 48);
+    }
+    for (; w < sourceWords; ++w) {
+        out[w / 4] |= quint64(words[w]) << (16 * (w % 4));
+    }
+    buffer.clearTail();
+    return buffer;
+}
+
+ModbusBitBuffer ModbusBitBuffer::fromBitValues(const quint16 *values, int count)
+{
+    ModbusBitBuffer buffer(count);
+    quint64 *out = buffer.m_words.data();
+
+    int i = 0;
+#if defined(__SSE2__)
+    // 16 values per step: narrow to bytes (saturation keeps non-zero non-zero), compare, movemask
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i + 8));
+        const __m128i isZero = _mm_cmpeq_epi8(_mm_packs_epi16(low, high), zero);
+        const quint64 set = ~_mm_movemask_epi8(isZero) & 0xFFFF;
+        out[i >> 6] |= set << (i & 63);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (values[i]) {
+            out[i >> 6] |= quint64(1) << (i & 63);
+        }
+    }
+    return buffer;
+}
+
+void ModbusBitBuffer::setBit(int index, bool value)
+{
+    const quint64 bit = quint64(1) << (index & 63);
+    if (value) {
+        m_words[index >> 6] |= bit;
+    } else {
+        m_words[index >> 6] &= ~bit;
+    }
+}
+
+int ModbusBitBuffer::count() const
+{
+    int set = 0;
+    for (quint64 word : m_words) {
+        set += qPopulationCount(word);
+    }
+    return set;
+}
+
+ModbusBitBuffer ModbusBitBuffer::mid(int position, int length) const
+{
+    position = qBound(0, position, m_size);
+    length = qBound(0, length, m_size - position);
+    ModbusBitBuffer slice(length);
+
+    const int shift = position & 63;
+    const int first = position >> 6;
+    for (int w = 0; w < slice.m_words.size(); ++w) {
+        quint64 word = m_words.at(first + w) >> shift;
+        if (shift && first + w + 1 < m_words.size()) {
+            word |= m_words.at(first + w + 1) << (64 - shift);
+        }
+        slice.m_words[w] = word;
+    }
+    slice.clearTail();
+    return slice;
+}
+
+ModbusBitBuffer ModbusBitBuffer::changedSince(const ModbusBitBuffer &previous) const
+{
+    ModbusBitBuffer changed(m_size);
+    if (previous.m_size != m_size) {
+        changed.m_words.fill(~quint64(0));
+        changed.clearTail();
+        return changed;
+    }
+    for (int w = 0; w < m_words.size(); ++w) {
+        changed.m_words[w] = m_words.at(w) ^ previous.m_words.at(w);
+    }
+    return changed;
+}
+
+int ModbusBitBuffer::changedCountSince(const ModbusBitBuffer &previous) const
+{
+    if (previous.m_size != m_size) {
+        return m_size;
+    }
+    return xorPopcount()(m_words.constData(), previous.m_words.constData(), m_words.size());
+}
+
+QByteArray ModbusBitBuffer::toPackedBytes() const
+{
+    QByteArray bytes((m_size + 7) / 8, '\0');
+    for (int i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>(m_words.at(i >> 3) >> (8 * (i & 7)));
+    }
+    return bytes;
+}
+
+QVector<quint16> ModbusBitBuffer::toBitValues() const
+{
+    QVector<quint16> values(m_size);
+    for (int i = 0; i < m_size; ++i) {
+        values[i] = testBit(i);
+    }
+    return values;
+}
+
+int ModbusBitBuffer::countTrailingZeros(quint64 word)
+{
+    return qCountTrailingZeroBits(word);
+}
+
+void ModbusBitBuffer::clearTail()
+{
+    if (m_size & 63) {
+        m_words.last() &= (quint64(1) << (m_size & 63)) - 1;
+    }
+}
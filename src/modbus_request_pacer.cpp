@@ -0,0 +1,115 @@
+#include "../include/modbus_request_pacer.h"
+#include <QtMath>
+
+ModbusRequestPacer::ModbusRequestPacer(double ratePerSecond, int burst)
+    : m_configuredRate(0.0)
+    , m_rate(0.0)
+    , m_unthrottleRate(0.0)
+    , m_burst(1)
+    , m_tokens(1.0)
+    , m_lastRefill(0)
+    , m_adaptive(true)
+    , m_observedInterval(0.0)
+    , m_lastSend(0)
+    , m_lastBusy(0)
+    , m_lastIncrease(0)
+{
+    configure(ratePerSecond, burst);
+}
+
+void ModbusRequestPacer::configure(double ratePerSecond, int burst)
+{
+    m_configuredRate = qMax(0.0, ratePerSecond);
+    m_rate = m_configuredRate;
+    m_unthrottleRate = 0.0;
+    m_burst = qMax(1, burst);
+    m_tokens = m_burst;
+    m_lastRefill = 0;
+}
+
+void ModbusRequestPacer::refill(qint64 nowMs)
+{
+    if (m_lastRefill == 0 || nowMs < m_lastRefill) {
+        m_lastRefill = nowMs;
+        return;
+    }
+
+    m_tokens = qMin<double>(m_burst, m_tokens + (nowMs - m_lastRefill) * m_rate / 1000.0);
+    m_lastRefill = nowMs;
+}
+
+int ModbusRequestPacer::msUntilAvailable(qint64 nowMs)
+{
+    if (m_rate <= 0.0) {
+        return 0;
+    }
+
+    refill(nowMs);
+    if (m_tokens >= 1.0) {
+        return 0;
+    }
+
+    return qMax(1, qCeil((1.0 - m_tokens) * 1000.0 / m_rate));
+}
+
+void ModbusRequestPacer::consume(qint64 nowMs)
+{
+    // Track the actual send spacing so an unlimited pacer knows where to start throttling
+    if (m_lastSend > 0 && nowMs >= m_lastSend) {
+        const double interval = nowMs - m_lastSend;
+        m_observedInterval = m_observedInterval > 0.0 ? 0.8 * m_observedInterval + 0.2 * interval : interval;
+    }
+    m_lastSend = nowMs;
+
+    if (m_rate > 0.0) {
+        m_tokens = qMax(0.0, m_tokens - 1.0);
+    }
+}
+
+bool ModbusRequestPacer::onDeviceBusy(qint64 nowMs, qint64 sentMs)
+{
+    if (!m_adaptive) {
+        return false;
+    }
+
+    // Requests already on the wire at the last cut were sent at the old rate;
+    // their busy replies say nothing about the new one
+    if (m_lastBusy > 0 && sentMs <= m_lastBusy) {
+        return false;
+    }
+
+    double base = m_rate;
+    if (base <= 0.0) {
+        // Unlimited so far: start from the rate the device just refused
+        base = m_observedInterval > 0.0 ? 1000.0 / qMax(1.0, m_observedInterval) : 10.0;
+        m_unthrottleRate = base;
+    }
+
+    m_rate = qMax(MIN_RATE, base / 2.0);
+    m_tokens = 0.0;
+    m_lastRefill = nowMs;
+    m_lastBusy = nowMs;
+    m_lastIncrease = nowMs;
+    return true;
+}
+
+void ModbusRequestPacer::onSuccess(qint64 nowMs)
+{
+    if (!m_adaptive || !isThrottled()) {
+        return;
+    }
+
+    if (nowMs - m_lastBusy < RECOVERY_HOLDOFF_MS || nowMs - m_lastIncrease < RECOVERY_STEP_MS) {
+        return;
+    }
+
+    m_rate += qMax(MIN_RATE, m_rate * RECOVERY_FACTOR);
+    m_lastIncrease = nowMs;
+
+    // Back at the configured ceiling (or the point where an unlimited pacer was refused)
+    const double ceiling = m_configuredRate > 0.0 ? m_configuredRate : m_unthrottleRate;
+    if (m_rate >= ceiling) {
+        m_rate = m_configuredRate;
+        m_unthrottleRate = 0.0;
+    }
+}
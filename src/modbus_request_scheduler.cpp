@@ -0,0 +1,175 @@
+#include "../include/modbus_request_scheduler.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+ModbusRequestScheduler::ModbusRequestScheduler()
+    : m_nextSequence(1)
+    , m_size(0)
+    , m_unitFairness(false)
+{
+}
+
+int ModbusRequestScheduler::levelIndex(RequestPriority priority)
+{
+    return qBound(0, static_cast<int>(priority), PRIORITY_LEVELS - 1);
+}
+
+quint64 ModbusRequestScheduler::pollKey(const PriorityModbusRequest &request)
+{
+    // Packs function, priority, data type, unit, address and count into one key
+    const ModbusRequest &req = request.request;
+    return (static_cast<quint64>(req.type) & 0x7) << 61 |
+           (static_cast<quint64>(levelIndex(request.priority)) & 0x3) << 59 |
+           (static_cast<quint64>(req.dataType) & 0xF) << 55 |
+           (static_cast<quint64>(req.unitId) & 0xFF) << 47 |
+           (static_cast<quint64>(req.startAddress) & 0xFFFF) << 31 |
+           (static_cast<quint64>(req.count) & 0x7FFFFFFF);
+}
+
+bool ModbusRequestScheduler::push(const PriorityModbusRequest &request, PriorityModbusRequest *superseded)
+{
+    bool replaced = false;
+    const bool isPoll = request.request.deadline > 0;
+    const quint64 key = isPoll ? pollKey(request) : 0;
+
+    // The older poll stays in its heap and is skipped when it surfaces
+    if (isPoll) {
+        auto indexed = m_pollIndex.find(key);
+        if (indexed != m_pollIndex.end()) {
+            auto old = m_entries.find(indexed.value());
+            if (old != m_entries.end()) {
+                if (superseded) {
+                    *superseded = old.value();
+                }
+                m_levels[levelIndex(old.value().priority)].live--;
+                m_entries.erase(old);
+                m_size--;
+                replaced = true;
+            }
+            m_pollIndex.erase(indexed);
+        }
+    }
+
+    const quint64 sequence = m_nextSequence++;
+    HeapEntry entry;
+    entry.deadline = isPoll ? request.request.deadline : request.queueTime;
+    entry.sequence = sequence;
+
+    Level &level = m_levels[levelIndex(request.priority)];
+    QVector<HeapEntry> &heap = level.lanes[m_unitFairness ? request.request.unitId : 0];
+    heap.append(entry);
+    std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+
+    m_entries.insert(sequence, request);
+    if (isPoll) {
+        m_pollIndex.insert(key, sequence);
+    }
+    level.live++;
+    m_size++;
+
+    return replaced;
+}
+
+QMap<int, QVector<ModbusRequestScheduler::HeapEntry>>::iterator ModbusRequestScheduler::selectLane(Level &level)
+{
+    if (m_unitFairness) {
+        // Next unit after the one served last, wrapping around
+        auto lane = level.lanes.upperBound(level.lastUnit);
+        return lane != level.lanes.end() ? lane : level.lanes.begin();
+    }
+
+    // Single lane in the common case; otherwise the lane with the most urgent head
+    auto best = level.lanes.begin();
+    for (auto lane = std::next(best); lane != level.lanes.end(); ++lane) {
+        if (best.value().first() > lane.value().first()) {
+            best = lane;
+        }
+    }
+    return best;
+}
+
+PriorityModbusRequest ModbusRequestScheduler::pop(qint64 now, QList<PriorityModbusRequest> *expired)
+{
+    for (int index = PRIORITY_LEVELS - 1; index >= 0; --index) {
+        Level &level = m_levels[index];
+
+        while (level.live > 0 && !level.lanes.isEmpty()) {
+            auto lane = selectLane(level);
+            QVector<HeapEntry> &heap = lane.value();
+            const int unit = lane.key();
+
+            std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            const quint64 sequence = heap.last().sequence;
+            heap.removeLast();
+            if (heap.isEmpty()) {
+                level.lanes.erase(lane);
+            }
+
+            auto it = m_entries.find(sequence);
+            if (it == m_entries.end()) {
+                continue;  // Superseded
+            }
+
+            PriorityModbusRequest request = it.value();
+            m_entries.erase(it);
+            level.live--;
+            m_size--;
+            if (request.request.deadline > 0) {
+                m_pollIndex.remove(pollKey(request));
+            }
+
+            if (request.request.deadline > 0 && request.request.deadline < now) {
+                if (expired) {
+                    expired->append(request);
+                }
+                continue;
+            }
+
+            level.lastUnit = unit;
+            return request;
+        }
+
+        // Only superseded entries left; release them
+        if (level.live == 0) {
+            level.lanes.clear();
+        }
+    }
+
+    return PriorityModbusRequest();
+}
+
+bool ModbusRequestScheduler::hasPriorityAbove(RequestPriority priority) const
+{
+    for (int index = levelIndex(priority) + 1; index < PRIORITY_LEVELS; ++index) {
+        if (m_levels[index].live > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QList<PriorityModbusRequest> ModbusRequestScheduler::takeAll()
+{
+    QList<quint64> sequences = m_entries.keys();
+    std::sort(sequences.begin(), sequences.end());
+
+    QList<PriorityModbusRequest> requests;
+    requests.reserve(sequences.size());
+    for (quint64 sequence : sequences) {
+        requests.append(m_entries.value(sequence));
+    }
+
+    clear();
+    return requests;
+}
+
+void ModbusRequestScheduler::clear()
+{
+    for (int index = 0; index < PRIORITY_LEVELS; ++index) {
+        m_levels[index] = Level();
+    }
+    m_entries.clear();
+    m_pollIndex.clear();
+    m_size = 0;
+}
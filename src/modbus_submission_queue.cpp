@@ -0,0 +1,56 @@
+#include "../include/modbus_submission_queue.h"
+
+ModbusSubmissionQueue::ModbusSubmissionQueue(int capacity)
+    : m_mask(0)
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+{
+    quint32 size = 2;
+    while (size < static_cast<quint32>(qMax(2, capacity))) {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+
+    m_slots.reset(new Slot[size]);
+    for (quint32 i = 0; i < size; ++i) {
+        m_slots[i].sequence.storeRelaxed(i);
+    }
+}
+
+bool ModbusSubmissionQueue::tryPush(const PriorityModbusRequest &request)
+{
+    quint32 pos = m_enqueuePos.loadRelaxed();
+    for (;;) {
+        Slot &slot = m_slots[pos & m_mask];
+        const quint32 sequence = slot.sequence.loadAcquire();
+        const qint32 diff = static_cast<qint32>(sequence - pos);
+
+        if (diff == 0) {
+            // Slot is free for this lap; claim the position (pos is refreshed on failure)
+            if (m_enqueuePos.testAndSetRelaxed(pos, pos + 1, pos)) {
+                slot.request = request;
+                slot.sequence.storeRelease(pos + 1);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Consumer has not freed this slot yet: full
+        } else {
+            pos = m_enqueuePos.loadRelaxed();  // Another producer took it
+        }
+    }
+}
+
+bool ModbusSubmissionQueue::tryPop(PriorityModbusRequest &request)
+{
+    Slot &slot = m_slots[m_dequeuePos & m_mask];
+    const quint32 sequence = slot.sequence.loadAcquire();
+    if (static_cast<qint32>(sequence - (m_dequeuePos + 1)) < 0) {
+        return false;
+    }
+
+    request = slot.request;
+    slot.request = PriorityModbusRequest();  // Release payload buffers now
+    slot.sequence.storeRelease(m_dequeuePos + m_mask + 1);
+    m_dequeuePos++;
+    return true;
+}
@@ -0,0 +1,570 @@
+#include "../include/modbus_tcp_engine.h"
+#include <QDebug>
+#include <QHostInfo>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+namespace {
+
+inline void putUInt16(quint8 *dst, quint16 value)
+{
+    dst[0] = static_cast<quint8>(value >> 8);
+    dst[1] = static_cast<quint8>(value & 0xFF);
+}
+
+inline quint16 getUInt16(const quint8 *src)
+{
+    return static_cast<quint16>((src[0] << 8) | src[1]);
+}
+
+} // namespace
+
+ModbusTcpEngine::ModbusTcpEngine(QObject *parent)
+    : QObject(parent)
+    , m_socketFd(-1)
+    , m_epollFd(-1)
+    , m_notifier(nullptr)
+    , m_connectTimer(nullptr)
+    , m_state(QModbusDevice::UnconnectedState)
+    , m_wantWrite(false)
+    , m_txOffset(0)
+    , m_rxLength(0)
+    , m_socketGeneration(0)
+    , m_lookupId(-1)
+    , m_lookupPort(0)
+{
+    std::memset(m_frame, 0, sizeof(m_frame));
+    m_txBuffer.reserve(RX_BUFFER_SIZE);
+    m_rxBuffer.resize(RX_BUFFER_SIZE);
+    m_values.reserve(2000);
+
+    m_connectTimer = new QTimer(this);
+    m_connectTimer->setSingleShot(true);
+    connect(m_connectTimer, &QTimer::timeout, this, &ModbusTcpEngine::onConnectTimeout);
+}
+
+ModbusTcpEngine::~ModbusTcpEngine()
+{
+    // The owning ModbusManager is already being destroyed
+    blockSignals(true);
+    closeSocket();
+}
+
+bool ModbusTcpEngine::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ModbusTcpEngine::connectToHost(const QString &host, int port, int timeoutMs)
+{
+#ifdef Q_OS_LINUX
+    if (m_state == QModbusDevice::ConnectedState || m_state == QModbusDevice::ConnectingState) {
+        return true;
+    }
+
+    // An address literal needs no lookup and connects (or fails) right away
+    QHostAddress address;
+    if (address.setAddress(host)) {
+        if (address.protocol() != QAbstractSocket::IPv4Protocol) {
+            emit errorOccurred(QString("Modbus host %1 is not an IPv4 address").arg(host));
+            return false;
+        }
+        if (!openSocket(address, port)) {
+            return false;
+        }
+        m_connectTimer->start(timeoutMs);
+        return true;
+    }
+
+    // Host names resolve on Qt's lookup thread so DNS never blocks the event loop;
+    // the connect timeout covers the lookup and the TCP handshake together
+    m_lookupPort = port;
+    setState(QModbusDevice::ConnectingState);
+    m_connectTimer->start(timeoutMs);
+    m_lookupId = QHostInfo::lookupHost(host, this, &ModbusTcpEngine::onHostResolved);
+    return true;
+#else
+    Q_UNUSED(host);
+    Q_UNUSED(port);
+    Q_UNUSED(timeoutMs);
+    emit errorOccurred("Native Modbus TCP engine is not supported on this platform");
+    return false;
+#endif
+}
+
+void ModbusTcpEngine::onHostResolved(const QHostInfo &hostInfo)
+{
+    if (hostInfo.lookupId() != m_lookupId) {
+        return; // Aborted by closeSocket()
+    }
+    m_lookupId = -1;
+
+    const QList<QHostAddress> addresses = hostInfo.addresses();
+    for (const QHostAddress &address : addresses) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            openSocket(address, m_lookupPort);
+            return;
+        }
+    }
+    closeSocket(QString("Failed to resolve Modbus host %1").arg(hostInfo.hostName()));
+}
+
+bool ModbusTcpEngine::openSocket(const QHostAddress &address, int port)
+{
+#ifdef Q_OS_LINUX
+    sockaddr_in target;
+    std::memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons(static_cast<quint16>(port));
+    target.sin_addr.s_addr = htonl(address.toIPv4Address());
+
+    m_socketFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_socketFd < 0) {
+        closeSocket(QString("Failed to create socket: %1").arg(strerror(errno)));
+        return false;
+    }
+
+    int noDelay = 1;
+    setsockopt(m_socketFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    int rc = ::connect(m_socketFd, reinterpret_cast<const sockaddr *>(&target), sizeof(target));
+    if (rc < 0 && errno != EINPROGRESS) {
+        closeSocket(QString("Failed to connect to %1:%2: %3").arg(address.toString()).arg(port).arg(strerror(errno)));
+        return false;
+    }
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0) {
+        closeSocket(QString("Failed to create epoll instance: %1").arg(strerror(errno)));
+        return false;
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+    event.data.fd = m_socketFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_socketFd, &event) < 0) {
+        closeSocket(QString("Failed to register socket with epoll: %1").arg(strerror(errno)));
+        return false;
+    }
+    m_wantWrite = true;
+
+    // The epoll descriptor becomes readable whenever any registered event is pending
+    m_notifier = new QSocketNotifier(m_epollFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ModbusTcpEngine::onEpollActivated);
+
+    m_txBuffer.clear();
+    m_txOffset = 0;
+    m_rxLength = 0;
+
+    setState(QModbusDevice::ConnectingState);
+    return true;
+#else
+    Q_UNUSED(address);
+    Q_UNUSED(port);
+    return false;
+#endif
+}
+
+void ModbusTcpEngine::disconnectFromHost()
+{
+    closeSocket();
+}
+
+bool ModbusTcpEngine::sendReadRequest(quint16 transactionId, int unitId, FunctionCode functionCode,
+                                      int startAddress, int count)
+{
+    // MBAP header + FC + start + count
+    putUInt16(m_frame, transactionId);
+    putUInt16(m_frame + 2, 0);
+    putUInt16(m_frame + 4, 6);
+    m_frame[6] = static_cast<quint8>(unitId);
+    m_frame[7] = functionCode;
+    putUInt16(m_frame + 8, static_cast<quint16>(startAddress));
+    putUInt16(m_frame + 10, static_cast<quint16>(count));
+    return queueFrame(12);
+}
+
+bool ModbusTcpEngine::sendWriteRegisters(quint16 transactionId, int unitId, int startAddress,
+                                         const QVector<quint16> &values)
+{
+    if (values.isEmpty() || values.size() > 123) {
+        emit errorOccurred(QString("Invalid register write size %1").arg(values.size()));
+        return false;
+    }
+
+    putUInt16(m_frame, transactionId);
+    putUInt16(m_frame + 2, 0);
+    m_frame[6] = static_cast<quint8>(unitId);
+
+    if (values.size() == 1) {
+        putUInt16(m_frame + 4, 6);
+        m_frame[7] = WriteSingleRegister;
+        putUInt16(m_frame + 8, static_cast<quint16>(startAddress));
+        putUInt16(m_frame + 10, values.first());
+        return queueFrame(12);
+    }
+
+    const int byteCount = values.size() * 2;
+    putUInt16(m_frame + 4, static_cast<quint16>(7 + byteCount));
+    m_frame[7] = WriteMultipleRegisters;
+    putUInt16(m_frame + 8, static_cast<quint16>(startAddress));
+    putUInt16(m_frame + 10, static_cast<quint16>(values.size()));
+    m_frame[12] = static_cast<quint8>(byteCount);
+    for (int i = 0; i < values.size(); ++i) {
+        putUInt16(m_frame + 13 + i * 2, values[i]);
+    }
+    return queueFrame(13 + byteCount);
+}
+
+bool ModbusTcpEngine::sendWriteCoils(quint16 transactionId, int unitId, int startAddress,
+                                     const QVector<bool> &values)
+{
+    if (values.isEmpty() || values.size() > 1968) {
+        emit errorOccurred(QString("Invalid coil write size %1").arg(values.size()));
+        return false;
+    }
+
+    putUInt16(m_frame, transactionId);
+    putUInt16(m_frame + 2, 0);
+    m_frame[6] = static_cast<quint8>(unitId);
+
+    if (values.size() == 1) {
+        putUInt16(m_frame + 4, 6);
+        m_frame[7] = WriteSingleCoil;
+        putUInt16(m_frame + 8, static_cast<quint16>(startAddress));
+        putUInt16(m_frame + 10, values.first() ? 0xFF00 : 0x0000);
+        return queueFrame(12);
+    }
+
+    const int byteCount = (values.size() + 7) / 8;
+    putUInt16(m_frame + 4, static_cast<quint16>(7 + byteCount));
+    m_frame[7] = WriteMultipleCoils;
+    putUInt16(m_frame + 8, static_cast<quint16>(startAddress));
+    putUInt16(m_frame + 10, static_cast<quint16>(values.size()));
+    m_frame[12] = static_cast<quint8>(byteCount);
+    std::memset(m_frame + 13, 0, byteCount);
+    for (int i = 0; i < values.size(); ++i) {
+        if (values[i]) {
+            m_frame[13 + i / 8] |= static_cast<quint8>(1 << (i % 8));
+        }
+    }
+    return queueFrame(13 + byteCount);
+}
+
+bool ModbusTcpEngine::queueFrame(int length)
+{
+    if (m_state != QModbusDevice::ConnectedState) {
+        return false;
+    }
+
+    // Compact already-sent bytes before appending so the reserved capacity is reused
+    if (m_txOffset > 0) {
+        m_txBuffer.remove(0, m_txOffset);
+        m_txOffset = 0;
+    }
+    m_txBuffer.append(reinterpret_cast<const char *>(m_frame), length);
+    return flushTransmitBuffer();
+}
+
+bool ModbusTcpEngine::flushTransmitBuffer()
+{
+#ifdef Q_OS_LINUX
+    while (m_txOffset < m_txBuffer.size()) {
+        ssize_t written = ::send(m_socketFd, m_txBuffer.constData() + m_txOffset,
+                                 m_txBuffer.size() - m_txOffset, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                updateEpollInterest(true);
+                return true;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            closeSocket(QString("Modbus socket write failed: %1").arg(strerror(errno)));
+            return false;
+        }
+        m_txOffset += static_cast<int>(written);
+    }
+
+    m_txBuffer.clear();
+    m_txOffset = 0;
+    updateEpollInterest(false);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ModbusTcpEngine::onEpollActivated()
+{
+#ifdef Q_OS_LINUX
+    epoll_event events[MAX_EPOLL_EVENTS];
+    int count = epoll_wait(m_epollFd, events, MAX_EPOLL_EVENTS, 0);
+
+    for (int i = 0; i < count && m_socketFd >= 0; ++i) {
+        const quint32 flags = events[i].events;
+
+        if (m_state == QModbusDevice::ConnectingState && (flags & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+            finishConnect();
+            continue;
+        }
+        if (flags & EPOLLIN) {
+            readAvailable();
+        }
+        if (m_socketFd >= 0 && (flags & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))) {
+            closeSocket("Modbus connection closed by remote host");
+            break;
+        }
+        if (m_socketFd >= 0 && (flags & EPOLLOUT)) {
+            flushTransmitBuffer();
+        }
+    }
+#endif
+}
+
+void ModbusTcpEngine::onConnectTimeout()
+{
+    if (m_state == QModbusDevice::ConnectingState) {
+        closeSocket("Modbus connection timeout");
+    }
+}
+
+void ModbusTcpEngine::finishConnect()
+{
+#ifdef Q_OS_LINUX
+    int socketError = 0;
+    socklen_t length = sizeof(socketError);
+    getsockopt(m_socketFd, SOL_SOCKET, SO_ERROR, &socketError, &length);
+    m_connectTimer->stop();
+
+    if (socketError != 0) {
+        closeSocket(QString("Modbus connection failed: %1").arg(strerror(socketError)));
+        return;
+    }
+
+    updateEpollInterest(false);
+    setState(QModbusDevice::ConnectedState);
+#endif
+}
+
+void ModbusTcpEngine::readAvailable()
+{
+#ifdef Q_OS_LINUX
+    for (;;) {
+        if (m_rxLength == m_rxBuffer.size()) {
+            closeSocket("Modbus receive buffer overflow");
+            return;
+        }
+
+        ssize_t received = ::recv(m_socketFd, m_rxBuffer.data() + m_rxLength,
+                                  m_rxBuffer.size() - m_rxLength, 0);
+        if (received > 0) {
+            m_rxLength += static_cast<int>(received);
+            parseFrames();
+            if (m_socketFd < 0) {
+                return;
+            }
+            continue;
+        }
+        if (received == 0) {
+            closeSocket("Modbus connection closed by remote host");
+            return;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            closeSocket(QString("Modbus socket read failed: %1").arg(strerror(errno)));
+        }
+        return;
+    }
+#endif
+}
+
+void ModbusTcpEngine::processReceivedData(const char *data, int length)
+{
+    if (length > m_rxBuffer.size() - m_rxLength) {
+        closeSocket("Modbus receive buffer overflow");
+        return;
+    }
+    std::memcpy(m_rxBuffer.data() + m_rxLength, data, length);
+    m_rxLength += length;
+    parseFrames();
+}
+
+void ModbusTcpEngine::parseFrames()
+{
+    const quint8 *buffer = reinterpret_cast<const quint8 *>(m_rxBuffer.constData());
+    const quint32 generation = m_socketGeneration;
+    int offset = 0;
+
+    while (m_rxLength - offset >= MBAP_HEADER_SIZE) {
+        const quint8 *frame = buffer + offset;
+        const quint16 transactionId = getUInt16(frame);
+        const quint16 protocolId = getUInt16(frame + 2);
+        const quint16 length = getUInt16(frame + 4);
+
+        if (protocolId != 0 || length < 2 || length > MAX_ADU_SIZE - 6) {
+            closeSocket(QString("Invalid MBAP header (protocol %1, length %2)").arg(protocolId).arg(length));
+            return;
+        }
+
+        const int frameSize = 6 + length;
+        if (m_rxLength - offset < frameSize) {
+            break;
+        }
+
+        const quint8 unitId = frame[6];
+        const quint8 functionCode = frame[7];
+        const quint8 *data = frame + 8;
+        const int dataLength = length - 2;
+
+        if (functionCode & 0x80) {
+            emit exceptionReceived(transactionId, functionCode & 0x7F, dataLength > 0 ? data[0] : 0);
+        } else {
+            m_values.clear();
+            int byteCount = 0;
+            QString error;
+            switch (functionCode) {
+                case ReadCoils:
+                case ReadDiscreteInputs:
+                    if (dataLength < 1 || data[0] != dataLength - 1) {
+                        error = QString("byte count %1 does not match %2 data bytes")
+                                    .arg(dataLength < 1 ? 0 : data[0]).arg(qMax(0, dataLength - 1));
+                        break;
+                    }
+                    byteCount = data[0];
+                    for (int i = 0; i < byteCount; i += 2) {
+                        const quint8 high = i + 1 < byteCount ? data[2 + i] : 0;
+                        m_values.append(static_cast<quint16>(data[1 + i] | (high << 8)));
+                    }
+                    break;
+                case ReadHoldingRegisters:
+                case ReadInputRegisters:
+                    if (dataLength < 1 || data[0] != dataLength - 1 || (data[0] & 1)) {
+                        error = QString("byte count %1 does not match %2 data bytes")
+                                    .arg(dataLength < 1 ? 0 : data[0]).arg(qMax(0, dataLength - 1));
+                        break;
+                    }
+                    byteCount = data[0];
+                    for (int i = 0; i < byteCount; i += 2) {
+                        m_values.append(getUInt16(data + 1 + i));
+                    }
+                    break;
+                default:
+                    // Write responses echo address and value/quantity
+                    if (dataLength != 4) {
+                        error = QString("write response carries %1 data bytes, expected 4").arg(dataLength);
+                        break;
+                    }
+                    m_values.append(getUInt16(data));
+                    m_values.append(getUInt16(data + 2));
+                    break;
+            }
+
+            if (error.isEmpty()) {
+                emit responseReceived(transactionId, unitId, functionCode, byteCount, m_values);
+            } else {
+                emit malformedResponse(transactionId, functionCode,
+                                       QString("Malformed Modbus response: %1").arg(error));
+            }
+        }
+
+        // A handler may have closed the socket, which already reset the buffer
+        offset += frameSize;
+        if (m_socketGeneration != generation) {
+            return;
+        }
+    }
+
+    // Keep any partial frame at the front of the buffer
+    if (offset > 0) {
+        std::memmove(m_rxBuffer.data(), m_rxBuffer.constData() + offset, m_rxLength - offset);
+        m_rxLength -= offset;
+    }
+}
+
+void ModbusTcpEngine::updateEpollInterest(bool wantWrite)
+{
+#ifdef Q_OS_LINUX
+    if (m_epollFd < 0 || m_socketFd < 0 || m_wantWrite == wantWrite) {
+        return;
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? EPOLLOUT : 0);
+    event.data.fd = m_socketFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_MOD, m_socketFd, &event) == 0) {
+        m_wantWrite = wantWrite;
+    }
+#else
+    Q_UNUSED(wantWrite);
+#endif
+}
+
+void ModbusTcpEngine::setState(QModbusDevice::State state)
+{
+    if (m_state == state) {
+        return;
+    }
+    m_state = state;
+    emit stateChanged(state);
+}
+
+void ModbusTcpEngine::closeSocket(const QString &error)
+{
+    if (m_connectTimer) {
+        m_connectTimer->stop();
+    }
+
+    if (m_lookupId >= 0) {
+        QHostInfo::abortHostLookup(m_lookupId);
+        m_lookupId = -1;
+    }
+
+    if (m_notifier) {
+        m_notifier->setEnabled(false);
+        m_notifier->deleteLater();
+        m_notifier = nullptr;
+    }
+
+#ifdef Q_OS_LINUX
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+    }
+    if (m_socketFd >= 0) {
+        ::close(m_socketFd);
+    }
+#endif
+    m_epollFd = -1;
+    m_socketFd = -1;
+    m_wantWrite = false;
+    m_txBuffer.clear();
+    m_txOffset = 0;
+    m_rxLength = 0;
+    ++m_socketGeneration;
+
+    if (!error.isEmpty()) {
+        qDebug() << "ModbusTcpEngine:" << error;
+        emit errorOccurred(error);
+    }
+    setState(QModbusDevice::UnconnectedState);
+}
@@ -8,6 +8,8 @@
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QMutexLocker>
+#include <limits>
+#include <algorithm>
 
 // Initialize static semaphore to allow max 8 simultaneous connections for multi-device SCADA
 QSemaphore ModbusWorker::s_connectionSemaphore(8);
@@ -20,8 +22,12 @@ ModbusWorker::ModbusWorker(const QString& host, int port, int unitId, QObject* p
     , m_unitId(unitId)
     , m_deviceKey(QString("%1:%2:%3").arg(host).arg(port).arg(unitId))
     , m_modbusManager(nullptr)
+    , m_submissionQueue(SUBMISSION_QUEUE_CAPACITY)
+    , m_drainScheduled(0)
     , m_nextRequestId(1)
-    , m_requestInProgress(false)
+    , m_maxConcurrentRequests(1)
+    , m_requestTimeoutTimer(nullptr)
+    , m_sharedConnection(false)
     , m_pollTimer(nullptr)
     , m_pollInterval(2000)  // Increased from 1000ms to reduce connection drops
     , m_pollingEnabled(false)
@@ -38,7 +44,6 @@ ModbusWorker::ModbusWorker(const QString& host, int port, int unitId, QObject* p
     , m_lastFailureTime(0)
     , m_batchingEnabled(true)
     , m_maxBatchSize(5)
-    , m_batchTimer(nullptr)
     , m_healthMonitoringEnabled(true)
     , m_connectionHealthScore(1.0)
     , m_lastHealthCheck(0)
@@ -78,13 +83,6 @@ void ModbusWorker::initializeTimers()
         // Request timeout timer created
     }
     
-    if (!m_batchTimer) {
-        m_batchTimer = new QTimer(this);
-        m_batchTimer->setSingleShot(true);
-        connect(m_batchTimer, &QTimer::timeout, this, &ModbusWorker::onBatchTimeout);
-        // Batch timer created
-    }
-    
     if (!m_healthCheckTimer) {
         m_healthCheckTimer = new QTimer(this);
         m_healthCheckTimer->setSingleShot(false);
@@ -181,7 +179,11 @@ void ModbusWorker::disconnectFromDevice()
     m_statistics.isConnected = false;
     
     // Clear pending requests
-    m_requestQueue.clear();
+    {
+        QMutexLocker locker(&m_queueMutex);
+        interruptQueuedRequests("Disconnected");
+    }
+    abortAllSingleFlights("Disconnected");
     
     emit connectionStateChanged(m_deviceKey, false);
 }
@@ -210,14 +212,6 @@ void ModbusWorker::setBatchingEnabled(bool enabled)
     QMutexLocker locker(&m_queueMutex);
     m_batchingEnabled = enabled;
     qDebug() << "ModbusWorker::setBatchingEnabled() - Batching" << (enabled ? "enabled" : "disabled") << "for device:" << m_deviceKey;
-    
-    // If disabling batching and batch timer is active, stop it and process any queued batches
-    if (!enabled && m_batchTimer && m_batchTimer->isActive()) {
-        m_batchTimer->stop();
-        if (!m_batchQueue.isEmpty()) {
-            processBatchQueue();
-        }
-    }
 }
 
 bool ModbusWorker::isBatchingEnabled() const
@@ -232,14 +226,6 @@ void ModbusWorker::setMaxBatchSize(int maxSize)
     if (maxSize > 0) {
         m_maxBatchSize = maxSize;
         qDebug() << "ModbusWorker::setMaxBatchSize() - Max batch size set to" << maxSize << "for device:" << m_deviceKey;
-        
-        // If current batch exceeds new max size, process it immediately
-        if (m_batchQueue.size() >= m_maxBatchSize) {
-            if (m_batchTimer && m_batchTimer->isActive()) {
-                m_batchTimer->stop();
-            }
-            processBatchQueue();
-        }
     }
 }
 
@@ -380,20 +366,123 @@ ModbusWorker::WorkerStatistics ModbusWorker::getStatistics() const
     return m_statistics;
 }
 
+namespace {
+
+// Heartbeats are low priority single register reads at address 0
+inline bool isHeartbeatRequest(const PriorityModbusRequest &request)
+{
+    return request.priority == RequestPriority::Low &&
+           request.request.type == ModbusRequest::ReadHoldingRegisters &&
+           request.request.startAddress == 0 &&
+           request.request.count == 1;
+}
+
+inline bool isReadRequest(const ModbusRequest &request)
+{
+    return request.type == ModbusRequest::ReadHoldingRegisters ||
+           request.type == ModbusRequest::ReadInputRegisters ||
+           request.type == ModbusRequest::ReadCoils ||
+           request.type == ModbusRequest::ReadDiscreteInputs;
+}
+
+// Identical on the wire: same function code, unit, start and count
+inline quint64 singleFlightKey(const ModbusRequest &request)
+{
+    return (static_cast<quint64>(request.type) & 0xFF) << 56 |
+           (static_cast<quint64>(request.unitId) & 0xFF) << 48 |
+           (static_cast<quint64>(request.startAddress) & 0xFFFF) << 32 |
+           (static_cast<quint64>(request.count) & 0xFFFFFFFF);
+}
+
+} // namespace
+
 void ModbusWorker::insertRequestByPriority(const PriorityModbusRequest& request)
 {
-    // Find insertion point based on priority
-    int insertIndex = 0;
+    // A duplicate of a read already on the wire waits for that read's result
+    if (joinSingleFlight(request)) {
+        return;
+    }
     
-    for (int i = 0; i < m_requestQueue.size(); ++i) {
-        if (static_cast<int>(request.priority) > static_cast<int>(m_requestQueue[i].priority)) {
-            insertIndex = i;
-            break;
+    // A newer poll of the same range supersedes one still waiting in the queue
+    PriorityModbusRequest superseded;
+    if (m_requestQueue.push(request, &superseded)) {
+        {
+            QMutexLocker statsLocker(&m_statsMutex);
+            m_statistics.mergedRequests++;
+        }
+        abortSingleFlight(superseded.requestId, "Superseded by newer poll");
+        emit requestInterrupted(superseded.requestId, "Superseded by newer poll");
+    }
+}
+
+bool ModbusWorker::joinSingleFlight(const PriorityModbusRequest &request)
+{
+    if (!isReadRequest(request.request) || isHeartbeatRequest(request)) {
+        return false;
+    }
+    
+    const quint64 key = singleFlightKey(request.request);
+    if (m_singleFlights.join(key, request)) {
+        QMutexLocker statsLocker(&m_statsMutex);
+        m_statistics.sharedRequests++;
+        return true;
+    }
+    
+    // Nothing usable on the wire: this read leads once it is sent. A leader still
+    // queued is left to the scheduler, which supersedes it with this poll.
+    m_singleFlights.lead(key, request.requestId, request.priority);
+    return false;
+}
+
+void ModbusWorker::resolveSingleFlight(qint64 leaderId, const ModbusReadResult &result)
+{
+    // Same range as the leader; only the decode type can differ
+    const QList<PriorityModbusRequest> followers = m_singleFlights.take(leaderId);
+    for (const auto &follower : followers) {
+        if (follower.request.dataType == result.dataType) {
+            emit readCompleted(follower.requestId, result);
+        } else {
+            emit readCompleted(follower.requestId,
+                               m_modbusManager->sliceReadResult(result, result.startAddress,
+                                                                follower.request.count, follower.request.dataType));
         }
-        insertIndex = i + 1;
+    }
+}
+
+void ModbusWorker::abortSingleFlight(qint64 leaderId, const QString &reason)
+{
+    const QList<PriorityModbusRequest> followers = m_singleFlights.take(leaderId);
+    for (const auto &follower : followers) {
+        emit requestInterrupted(follower.requestId, reason);
+    }
+}
+
+void ModbusWorker::abortAllSingleFlights(const QString &reason)
+{
+    const QList<qint64> leaders = m_singleFlights.leaders();
+    for (qint64 leaderId : leaders) {
+        abortSingleFlight(leaderId, reason);
+    }
+}
+
+void ModbusWorker::reportExpiredRequests(const QList<PriorityModbusRequest> &expired)
+{
+    // Executing a poll after its deadline only delivers data that a newer poll
+    // replaces anyway; shedding it keeps queueing delay bounded under overload
+    if (expired.isEmpty()) {
+        return;
+    }
+    
+    for (const PriorityModbusRequest &request : expired) {
+        abortSingleFlight(request.requestId, "Poll deadline expired");
+        emit requestInterrupted(request.requestId, "Poll deadline expired");
     }
     
-    m_requestQueue.insert(insertIndex, request);
+    {
+        QMutexLocker statsLocker(&m_statsMutex);
+        m_statistics.expiredRequests += expired.size();
+    }
+    qDebug() << "ModbusWorker - Dropped" << expired.size() << "stale polls for device:" << m_deviceKey;
 }
 
 // processNextRequest method removed - functionality moved to processRequestQueue
@@ -402,15 +491,19 @@ void ModbusWorker::insertRequestByPriority(const PriorityModbusRequest& request)
 
 void ModbusWorker::onModbusReadCompleted(const ModbusReadResult& result)
 {
-    if (!m_requestInProgress) {
+    if (!m_inFlightRequests.contains(result.transactionId)) {
         return; // Not our request
     }
     
-    // Check if this is a heartbeat request (low priority, single register read at address 0)
-    bool isHeartbeat = (m_currentRequest.priority == RequestPriority::Low &&
-                       m_currentRequest.request.type == ModbusRequest::ReadHoldingRegisters &&
-                       m_currentRequest.request.startAddress == 0 &&
-                       m_currentRequest.request.count == 1);
+    if (m_coalescedReads.contains(result.transactionId)) {
+        completeCoalescedRead(result);
+        return;
+    }
+    
+    const PriorityModbusRequest request = m_inFlightRequests.value(result.transactionId);
+    
+    // Check if this is a heartbeat request
+    bool isHeartbeat = isHeartbeatRequest(request);
     
     m_statistics.totalRequests++;
     if (result.success) {
@@ -421,12 +514,13 @@ void ModbusWorker::onModbusReadCompleted(const ModbusReadResult& result)
             handleHeartbeatResponse(true);
         } else {
             // Normal read request
-            qDebug() << "🔧 ModbusWorker emitting readCompleted signal - Request ID:" << m_currentRequest.requestId 
-                     << "Device:" << m_deviceKey << "Address:" << result.startAddress << "Priority:" << (int)m_currentRequest.priority;
-            emit readCompleted(m_currentRequest.requestId, result);
+            qDebug() << "🔧 ModbusWorker emitting readCompleted signal - Request ID:" << request.requestId 
+                     << "Device:" << m_deviceKey << "Address:" << result.startAddress << "Priority:" << (int)request.priority;
+            emit readCompleted(request.requestId, result);
+            resolveSingleFlight(request.requestId, result);
         }
         
-        completeCurrentRequest(true);
+        completeRequest(result.transactionId, true);
     } else {
         m_statistics.failedRequests++;
         
@@ -434,29 +528,36 @@ void ModbusWorker::onModbusReadCompleted(const ModbusReadResult& result)
             // Handle heartbeat failure
             handleHeartbeatResponse(false);
         } else {
-            // Normal read request failure
-            emit errorOccurred(m_deviceKey, result.errorString);
+            // The failed result carries the error; callers release the request on it
+            emit readCompleted(request.requestId, result);
         }
         
-        completeCurrentRequest(false, result.errorString);
+        completeRequest(result.transactionId, false, result.errorString);
+        if (result.errorType == QModbusDevice::TimeoutError) {
+            recoverFromRequestTimeout(result.errorString);
+        }
     }
 }
 
 void ModbusWorker::onModbusWriteCompleted(const ModbusWriteResult& result)
 {
-    if (!m_requestInProgress) {
+    if (!m_inFlightRequests.contains(result.transactionId)) {
         return; // Not our request
     }
+    const qint64 requestId = m_inFlightRequests.value(result.transactionId).requestId;
     
     m_statistics.totalRequests++;
     if (result.success) {
         m_statistics.successfulRequests++;
-        emit writeCompleted(m_currentRequest.requestId, result);
-        completeCurrentRequest(true);
+        emit writeCompleted(requestId, result);
+        completeRequest(result.transactionId, true);
     } else {
         m_statistics.failedRequests++;
-        emit errorOccurred(m_deviceKey, result.errorString);
-        completeCurrentRequest(false, result.errorString);
+        emit writeCompleted(requestId, result);
+        completeRequest(result.transactionId, false, result.errorString);
+        if (result.errorType == QModbusDevice::TimeoutError) {
+            recoverFromRequestTimeout(result.errorString);
+        }
     }
 }
 
@@ -467,9 +568,16 @@ void ModbusWorker::onModbusConnectionStateChanged(bool connected)
     m_statistics.isConnected = connected;
     
     if (!connected) {
+        // Requests outstanding on the dropped connection will never be answered
+        const QList<quint16> inFlight = m_inFlightRequests.keys();
+        for (quint16 transactionId : inFlight) {
+            interruptInFlightRequest(transactionId, "Connection lost");
+        }
+        
         // Clear queue on disconnection but maintain polling for reconnection attempts
         QMutexLocker locker(&m_queueMutex);
-        m_requestQueue.clear();
+        interruptQueuedRequests("Connection lost");
+        abortAllSingleFlights("Connection lost");
         qDebug() << "ModbusWorker - Device disconnected, clearing request queue but maintaining polling for:" << m_deviceKey;
         // Polling timer continues running to enable automatic reconnection attempts
         
@@ -496,17 +604,27 @@ void ModbusWorker::onModbusError(const QString& error)
     emitClassifiedError(error);
 }
 
-void ModbusWorker::completeCurrentRequest(bool success, const QString &error)
+void ModbusWorker::completeRequest(quint16 transactionId, bool success, const QString &error)
 {
-    Q_UNUSED(error); // Suppress unused parameter warning
+    const auto inFlight = m_inFlightRequests.constFind(transactionId);
+    if (inFlight == m_inFlightRequests.constEnd()) {
+        return;
+    }
     
-    // Stop request timeout timer
-    if (m_requestTimeoutTimer && m_requestTimeoutTimer->isActive()) {
-        m_requestTimeoutTimer->stop();
+    // Duplicates waiting on a read that produced no data are released with its error
+    if (!success) {
+        const QString reason = error.isEmpty() ? QString("Request failed") : error;
+        abortSingleFlight(inFlight.value().requestId, reason);
+        for (const auto &part : m_coalescedReads.value(transactionId)) {
+            abortSingleFlight(part.requestId, reason);
+        }
     }
     
-    m_currentRequest = PriorityModbusRequest();
-    m_requestInProgress = false;
+    m_inFlightRequests.erase(inFlight);
+    m_coalescedReads.remove(transactionId);
+    
+    // Re-arm the timeout for whatever is still outstanding
+    armRequestTimeout();
     
     // Update statistics
     updateStatistics(success);
@@ -554,48 +672,44 @@ void ModbusWorker::emitStatisticsUpdate()
 void ModbusWorker::processRequestQueue()
 {
     QMutexLocker locker(&m_queueMutex);
+    drainSubmissionQueue();
     
-    if (m_requestInProgress || m_requestQueue.isEmpty()) {
+    if (m_inFlightRequests.size() >= m_maxConcurrentRequests || m_requestQueue.isEmpty()) {
         return;
     }
     
-    // Check if batching is enabled and we have multiple requests
+    // Batching: take up to m_maxBatchSize queued requests in one pass so the reads of
+    // one poll cycle can share PDUs; whatever the window cannot take goes back
     if (m_batchingEnabled && m_requestQueue.size() > 1) {
-        // Get next request by priority
+        while (m_inFlightRequests.size() < m_maxConcurrentRequests && !m_requestQueue.isEmpty()) {
+            QList<PriorityModbusRequest> batch;
+            while (batch.size() < m_maxBatchSize && !m_requestQueue.isEmpty()) {
+                PriorityModbusRequest nextRequest = getNextRequest();
+                if (nextRequest.requestId == 0) {
+                    break; // Only expired polls were left
+                }
+                batch.append(nextRequest);
+            }
+            
+            if (batch.isEmpty() || !executeBatchedRequests(batch)) {
+                return;
+            }
+        }
+        return;
+    }
+    
+    // Standard processing: fill the concurrency window
+    while (m_inFlightRequests.size() < m_maxConcurrentRequests && !m_requestQueue.isEmpty()) {
         PriorityModbusRequest nextRequest = getNextRequest();
         if (nextRequest.requestId == 0) {
             return; // No valid request
         }
         
-        // Add to batch queue and start batch timer if not already running
-        m_batchQueue.enqueue(nextRequest);
-        
-        if (m_batchTimer && !m_batchTimer->isActive()) {
-            m_batchTimer->start(BATCH_TIMEOUT_MS);
-        }
-        
-        // If batch is full, process immediately
-        if (m_batchQueue.size() >= m_maxBatchSize) {
-            if (m_batchTimer && m_batchTimer->isActive()) {
-                m_batchTimer->stop();
-            }
-            processBatchQueue();
+        // Stop on a rejected request (already reported); the rest stays queued for the next poll cycle
+        if (!executeRequest(nextRequest)) {
+            return;
         }
-        
-        return;
     }
-    
-    // Standard single request processing
-    PriorityModbusRequest nextRequest = getNextRequest();
-    if (nextRequest.requestId == 0) {
-        return; // No valid request
-    }
-    
-    m_currentRequest = nextRequest;
-    m_requestInProgress = true;
-    
-    // Execute the request
-    executeRequest(nextRequest);
 }
 
 void ModbusWorker::onPollTimer()
@@ -666,27 +780,19 @@ void ModbusWorker::onPollTimer()
 
 PriorityModbusRequest ModbusWorker::getNextRequest()
 {
-    if (m_requestQueue.isEmpty()) {
-        return PriorityModbusRequest();
-    }
-    
-    return m_requestQueue.dequeue();
+    // Stale polls surface here and are shed instead of being executed
+    QList<PriorityModbusRequest> expired;
+    PriorityModbusRequest request = m_requestQueue.pop(QDateTime::currentMSecsSinceEpoch(), &expired);
+    reportExpiredRequests(expired);
+    return request;
 }
 
-void ModbusWorker::executeRequest(const PriorityModbusRequest &request)
+quint16 ModbusWorker::executeRequest(const PriorityModbusRequest &request)
 {
     if (!m_modbusManager) {
-        completeCurrentRequest(false, "ModbusManager not available");
-        return;
-    }
-    
-    // Start request timeout timer with configurable timeout
-    if (m_requestTimeoutTimer) {
-        int requestTimeout = 15000; // Default 15s for industrial environments
-        if (m_modbusManager) {
-            requestTimeout = m_modbusManager->getRequestTimeout();
-        }
-        m_requestTimeoutTimer->start(requestTimeout);
+        updateStatistics(false);
+        rejectRequest(request, "No Modbus manager");
+        return 0;
     }
     
     const ModbusRequest &req = request.request;
@@ -695,59 +801,110 @@ void ModbusWorker::executeRequest(const PriorityModbusRequest &request)
     qDebug() << "[ModbusWorker::executeRequest] Executing request with count:" << req.count 
              << "address:" << req.startAddress << "type:" << static_cast<int>(req.type);
     
+    // ModbusManager returns the transaction ID its result will carry (0 = rejected)
+    quint16 transactionId = 0;
     switch (req.type) {
         case ModbusRequest::ReadHoldingRegisters:
             if (req.count == 1) {
-                m_modbusManager->readHoldingRegister(req.startAddress, req.dataType, req.unitId);
+                transactionId = m_modbusManager->readHoldingRegister(req.startAddress, req.dataType, req.unitId);
             } else {
-                m_modbusManager->readHoldingRegisters(req.startAddress, req.count, req.dataType, req.unitId);
+                transactionId = m_modbusManager->readHoldingRegisters(req.startAddress, req.count, req.dataType, req.unitId);
             }
             break;
             
         case ModbusRequest::ReadInputRegisters:
             if (req.count == 1) {
-                m_modbusManager->readInputRegister(req.startAddress, req.dataType, req.unitId);
+                transactionId = m_modbusManager->readInputRegister(req.startAddress, req.dataType, req.unitId);
             } else {
-                m_modbusManager->readInputRegisters(req.startAddress, req.count, req.dataType, req.unitId);
+                transactionId = m_modbusManager->readInputRegisters(req.startAddress, req.count, req.dataType, req.unitId);
             }
             break;
             
         case ModbusRequest::ReadCoils:
             if (req.count == 1) {
-                m_modbusManager->readCoil(req.startAddress, req.unitId);
+                transactionId = m_modbusManager->readCoil(req.startAddress, req.unitId);
             } else {
-                m_modbusManager->readCoils(req.startAddress, req.count, req.unitId);
+                transactionId = m_modbusManager->readCoils(req.startAddress, req.count, req.unitId);
             }
             break;
             
         case ModbusRequest::ReadDiscreteInputs:
             if (req.count == 1) {
-                m_modbusManager->readDiscreteInput(req.startAddress, req.unitId);
+                transactionId = m_modbusManager->readDiscreteInput(req.startAddress, req.unitId);
             } else {
-                m_modbusManager->readDiscreteInputs(req.startAddress, req.count, req.unitId);
+                transactionId = m_modbusManager->readDiscreteInputs(req.startAddress, req.count, req.unitId);
             }
             break;
             
         case ModbusRequest::WriteHoldingRegisters:
             if (req.count == 1 && !req.writeData.isEmpty()) {
-                m_modbusManager->writeHoldingRegister(req.startAddress, req.writeData.first(), req.unitId);
+                transactionId = m_modbusManager->writeHoldingRegister(req.startAddress, req.writeData.first(), req.unitId);
             } else {
-                m_modbusManager->writeHoldingRegisters(req.startAddress, req.writeData, req.unitId);
+                transactionId = m_modbusManager->writeHoldingRegisters(req.startAddress, req.writeData, req.unitId);
             }
             break;
             
         case ModbusRequest::WriteCoils:
             if (req.count == 1 && !req.writeBoolData.isEmpty()) {
-                m_modbusManager->writeCoil(req.startAddress, req.writeBoolData.first(), req.unitId);
+                transactionId = m_modbusManager->writeCoil(req.startAddress, req.writeBoolData.first(), req.unitId);
             } else {
-                m_modbusManager->writeCoils(req.startAddress, req.writeBoolData, req.unitId);
+                transactionId = m_modbusManager->writeCoils(req.startAddress, req.writeBoolData, req.unitId);
             }
             break;
             
         default:
-            completeCurrentRequest(false, "Unknown request type");
-            return;
+            qWarning() << "ModbusWorker::executeRequest - Unknown request type for device:" << m_deviceKey;
+            break;
+    }
+    
+    if (transactionId == 0) {
+        updateStatistics(false);
+        updateConnectionHealth(false);
+        adjustAdaptivePollInterval(false);
+        rejectRequest(request, "Request rejected");
+        return 0;
+    }
+    
+    PriorityModbusRequest dispatched = request;
+    dispatched.dispatchTime = QDateTime::currentMSecsSinceEpoch();
+    m_inFlightRequests.insert(transactionId, dispatched);
+    m_singleFlights.markDispatched(request.requestId);
+    armRequestTimeout();
+    return transactionId;
+}
+
+void ModbusWorker::rejectRequest(const PriorityModbusRequest &request, const QString &reason)
+{
+    // Never sent: release its duplicates and let the issuer stop tracking it
+    abortSingleFlight(request.requestId, reason);
+    emit requestInterrupted(request.requestId, reason);
+}
+
+int ModbusWorker::requestTimeoutMs() const
+{
+    // Default 15s for industrial environments
+    return m_modbusManager ? m_modbusManager->getRequestTimeout() : 15000;
+}
+
+void ModbusWorker::armRequestTimeout()
+{
+    if (!m_requestTimeoutTimer) {
+        return;
+    }
+    
+    if (m_inFlightRequests.isEmpty()) {
+        m_requestTimeoutTimer->stop();
+        return;
+    }
+    
+    // Single timer armed for the oldest outstanding request
+    qint64 oldestDispatch = std::numeric_limits<qint64>::max();
+    for (auto it = m_inFlightRequests.constBegin(); it != m_inFlightRequests.constEnd(); ++it) {
+        oldestDispatch = qMin(oldestDispatch, it.value().dispatchTime);
     }
+    
+    const qint64 remaining = oldestDispatch + requestTimeoutMs() - QDateTime::currentMSecsSinceEpoch();
+    m_requestTimeoutTimer->start(static_cast<int>(qMax<qint64>(0, remaining)));
 }
 
 QString ModbusWorker::getDeviceKey() const
@@ -755,6 +912,34 @@ QString ModbusWorker::getDeviceKey() const
     return m_deviceKey;
 }
 
+void ModbusWorker::setSharedConnection(bool shared)
+{
+    m_sharedConnection = shared;
+    // Shared gateway connection: serve unit IDs round-robin within a priority so
+    // one busy unit cannot starve the others behind the gateway
+    m_requestQueue.setUnitFairness(shared);
+    m_deviceKey = shared ? QString("%1:%2").arg(m_host).arg(m_port)
+                         : QString("%1:%2:%3").arg(m_host).arg(m_port).arg(m_unitId);
+}
+
+void ModbusWorker::setMaxConcurrentRequests(int maxRequests)
+{
+    m_maxConcurrentRequests = qBound(1, maxRequests, 16);
+    
+    // The manager's in-flight window must be at least as wide as ours
+    if (m_modbusManager && m_modbusManager->getMaxInFlight() < m_maxConcurrentRequests) {
+        m_modbusManager->setMaxInFlight(m_maxConcurrentRequests);
+    }
+    
+    qDebug() << "ModbusWorker::setMaxConcurrentRequests - Device:" << m_deviceKey << "Limit:" << m_maxConcurrentRequests;
+    QMetaObject::invokeMethod(this, "processRequestQueue", Qt::QueuedConnection);
+}
+
+int ModbusWorker::getMaxConcurrentRequests() const
+{
+    return m_maxConcurrentRequests;
+}
+
 bool ModbusWorker::isConnected() const
 {
     return m_statistics.isConnected;
@@ -768,31 +953,16 @@ void ModbusWorker::resetStatistics()
 
 qint64 ModbusWorker::queueReadRequest(const ModbusRequest &request, RequestPriority priority)
 {
-    QMutexLocker locker(&m_queueMutex);
-    
-    qint64 requestId = m_nextRequestId.fetchAndAddOrdered(1);
-    
-    PriorityModbusRequest priorityRequest;
-    priorityRequest.request = request;
-    priorityRequest.priority = priority;
-    priorityRequest.requestId = requestId;
-    priorityRequest.queueTime = QDateTime::currentMSecsSinceEpoch();
-    priorityRequest.interruptible = false; // Read requests are not interruptible
-    
-    insertRequestByPriority(priorityRequest);
-    
-    // Process queue if not currently processing
-    if (!m_requestInProgress) {
-        QMetaObject::invokeMethod(this, "processRequestQueue", Qt::QueuedConnection);
-    }
-    
-    return requestId;
+    return submitRequest(request, priority, false); // Read requests are not interruptible
 }
 
 qint64 ModbusWorker::queueWriteRequest(const ModbusRequest &request, RequestPriority priority, bool interruptible)
 {
-    QMutexLocker locker(&m_queueMutex);
-    
+    return submitRequest(request, priority, interruptible);
+}
+
+qint64 ModbusWorker::submitRequest(const ModbusRequest &request, RequestPriority priority, bool interruptible)
+{
     qint64 requestId = m_nextRequestId.fetchAndAddOrdered(1);
     
     PriorityModbusRequest priorityRequest;
@@ -802,16 +972,38 @@ qint64 ModbusWorker::queueWriteRequest(const ModbusRequest &request, RequestPrio
     priorityRequest.queueTime = QDateTime::currentMSecsSinceEpoch();
     priorityRequest.interruptible = interruptible;
     
-    insertRequestByPriority(priorityRequest);
+    // Never wait on a worker that is busy decoding or timing out; a full
+    // submission queue means the worker is far behind, so refuse the request
+    if (!m_submissionQueue.tryPush(priorityRequest)) {
+        {
+            QMutexLocker statsLocker(&m_statsMutex);
+            m_statistics.rejectedRequests++;
+        }
+        qWarning() << "ModbusWorker - Submission queue full, rejecting request" << requestId << "for device:" << m_deviceKey;
+        emit requestInterrupted(requestId, "Submission queue full");
+        return requestId;
+    }
     
-    // Process queue if not currently processing
-    if (!m_requestInProgress) {
+    // One pending drain is enough; it picks up everything submitted before it runs
+    if (m_drainScheduled.testAndSetOrdered(0, 1)) {
         QMetaObject::invokeMethod(this, "processRequestQueue", Qt::QueuedConnection);
     }
     
     return requestId;
 }
 
+void ModbusWorker::drainSubmissionQueue()
+{
+    // Caller holds m_queueMutex, which makes this the single consumer.
+    // Clear the flag first so a submission racing with the drain schedules another one.
+    m_drainScheduled.storeRelease(0);
+    
+    PriorityModbusRequest request;
+    while (m_submissionQueue.tryPop(request)) {
+        insertRequestByPriority(request);
+    }
+}
+
 void ModbusWorker::startWorker()
 {
     qDebug() << "ModbusWorker::startWorker() - Starting worker for device:" << m_deviceKey;
@@ -832,9 +1024,6 @@ void ModbusWorker::startWorker()
         // This ensures the client is ready before any connection attempts
         m_modbusManager->initializeClient();
         
-        // Add a small delay to ensure initialization is complete
-        QThread::msleep(100);
-        
         // Verify initialization was successful
         if (!m_modbusManager->isClientInitialized()) {
             qCritical() << "ModbusWorker::startWorker() - Failed to initialize ModbusManager client for device:" << m_deviceKey;
@@ -853,6 +1042,10 @@ void ModbusWorker::startWorker()
                 this, &ModbusWorker::onModbusConnectionStateChanged);
         connect(m_modbusManager, &ModbusManager::errorOccurred,
                 this, &ModbusWorker::onModbusError);
+        
+        if (m_modbusManager->getMaxInFlight() < m_maxConcurrentRequests) {
+            m_modbusManager->setMaxInFlight(m_maxConcurrentRequests);
+        }
     }
     
     // Connect to device
@@ -897,8 +1090,8 @@ void ModbusWorker::stopWorker()
         qDebug() << "ModbusWorker::stopWorker() - Stopped request timeout timer for device:" << m_deviceKey;
     }
     
-    // Clear request queue and interrupt current request if any
-    if (m_requestInProgress) {
+    // Clear request queue and interrupt in-flight requests if any
+    if (!m_inFlightRequests.isEmpty()) {
         interruptCurrentRequest("Worker stopping");
     }
     clearRequestQueue();
@@ -972,45 +1165,65 @@ void ModbusWorker::handleConnectionFailure(const QString& errorMessage)
 
 void ModbusWorker::interruptCurrentRequest(const QString &reason)
 {
-    if (!m_requestInProgress) {
+    if (m_inFlightRequests.isEmpty()) {
         return;
     }
     
-    // Only interrupt if the current request is interruptible
-    if (m_currentRequest.interruptible) {
-        // Cancel the current request
-        completeCurrentRequest(false, reason.isEmpty() ? "Request interrupted" : reason);
-        
-        // Emit interruption signal
-        emit requestInterrupted(m_currentRequest.requestId, reason);
+    // Only interrupt in-flight requests that are interruptible
+    const QList<quint16> inFlight = m_inFlightRequests.keys();
+    for (quint16 transactionId : inFlight) {
+        const PriorityModbusRequest request = m_inFlightRequests.value(transactionId);
+        if (!request.interruptible) {
+            continue;
+        }
         
-        // Process next request in queue
-        QMetaObject::invokeMethod(this, "processRequestQueue", Qt::QueuedConnection);
+        // Cancel the request; a late response is ignored as unknown
+        interruptInFlightRequest(transactionId, reason.isEmpty() ? "Request interrupted" : reason);
     }
 }
 
 void ModbusWorker::clearRequestQueue()
 {
     QMutexLocker locker(&m_queueMutex);
+    interruptQueuedRequests("Queue cleared");
+}
+
+void ModbusWorker::interruptQueuedRequests(const QString &reason)
+{
+    // Caller holds m_queueMutex
+    drainSubmissionQueue();
     
-    // Emit interruption signals for all queued requests
-    while (!m_requestQueue.isEmpty()) {
-        PriorityModbusRequest request = m_requestQueue.dequeue();
-        emit requestInterrupted(request.requestId, "Queue cleared");
+    const QList<PriorityModbusRequest> queued = m_requestQueue.takeAll();
+    for (const PriorityModbusRequest &request : queued) {
+        abortSingleFlight(request.requestId, reason);
+        emit requestInterrupted(request.requestId, reason);
     }
 }
 
-bool ModbusWorker::hasHigherPriorityRequest(RequestPriority currentPriority) const
+void ModbusWorker::interruptInFlightRequest(quint16 transactionId, const QString &reason)
 {
-    QMutexLocker locker(&m_queueMutex);
+    const auto inFlight = m_inFlightRequests.constFind(transactionId);
+    if (inFlight == m_inFlightRequests.constEnd()) {
+        return;
+    }
     
-    for (const auto &request : m_requestQueue) {
-        if (request.priority > currentPriority) {
-            return true;
+    // No result will arrive: every request the PDU carries is interrupted under its own ID
+    const QList<PriorityModbusRequest> parts = m_coalescedReads.value(transactionId);
+    if (!parts.isEmpty()) {
+        for (const PriorityModbusRequest &part : parts) {
+            emit requestInterrupted(part.requestId, reason);
         }
+    } else if (!isHeartbeatRequest(inFlight.value())) {
+        emit requestInterrupted(inFlight.value().requestId, reason);
     }
     
-    return false;
+    completeRequest(transactionId, false, reason);
+}
+
+bool ModbusWorker::hasHigherPriorityRequest(RequestPriority currentPriority) const
+{
+    QMutexLocker locker(&m_queueMutex);
+    return m_requestQueue.hasPriorityAbove(currentPriority);
 }
 
 void ModbusWorker::generateAutomaticPollingRequests()
@@ -1027,15 +1240,14 @@ void ModbusWorker::generateAutomaticPollingRequests()
     
     qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
     
-    // Process each data point for polling
-    for (const auto &point : m_dataPoints) {
-        if (!point.enabled) {
+    // Only the points whose poll is due come off the wheel
+    const QVector<int> duePoints = m_pollWheel.advance(currentTime);
+    for (int index : duePoints) {
+        if (index < 0 || index >= m_dataPoints.size()) {
             continue;
         }
-        
-        // Check if it's time to poll this data point
-        qint64 lastPollTime = m_lastPollTimes.value(point.name, 0);
-        if (currentTime - lastPollTime < point.pollInterval) {
+        const DataAcquisitionPoint &point = m_dataPoints.at(index);
+        if (!point.enabled) {
             continue;
         }
         
@@ -1046,6 +1258,9 @@ void ModbusWorker::generateAutomaticPollingRequests()
         request.unitId = point.unitId;
         request.dataType = point.dataType;
         
+        // Data from this poll is stale once the next one is due
+        request.deadline = currentTime + point.pollInterval;
+        
         // Check if this is an optimized block read
         bool isBlockRead = point.tags.contains("block_type") && point.tags["block_type"] == "optimized_read";
         
@@ -1114,8 +1329,9 @@ void ModbusWorker::generateAutomaticPollingRequests()
         // Queue the request with normal priority
         qint64 requestId = queueReadRequest(request, RequestPriority::Normal);
         
-        // Update last poll time
-        m_lastPollTimes[point.name] = currentTime;
+        // Schedule the next poll
+        m_nextPollTimes[index] = currentTime + point.pollInterval;
+        m_pollWheel.schedule(index, m_nextPollTimes[index]);
         
         qDebug() << "ModbusWorker::generateAutomaticPollingRequests() - Queued polling request for data point:" 
                  << point.name << "address:" << point.address << "requestId:" << requestId;
@@ -1158,90 +1374,165 @@ void ModbusWorker::adjustAdaptivePollInterval(bool success)
     }
 }
 
-void ModbusWorker::onBatchTimeout()
+bool ModbusWorker::executeBatchedRequests(const QList<PriorityModbusRequest> &batch)
 {
-    // Process any pending batched requests when timeout occurs
-    if (!m_batchQueue.isEmpty()) {
-        processBatchQueue();
+    if (batch.isEmpty()) {
+        return true;
     }
-}
-
-void ModbusWorker::processBatchQueue()
-{
-    if (m_batchQueue.isEmpty()) {
-        return;
+    
+    qDebug() << "ModbusWorker::executeBatchedRequests - Processing batch of" << batch.size() << "requests for device:" << m_deviceKey;
+    
+    // One entry per PDU. Writes and heartbeats go out unchanged; reads are candidates for coalescing
+    QList<QList<PriorityModbusRequest>> dispatches;
+    QList<PriorityModbusRequest> reads;
+    for (const auto &request : batch) {
+        if (isReadRequest(request.request) && !isHeartbeatRequest(request)) {
+            reads.append(request);
+        } else {
+            dispatches.append(QList<PriorityModbusRequest>{request});
+        }
     }
     
-    QList<PriorityModbusRequest> batch;
+    // Sort so neighbouring ranges of the same table and unit are adjacent
+    std::stable_sort(reads.begin(), reads.end(), [](const PriorityModbusRequest &a, const PriorityModbusRequest &b) {
+        if (a.request.type != b.request.type) {
+            return a.request.type < b.request.type;
+        }
+        if (a.request.unitId != b.request.unitId) {
+            return a.request.unitId < b.request.unitId;
+        }
+        return a.request.startAddress < b.request.startAddress;
+    });
     
-    // Collect requests for batching (up to maxBatchSize)
-    while (!m_batchQueue.isEmpty() && batch.size() < m_maxBatchSize) {
-        PriorityModbusRequest request = m_batchQueue.dequeue();
-        
-        // Check if this request can be batched with existing ones
-        bool canBatch = batch.isEmpty();
-        if (!canBatch && !batch.isEmpty()) {
-            canBatch = canBatchRequests(batch.first(), request);
+    // Grow spans while the next read is close enough and the PDU limit allows it
+    QList<PriorityModbusRequest> span;
+    int spanEnd = 0;
+    for (const auto &request : reads) {
+        const ModbusRequest &req = request.request;
+        if (!span.isEmpty()) {
+            const ModbusRequest &first = span.first().request;
+            const bool bitTable = (first.type == ModbusRequest::ReadCoils ||
+                                   first.type == ModbusRequest::ReadDiscreteInputs);
+            const int maxCount = bitTable ? ModbusManager::MAX_READ_BITS : ModbusManager::MAX_READ_REGISTERS;
+            const int end = qMax(spanEnd, req.startAddress + req.count);
+            
+            if (req.type == first.type && req.unitId == first.unitId &&
+                req.startAddress <= spanEnd + COALESCE_MAX_GAP &&
+                end - first.startAddress <= maxCount) {
+                span.append(request);
+                spanEnd = end;
+                continue;
+            }
+            
+            dispatches.append(span);
+            span.clear();
         }
         
-        if (canBatch) {
-            batch.append(request);
-        } else {
-            // Can't batch this request, put it back and process current batch
-            m_batchQueue.prepend(request);
-            break;
-        }
+        span.append(request);
+        spanEnd = req.startAddress + req.count;
     }
     
-    if (!batch.isEmpty()) {
-        executeBatchedRequests(batch);
+    if (!span.isEmpty()) {
+        dispatches.append(span);
     }
     
-    // If there are still requests in batch queue, schedule another processing
-    if (!m_batchQueue.isEmpty()) {
-        QTimer::singleShot(10, this, &ModbusWorker::processBatchQueue);
+    // Each PDU takes a slot in the concurrency window; the rest waits in the scheduler
+    for (int i = 0; i < dispatches.size(); ++i) {
+        if (m_inFlightRequests.size() >= m_maxConcurrentRequests) {
+            for (int j = i; j < dispatches.size(); ++j) {
+                for (const auto &request : dispatches.at(j)) {
+                    m_requestQueue.push(request);
+                }
+            }
+            return false;
+        }
+        dispatchCoalescedRead(dispatches.at(i));
     }
+    return true;
 }
 
-void ModbusWorker::executeBatchedRequests(const QList<PriorityModbusRequest> &batch)
+void ModbusWorker::dispatchCoalescedRead(const QList<PriorityModbusRequest> &span)
 {
-    if (batch.isEmpty()) {
+    if (span.size() == 1) {
+        executeRequest(span.first());
         return;
     }
     
-    qDebug() << "ModbusWorker::executeBatchedRequests - Processing batch of" << batch.size() << "requests for device:" << m_deviceKey;
+    // One raw read covering the whole span; each original request is decoded from its slice
+    PriorityModbusRequest merged = span.first();
+    int spanEnd = merged.request.startAddress + merged.request.count;
+    merged.interruptible = false;
+    for (const auto &part : span) {
+        spanEnd = qMax(spanEnd, part.request.startAddress + part.request.count);
+        if (part.priority > merged.priority) {
+            merged.priority = part.priority;
+        }
+    }
+    merged.request.count = spanEnd - merged.request.startAddress;
     
-    // For now, execute requests sequentially
-    // Future optimization: combine consecutive register reads into single requests
-    for (const auto &request : batch) {
-        executeRequest(request);
+    switch (merged.request.type) {
+        case ModbusRequest::ReadInputRegisters:
+            merged.request.dataType = ModbusDataType::InputRegister;
+            break;
+        case ModbusRequest::ReadCoils:
+            merged.request.dataType = ModbusDataType::Coil;
+            break;
+        case ModbusRequest::ReadDiscreteInputs:
+            merged.request.dataType = ModbusDataType::DiscreteInput;
+            break;
+        default:
+            merged.request.dataType = ModbusDataType::HoldingRegister;
+            break;
+    }
+    
+    const quint16 transactionId = executeRequest(merged);
+    if (transactionId == 0) {
+        // executeRequest() reported the merged read under the first part's ID
+        for (const auto &part : span) {
+            if (part.requestId != merged.requestId) {
+                rejectRequest(part, "Request rejected");
+            }
+        }
+    } else {
+        // Every original read is on the wire as part of the merged one
+        for (const auto &part : span) {
+            m_singleFlights.markDispatched(part.requestId);
+        }
+        m_coalescedReads.insert(transactionId, span);
+        qDebug() << "ModbusWorker::dispatchCoalescedRead - Coalesced" << span.size() << "reads into"
+                 << merged.request.count << "addresses from" << merged.request.startAddress
+                 << "for device:" << m_deviceKey;
     }
 }
 
-bool ModbusWorker::canBatchRequests(const PriorityModbusRequest &req1, const PriorityModbusRequest &req2) const
+void ModbusWorker::completeCoalescedRead(const ModbusReadResult &result)
 {
-    // Only batch requests of the same type and similar priority
-    if (req1.request.type != req2.request.type) {
-        return false;
-    }
+    const QList<PriorityModbusRequest> parts = m_coalescedReads.take(result.transactionId);
     
-    // Don't batch high priority requests with lower priority ones
-    if (req1.priority == RequestPriority::High || req2.priority == RequestPriority::High) {
-        return req1.priority == req2.priority;
+    // Answer every original request under its own ID from its slice of the merged read,
+    // failed or not, so each caller can release what it tracks for that request
+    for (const auto &part : parts) {
+        m_statistics.totalRequests++;
+        ModbusReadResult partResult = m_modbusManager->sliceReadResult(result, part.request.startAddress,
+                                                                       part.request.count, part.request.dataType);
+        emit readCompleted(part.requestId, partResult);
+        if (partResult.success) {
+            m_statistics.successfulRequests++;
+            resolveSingleFlight(part.requestId, partResult);
+        } else {
+            m_statistics.failedRequests++;
+            abortSingleFlight(part.requestId, partResult.errorString);
+        }
     }
     
-    // For read requests, check if they are for consecutive registers
-    if (req1.request.type == ModbusRequest::ReadHoldingRegisters ||
-        req1.request.type == ModbusRequest::ReadInputRegisters) {
-        
-        int addr1End = req1.request.startAddress + req1.request.count;
-        int addr2Start = req2.request.startAddress;
-        
-        // Allow batching if registers are consecutive or overlapping
-        return (addr2Start <= addr1End + 5);  // Allow small gaps
+    if (result.success) {
+        completeRequest(result.transactionId, true);
+    } else {
+        completeRequest(result.transactionId, false, result.errorString);
+        if (result.errorType == QModbusDevice::TimeoutError) {
+            recoverFromRequestTimeout(result.errorString);
+        }
     }
-    
-    return true;  // Allow batching for other request types
 }
 
 void ModbusWorker::onHealthCheckTimer()
@@ -1334,32 +1625,52 @@ void ModbusWorker::onRequestTimeout()
 {
     qDebug() << "ModbusWorker::onRequestTimeout() - Request timeout for device:" << m_deviceKey;
     
-    if (m_requestInProgress) {
-        QString timeoutReason = QString("Request timeout after %1ms").arg(m_requestTimeoutTimer ? m_requestTimeoutTimer->interval() : 5000);
-        completeCurrentRequest(false, timeoutReason);
-        
-        // Update health monitoring for timeout
-        if (m_healthMonitoringEnabled) {
-            updateConnectionHealth(false);
+    // Expire only the requests that have been outstanding for the full timeout
+    const int requestTimeout = requestTimeoutMs();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QList<quint16> expired;
+    for (auto it = m_inFlightRequests.constBegin(); it != m_inFlightRequests.constEnd(); ++it) {
+        if (now - it.value().dispatchTime >= requestTimeout) {
+            expired.append(it.key());
         }
+    }
+    
+    if (expired.isEmpty()) {
+        armRequestTimeout();
+        return;
+    }
+    
+    const QString timeoutReason = QString("Request timeout after %1ms").arg(requestTimeout);
+    for (quint16 transactionId : expired) {
+        interruptInFlightRequest(transactionId, timeoutReason);
+    }
+    
+    recoverFromRequestTimeout(timeoutReason);
+}
+
+void ModbusWorker::recoverFromRequestTimeout(const QString &timeoutReason)
+{
+    // Update health monitoring for timeout
+    if (m_healthMonitoringEnabled) {
+        updateConnectionHealth(false);
+    }
+    
+    // Emit classified error for request timeout
+    emitClassifiedError(timeoutReason);
+    
+    // Enhanced timeout recovery: disconnect and reconnect if connection appears stale
+    if (m_statistics.isConnected && m_workerRunning && !m_stopRequested) {
+        qDebug() << "ModbusWorker::recoverFromRequestTimeout() - Initiating connection recovery for device:" << m_deviceKey;
+        disconnectFromDevice();
         
-        // Emit classified error for request timeout
-        emitClassifiedError(timeoutReason);
-        
-        // Enhanced timeout recovery: disconnect and reconnect if connection appears stale
-        if (m_statistics.isConnected && m_workerRunning && !m_stopRequested) {
-            qDebug() << "ModbusWorker::onRequestTimeout() - Initiating connection recovery for device:" << m_deviceKey;
-            disconnectFromDevice();
-            
-            // Schedule reconnection with progressive delay based on consecutive failures
-            int recoveryDelay = qMin(1000 + (m_consecutiveFailures * 500), 5000); // 1s to 5s max
-            QTimer::singleShot(recoveryDelay, this, [this]() {
-                if (m_workerRunning && !m_stopRequested && !m_statistics.isConnected) {
-                    qDebug() << "ModbusWorker::onRequestTimeout() - Executing recovery reconnection for device:" << m_deviceKey;
-                    connectToDevice();
-                }
-            });
-        }
+        // Schedule reconnection with progressive delay based on consecutive failures
+        int recoveryDelay = qMin(1000 + (m_consecutiveFailures * 500), 5000); // 1s to 5s max
+        QTimer::singleShot(recoveryDelay, this, [this]() {
+            if (m_workerRunning && !m_stopRequested && !m_statistics.isConnected) {
+                qDebug() << "ModbusWorker::recoverFromRequestTimeout() - Executing recovery reconnection for device:" << m_deviceKey;
+                connectToDevice();
+            }
+        });
     }
 }
 
@@ -1518,7 +1829,9 @@ void ModbusWorker::setDataPointCount(int count)
     QMutexLocker locker(&m_dataPointsMutex);
     m_dataPoints.clear();
     m_dataPoints.reserve(count);
-    m_lastPollTimes.clear();
+    m_nextPollTimes.clear();
+    m_nextPollTimes.reserve(count);
+    m_pollWheel.clear();
     
     qDebug() << "ModbusWorker::setDataPointCount() - Reserved space for" << count << "data points for worker" << m_deviceKey;
 }
@@ -1548,6 +1861,11 @@ void ModbusWorker::addDataPointByName(const QString &name, const QString &host,
     // Check if point already exists
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         if (m_dataPoints[i].name == name) {
+            // A point enabled by the update polls right away; otherwise its schedule stands
+            if (dataPoint.enabled && !m_pollWheel.isScheduled(i)) {
+                m_nextPollTimes[i] = 0;
+                m_pollWheel.schedule(i, 0);
+            }
             m_dataPoints[i] = dataPoint;
             qDebug() << "ModbusWorker::addDataPointByName() - Updated existing data point:" << name << "for worker" << m_deviceKey;
             return;
@@ -1555,7 +1873,10 @@ void ModbusWorker::addDataPointByName(const QString &name, const QString &host,
     }
     
     m_dataPoints.append(dataPoint);
-    m_lastPollTimes[name] = 0;
+    m_nextPollTimes.append(0);
+    if (enabled) {
+        m_pollWheel.schedule(m_dataPoints.size() - 1, 0);
+    }
     qDebug() << "ModbusWorker::addDataPointByName() - Added new data point:" << name << "for worker" << m_deviceKey;
 }
 
@@ -1566,13 +1887,25 @@ void ModbusWorker::removeDataPoint(const QString &pointName)
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         if (m_dataPoints[i].name == pointName) {
             m_dataPoints.removeAt(i);
-            m_lastPollTimes.remove(pointName);
+            m_nextPollTimes.removeAt(i);
+            rebuildPollWheel();
             qDebug() << "ModbusWorker::removeDataPoint() - Removed data point:" << pointName << "from worker" << m_deviceKey;
             return;
         }
     }
 }
 
+void ModbusWorker::rebuildPollWheel()
+{
+    // Caller holds m_dataPointsMutex
+    m_pollWheel.clear();
+    for (int i = 0; i < m_dataPoints.size(); ++i) {
+        if (m_dataPoints.at(i).enabled) {
+            m_pollWheel.schedule(i, m_nextPollTimes.at(i));
+        }
+    }
+}
+
 QVector<DataAcquisitionPoint> ModbusWorker::getDataPoints() const
 {
     QMutexLocker locker(&m_dataPointsMutex);
@@ -1583,7 +1916,8 @@ void ModbusWorker::clearDataPoints()
 {
     QMutexLocker locker(&m_dataPointsMutex);
     m_dataPoints.clear();
-    m_lastPollTimes.clear();
+    m_nextPollTimes.clear();
+    m_pollWheel.clear();
     qDebug() << "ModbusWorker::clearDataPoints() - Cleared all data points for worker" << m_deviceKey;
 }
 
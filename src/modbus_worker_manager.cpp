@@ -7,6 +7,13 @@
 #include <QDateTime>
 #include <limits>
 
+namespace {
+
+const int IO_LOOP_PROBE_INTERVAL_MS = 1000;
+const double IO_LOOP_HOT_LAG_MS = 20.0;   // Smoothed dispatch lag at which a loop counts as hot
+
+} // namespace
+
 // ModbusWorkerManager Implementation
 ModbusWorkerManager::ModbusWorkerManager(QObject *parent)
     : QObject(parent)
@@ -14,6 +21,11 @@ ModbusWorkerManager::ModbusWorkerManager(QObject *parent)
     , m_statsUpdateTimer(nullptr)
     , m_loadBalancingEnabled(true)
     , m_loadBalancingTimer(nullptr)
+    , m_gatewayModeEnabled(false)
+    , m_gatewayConcurrencyLimit(1)
+    , m_shardingEnabled(false)
+    , m_ioLoopCount(0)
+    , m_ioLoopProbeTimer(nullptr)
 {
     // Initialize global statistics
     m_globalStats.activeWorkers = 0;
@@ -34,6 +46,11 @@ ModbusWorkerManager::ModbusWorkerManager(QObject *parent)
     m_loadBalancingTimer = new QTimer(this);
     connect(m_loadBalancingTimer, &QTimer::timeout, this, &ModbusWorkerManager::distributeLoad);
     m_loadBalancingTimer->start(10000); // Rebalance every 10 seconds
+    
+    // I/O loop lag probes run only while sharded loops exist
+    m_ioLoopProbeTimer = new QTimer(this);
+    connect(m_ioLoopProbeTimer, &QTimer::timeout, this, &ModbusWorkerManager::probeIoLoops);
+    m_ioLoopClock.start();
 }
 
 ModbusWorkerManager::~ModbusWorkerManager()
@@ -61,14 +78,24 @@ ModbusWorker* ModbusWorkerManager::getOrCreateWorker(const QString& host, int po
         
         // Create new worker but defer initialization until delayed startup
         worker = new ModbusWorker(host, port, unitId);
-        
-        QThread* thread = new QThread(this);
+        if (m_gatewayModeEnabled) {
+            worker->setSharedConnection(true);
+        }
         
         WorkerInfo info;
         info.worker = worker;
-        info.thread = thread;
+        info.requestsAtRebalance = 0;
         info.isConnected = false;
         
+        if (m_shardingEnabled) {
+            // Shared I/O loop; handleDelayedStartup() moves the worker there
+            info.loopIndex = loopForDevice(deviceKey);
+            info.thread = m_ioLoops.at(info.loopIndex);
+        } else {
+            info.loopIndex = -1;
+            info.thread = new QThread(this);
+        }
+        
         // Store worker info but don't initialize yet
         m_workers[deviceKey] = info;
         
@@ -119,15 +146,22 @@ void ModbusWorkerManager::removeWorker(const QString& deviceKey)
     
     WorkerInfo& info = m_workers[deviceKey];
     
-    // Stop the worker thread
-    info.thread->quit();
-    info.thread->wait();
-    
-    // Clean up
-    info.worker->deleteLater();
-    info.thread->deleteLater();
+    if (info.loopIndex >= 0) {
+        // Shared I/O loop keeps running; the worker stops and is deleted in it
+        QMetaObject::invokeMethod(info.worker, "stopWorker", Qt::QueuedConnection);
+        info.worker->deleteLater();
+    } else {
+        // Stop the worker thread
+        info.thread->quit();
+        info.thread->wait();
+        
+        // Clean up
+        info.worker->deleteLater();
+        info.thread->deleteLater();
+    }
     
     m_workers.remove(deviceKey);
+    m_loopOverrides.remove(deviceKey);
     
     emit workerRemoved(deviceKey);
 }
@@ -139,18 +173,26 @@ void ModbusWorkerManager::removeAllWorkers()
     for (auto it = m_workers.begin(); it != m_workers.end(); ++it) {
         WorkerInfo& info = it.value();
         
-        // Stop the worker thread
-        info.thread->quit();
-        info.thread->wait();
-        
-        // Clean up
-        info.worker->deleteLater();
-        info.thread->deleteLater();
+        if (info.loopIndex >= 0) {
+            // Deleted when its loop finishes below
+            QMetaObject::invokeMethod(info.worker, "stopWorker", Qt::QueuedConnection);
+            info.worker->deleteLater();
+        } else {
+            // Stop the worker thread
+            info.thread->quit();
+            info.thread->wait();
+            
+            // Clean up
+            info.worker->deleteLater();
+            info.thread->deleteLater();
+        }
         
         emit workerRemoved(it.key());
     }
     
     m_workers.clear();
+    m_loopOverrides.clear();
+    stopIoLoops();
     emit globalStatisticsUpdated(m_globalStats);
 }
 
@@ -209,9 +251,199 @@ void ModbusWorkerManager::updateGlobalStatistics()
 
 QString ModbusWorkerManager::createDeviceKey(const QString& host, int port, int unitId) const
 {
+    // Gateway mode keys workers by host:port so all unit IDs share one connection
+    if (m_gatewayModeEnabled) {
+        return QString("%1:%2").arg(host).arg(port);
+    }
     return QString("%1:%2:%3").arg(host).arg(port).arg(unitId);
 }
 
+QString ModbusWorkerManager::deviceKeyFor(const QString &host, int port, int unitId) const
+{
+    return createDeviceKey(host, port, unitId);
+}
+
+void ModbusWorkerManager::setGatewayModeEnabled(bool enabled)
+{
+    m_gatewayModeEnabled = enabled;
+    qDebug() << "ModbusWorkerManager gateway connection sharing" << (enabled ? "enabled" : "disabled");
+}
+
+bool ModbusWorkerManager::isGatewayModeEnabled() const
+{
+    return m_gatewayModeEnabled;
+}
+
+void ModbusWorkerManager::setGatewayConcurrencyLimit(int maxRequests)
+{
+    m_gatewayConcurrencyLimit = qBound(1, maxRequests, 16);
+}
+
+int ModbusWorkerManager::getGatewayConcurrencyLimit() const
+{
+    return m_gatewayConcurrencyLimit;
+}
+
+void ModbusWorkerManager::setEventLoopSharding(bool enabled, int loopCount)
+{
+    QMutexLocker locker(&m_workersMutex);
+    m_shardingEnabled = enabled;
+    m_ioLoopCount = qMax(0, loopCount);
+    qDebug() << "ModbusWorkerManager event-loop sharding" << (enabled ? "enabled" : "disabled")
+             << "loops:" << (m_ioLoopCount > 0 ? m_ioLoopCount : QThread::idealThreadCount());
+}
+
+bool ModbusWorkerManager::isEventLoopSharding() const
+{
+    QMutexLocker locker(&m_workersMutex);
+    return m_shardingEnabled;
+}
+
+int ModbusWorkerManager::getIoLoopCount() const
+{
+    QMutexLocker locker(&m_workersMutex);
+    return m_ioLoops.size();
+}
+
+QVector<double> ModbusWorkerManager::getIoLoopLags() const
+{
+    QMutexLocker locker(&m_workersMutex);
+    return m_ioLoopLags;
+}
+
+int ModbusWorkerManager::loopForDevice(const QString &deviceKey)
+{
+    if (m_ioLoops.isEmpty()) {
+        startIoLoops();
+    }
+    
+    const int overridden = m_loopOverrides.value(deviceKey, -1);
+    return overridden >= 0 ? overridden : m_loopRing.nodeFor(deviceKey);
+}
+
+void ModbusWorkerManager::startIoLoops()
+{
+    const int count = m_ioLoopCount > 0 ? m_ioLoopCount : qMax(1, QThread::idealThreadCount());
+    
+    for (int loop = 0; loop < count; ++loop) {
+        QThread* thread = new QThread(this);
+        thread->setObjectName(QString("ModbusIoLoop-%1").arg(loop));
+        thread->start();
+        
+        QObject* probe = new QObject();
+        probe->moveToThread(thread);
+        
+        m_ioLoops.append(thread);
+        m_ioLoopProbes.append(probe);
+        m_ioLoopLags.append(0.0);
+        m_loopRing.addNode(loop);
+    }
+    
+    m_ioLoopProbeTimer->start(IO_LOOP_PROBE_INTERVAL_MS);
+    qDebug() << "ModbusWorkerManager started" << count << "shared I/O loops";
+}
+
+void ModbusWorkerManager::stopIoLoops()
+{
+    if (m_ioLoops.isEmpty()) {
+        return;
+    }
+    
+    m_ioLoopProbeTimer->stop();
+    for (int loop = 0; loop < m_ioLoops.size(); ++loop) {
+        // Deferred deletes posted to the loop (probe, workers) run as the thread finishes
+        m_ioLoopProbes[loop]->deleteLater();
+        m_ioLoops[loop]->quit();
+        m_ioLoops[loop]->wait();
+        m_ioLoops[loop]->deleteLater();
+    }
+    
+    m_ioLoops.clear();
+    m_ioLoopProbes.clear();
+    m_ioLoopLags.clear();
+    m_loopRing.clear();
+}
+
+void ModbusWorkerManager::probeIoLoops()
+{
+    QMutexLocker locker(&m_workersMutex);
+    
+    // Time from posting an event to each loop until it runs there
+    for (int loop = 0; loop < m_ioLoopProbes.size(); ++loop) {
+        const qint64 posted = m_ioLoopClock.elapsed();
+        QMetaObject::invokeMethod(m_ioLoopProbes[loop], [this, loop, posted]() {
+            const qint64 lag = m_ioLoopClock.elapsed() - posted;
+            QMetaObject::invokeMethod(this, [this, loop, lag]() { onIoLoopProbed(loop, lag); }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void ModbusWorkerManager::onIoLoopProbed(int loop, qint64 lagMs)
+{
+    QMutexLocker locker(&m_workersMutex);
+    if (loop < m_ioLoopLags.size()) {
+        m_ioLoopLags[loop] = 0.7 * m_ioLoopLags[loop] + 0.3 * lagMs;
+    }
+}
+
+void ModbusWorkerManager::rebalanceIoLoops()
+{
+    QMutexLocker locker(&m_workersMutex);
+    if (m_ioLoops.size() <= 1) {
+        return;
+    }
+    
+    int hottest = 0;
+    int coolest = 0;
+    for (int loop = 1; loop < m_ioLoopLags.size(); ++loop) {
+        if (m_ioLoopLags[loop] > m_ioLoopLags[hottest]) {
+            hottest = loop;
+        }
+        if (m_ioLoopLags[loop] < m_ioLoopLags[coolest]) {
+            coolest = loop;
+        }
+    }
+    
+    // Only a clearly hot loop sheds work, one device per cycle
+    if (m_ioLoopLags[hottest] < IO_LOOP_HOT_LAG_MS || m_ioLoopLags[hottest] < 2.0 * m_ioLoopLags[coolest]) {
+        return;
+    }
+    
+    // Busiest device on the hot loop since the last rebalance
+    QString busiestKey;
+    qint64 busiestRequests = -1;
+    int workersOnLoop = 0;
+    for (auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        WorkerInfo &info = it.value();
+        const qint64 requests = info.lastStats.totalRequests - info.requestsAtRebalance;
+        info.requestsAtRebalance = info.lastStats.totalRequests;
+        if (info.loopIndex != hottest) {
+            continue;
+        }
+        workersOnLoop++;
+        if (requests > busiestRequests) {
+            busiestRequests = requests;
+            busiestKey = it.key();
+        }
+    }
+    
+    if (workersOnLoop <= 1) {
+        return;  // A single device cannot be split further
+    }
+    
+    WorkerInfo &info = m_workers[busiestKey];
+    QThread* target = m_ioLoops.at(coolest);
+    info.loopIndex = coolest;
+    info.thread = target;
+    m_loopOverrides[busiestKey] = coolest;
+    
+    // moveToThread() must run in the worker's current thread; its timers and client move with it
+    ModbusWorker* worker = info.worker;
+    QMetaObject::invokeMethod(worker, [worker, target]() { worker->moveToThread(target); }, Qt::QueuedConnection);
+    
+    qDebug() << "ModbusWorkerManager moved" << busiestKey << "from hot I/O loop" << hottest << "to loop" << coolest;
+}
+
 void ModbusWorkerManager::connectWorkerSignals(ModbusWorker* worker)
 {
     connect(worker, &ModbusWorker::connectionStateChanged,
@@ -226,6 +458,10 @@ void ModbusWorkerManager::connectWorkerSignals(ModbusWorker* worker)
                 convertedStats.failedRequests = stats.failedRequests;
                 convertedStats.interruptedRequests = stats.interruptedRequests;
                 convertedStats.highPriorityRequests = stats.highPriorityRequests;
+                convertedStats.expiredRequests = stats.expiredRequests;
+                convertedStats.mergedRequests = stats.mergedRequests;
+                convertedStats.rejectedRequests = stats.rejectedRequests;
+                convertedStats.sharedRequests = stats.sharedRequests;
                 convertedStats.averageResponseTime = stats.averageResponseTime;
                 convertedStats.lastActivityTime = stats.lastActivityTime;
                 convertedStats.isConnected = stats.isConnected;
@@ -391,6 +627,9 @@ void ModbusWorkerManager::distributeLoad()
     
     QMutexLocker loadLocker(&m_loadBalancingMutex);
     
+    // Shared I/O loops are balanced on event dispatch lag, independent of device state
+    rebalanceIoLoops();
+    
     // Check if any workers are still initializing to prevent interference
     QMutexLocker workersLocker(&m_workersMutex);
     int initializingWorkers = 0;
@@ -576,6 +815,12 @@ void ModbusWorkerManager::handleDelayedStartup(const QString &deviceKey)
         QMetaObject::invokeMethod(worker, "setPollInterval", Qt::BlockingQueuedConnection,
                                   Q_ARG(int, m_defaultPollInterval));
         
+        // Shared gateway workers may keep several requests outstanding
+        if (worker->isSharedConnection()) {
+            QMetaObject::invokeMethod(worker, "setMaxConcurrentRequests", Qt::BlockingQueuedConnection,
+                                      Q_ARG(int, m_gatewayConcurrencyLimit));
+        }
+        
         // Now start the worker
         QMetaObject::invokeMethod(worker, "startWorker", Qt::QueuedConnection);
         
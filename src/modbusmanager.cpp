@@ -1,18 +1,65 @@
 #include "../include/modbusmanager.h"
+#include "../include/modbus_tcp_engine.h"
+#include "../include/register_decode_kernels.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QDataStream>
 #include <QByteArray>
 #include <QFileInfo>
+#include <QVarLengthArray>
+
+namespace {
+
+// Exceptions a device uses to say "slow down" rather than "request invalid"
+inline bool isDeviceBusyException(int exceptionCode)
+{
+    return exceptionCode == QModbusPdu::Acknowledge || exceptionCode == QModbusPdu::ServerDeviceBusy;
+}
+
+inline bool isDeviceBusyReply(QModbusReply *reply)
+{
+    return reply->error() == QModbusDevice::ProtocolError
+           && isDeviceBusyException(reply->rawResult().exceptionCode());
+}
+
+inline bool isWriteRequest(const ModbusRequest &request)
+{
+    return request.type == ModbusRequest::WriteHoldingRegisters || request.type == ModbusRequest::WriteCoils;
+}
+
+// Function code the native engine sends for request (single writes use FC 5/6)
+quint8 nativeFunctionCode(const ModbusRequest &request)
+{
+    switch (request.type) {
+        case ModbusRequest::ReadHoldingRegisters:
+            return ModbusTcpEngine::ReadHoldingRegisters;
+        case ModbusRequest::ReadInputRegisters:
+            return ModbusTcpEngine::ReadInputRegisters;
+        case ModbusRequest::ReadCoils:
+            return ModbusTcpEngine::ReadCoils;
+        case ModbusRequest::ReadDiscreteInputs:
+            return ModbusTcpEngine::ReadDiscreteInputs;
+        case ModbusRequest::WriteHoldingRegisters:
+            return request.count == 1 ? ModbusTcpEngine::WriteSingleRegister
+                                      : ModbusTcpEngine::WriteMultipleRegisters;
+        case ModbusRequest::WriteCoils:
+            return request.count == 1 ? ModbusTcpEngine::WriteSingleCoil
+                                      : ModbusTcpEngine::WriteMultipleCoils;
+    }
+    return 0;
+}
+
+} // namespace
 
 ModbusManager::ModbusManager(QObject *parent)
     : QObject(parent)
     , m_modbusClient(nullptr)
     , m_requestTimer(nullptr)
     , m_timeoutTimer(nullptr)
-    , m_requestInProgress(false)
-    , m_currentReply(nullptr)
-    , m_currentRequestTime(0)
+    , m_nativeEngine(nullptr)
+    , m_useNativeEngine(false)
+    , m_maxInFlight(1)
+    , m_nextTransactionId(0)
     , m_settings(nullptr)
     , m_autoAdjust(true)
     , m_heartbeatInterval(30000)
@@ -21,7 +68,10 @@ ModbusManager::ModbusManager(QObject *parent)
     , m_requestTimeout(12000)
     , m_connectionTimeout(15000)
     , m_networkType("cellular_4g")
-    , m_requestInterval(100)  // 100ms between requests
+    , m_eagerDecode(true)
+    , m_pacingRate(0.0)
+    , m_pacingBurst(4)
+    , m_adaptivePacing(true)
 {
     // QModbusTcpClient and timers will be created in initializeClient() after moveToThread()
     // to avoid threading violations
@@ -86,6 +136,12 @@ bool ModbusManager::loadConfigurationFromFile(const QString &configPath)
     m_requestTimeout = m_settings->value("request_timeout", 12000).toInt();
     m_connectionTimeout = m_settings->value("connection_timeout", 15000).toInt();
     m_networkType = m_settings->value("network_type", "cellular_4g").toString();
+    setMaxInFlight(m_settings->value("max_in_flight", 1).toInt());
+    m_useNativeEngine = m_settings->value("modbus_engine", "qt").toString() == "native";
+    m_eagerDecode = m_settings->value("eager_decode", true).toBool();
+    m_adaptivePacing = m_settings->value("adaptive_pacing", true).toBool();
+    setPacing(m_settings->value("pacing_rate", 0.0).toDouble(),
+              m_settings->value("pacing_burst", 4).toInt());
     m_settings->endGroup();
     
     // Configuration loaded successfully
@@ -93,12 +149,71 @@ bool ModbusManager::loadConfigurationFromFile(const QString &configPath)
     return true;
 }
 
+void ModbusManager::setMaxInFlight(int maxInFlight)
+{
+    // Modbus TCP allows many outstanding transactions per connection, but most
+    // devices and gateways only buffer a handful - keep the window small.
+    m_maxInFlight = qBound(1, maxInFlight, 16);
+}
+
+void ModbusManager::setPacing(double ratePerSecond, int burst)
+{
+    m_pacingRate = qMax(0.0, ratePerSecond);
+    m_pacingBurst = qMax(1, burst);
+    
+    for (auto it = m_pacers.begin(); it != m_pacers.end(); ++it) {
+        it.value().configure(m_pacingRate, m_pacingBurst);
+    }
+}
+
+void ModbusManager::setAdaptivePacingEnabled(bool enabled)
+{
+    m_adaptivePacing = enabled;
+    
+    for (auto it = m_pacers.begin(); it != m_pacers.end(); ++it) {
+        it.value().setAdaptive(enabled);
+        if (!enabled) {
+            it.value().configure(m_pacingRate, m_pacingBurst);
+        }
+    }
+}
+
+double ModbusManager::getPacingRate(int unitId) const
+{
+    auto it = m_pacers.constFind(unitId);
+    return it != m_pacers.constEnd() ? it.value().currentRate() : m_pacingRate;
+}
+
 bool ModbusManager::connectToServer(const QString &host, int port)
 {
     if (!m_modbusClient) {
         return false;
     }
         
+    // Native engine replaces QModbusTcpClient on the wire when enabled and supported
+    if (m_useNativeEngine && ModbusTcpEngine::isSupported()) {
+        if (!m_nativeEngine) {
+            m_nativeEngine = new ModbusTcpEngine(this);
+            connect(m_nativeEngine, &ModbusTcpEngine::responseReceived,
+                    this, &ModbusManager::onNativeResponse);
+            connect(m_nativeEngine, &ModbusTcpEngine::exceptionReceived,
+                    this, &ModbusManager::onNativeException);
+            connect(m_nativeEngine, &ModbusTcpEngine::malformedResponse,
+                    this, &ModbusManager::onNativeMalformedResponse);
+            connect(m_nativeEngine, &ModbusTcpEngine::stateChanged,
+                    this, &ModbusManager::onNativeStateChanged);
+            connect(m_nativeEngine, &ModbusTcpEngine::errorOccurred,
+                    this, &ModbusManager::errorOccurred);
+        }
+        return m_nativeEngine->connectToHost(host, port, m_connectionTimeout);
+    }
+    
+    if (m_nativeEngine) {
+        m_nativeEngine->disconnectFromHost();
+        m_nativeEngine->deleteLater();
+        m_nativeEngine = nullptr;
+    }
+    
     if (m_modbusClient->state() == QModbusDevice::ConnectedState) {
         return true;
     }
@@ -113,6 +228,11 @@ bool ModbusManager::connectToServer(const QString &host, int port)
 
 void ModbusManager::disconnectFromServer()
 {
+    if (m_nativeEngine) {
+        m_nativeEngine->disconnectFromHost();
+        return;
+    }
+    
     if (m_modbusClient && m_modbusClient->state() == QModbusDevice::ConnectedState) {
         m_modbusClient->disconnectDevice();
     }
@@ -120,6 +240,10 @@ void ModbusManager::disconnectFromServer()
 
 bool ModbusManager::isConnected() const
 {
+    if (m_nativeEngine) {
+        return m_nativeEngine->isConnected();
+    }
+    
     if (!m_modbusClient) {
         return false;
     }
@@ -133,50 +257,50 @@ bool ModbusManager::isClientInitialized() const
 }
 
 // Single read operations
-void ModbusManager::readHoldingRegister(int address, ModbusDataType dataType, int unitId)
+quint16 ModbusManager::readHoldingRegister(int address, ModbusDataType dataType, int unitId)
 {
     int registerCount = (dataType == ModbusDataType::Float32) ? 2 : 
                        (dataType == ModbusDataType::Double64) ? 4 :
                        (dataType == ModbusDataType::Long32) ? 2 :
                        (dataType == ModbusDataType::Long64) ? 4 : 1;
     // Use address directly (Modbus addresses are 0-based)
-    readHoldingRegisters(address, registerCount, dataType, unitId);
+    return readHoldingRegisters(address, registerCount, dataType, unitId);
 }
 
-void ModbusManager::readInputRegister(int address, ModbusDataType dataType, int unitId)
+quint16 ModbusManager::readInputRegister(int address, ModbusDataType dataType, int unitId)
 {
     int registerCount = (dataType == ModbusDataType::Float32) ? 2 : 
                        (dataType == ModbusDataType::Double64) ? 4 :
                        (dataType == ModbusDataType::Long32) ? 2 :
                        (dataType == ModbusDataType::Long64) ? 4 : 1;
     // Use address directly (Modbus addresses are 0-based)
-    readInputRegisters(address, registerCount, dataType, unitId);
+    return readInputRegisters(address, registerCount, dataType, unitId);
 }
 
-void ModbusManager::readCoil(int address, int unitId)
+quint16 ModbusManager::readCoil(int address, int unitId)
 {
     // Use address directly (Modbus addresses are 0-based)
-    readCoils(address, 1, unitId);
+    return readCoils(address, 1, unitId);
 }
 
-void ModbusManager::readDiscreteInput(int address, int unitId)
+quint16 ModbusManager::readDiscreteInput(int address, int unitId)
 {
     // Use address directly (Modbus addresses are 0-based)
-    readDiscreteInputs(address, 1, unitId);
+    return readDiscreteInputs(address, 1, unitId);
 }
 
 // Multiple read operations
-void ModbusManager::readHoldingRegisters(int startAddress, int count, ModbusDataType dataType, int unitId)
+quint16 ModbusManager::readHoldingRegisters(int startAddress, int count, ModbusDataType dataType, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check register count limit
     if (count > 125) {
         emit errorOccurred(QString("Register count (%1) exceeds maximum limit of 125 registers").arg(count));
-        return;
+        return 0;
     }
     
     // Create request and add to queue
@@ -188,20 +312,20 @@ void ModbusManager::readHoldingRegisters(int startAddress, int count, ModbusData
     request.dataType = dataType;
     request.requestTime = QDateTime::currentMSecsSinceEpoch();
     
-    queueRequest(request);
+    return queueRequest(request);
 }
 
-void ModbusManager::readInputRegisters(int startAddress, int count, ModbusDataType dataType, int unitId)
+quint16 ModbusManager::readInputRegisters(int startAddress, int count, ModbusDataType dataType, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check register count limit
     if (count > 125) {
         emit errorOccurred(QString("Register count (%1) exceeds maximum limit of 125 registers").arg(count));
-        return;
+        return 0;
     }
     
     // Create request and add to queue
@@ -213,20 +337,20 @@ void ModbusManager::readInputRegisters(int startAddress, int count, ModbusDataTy
     request.dataType = dataType;
     request.requestTime = QDateTime::currentMSecsSinceEpoch();
     
-    queueRequest(request);
+    return queueRequest(request);
 }
 
-void ModbusManager::readCoils(int startAddress, int count, int unitId)
+quint16 ModbusManager::readCoils(int startAddress, int count, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check coil count limit
-    if (count > 125) {
-        emit errorOccurred(QString("Coil count (%1) exceeds maximum limit of 125 coils").arg(count));
-        return;
+    if (count > MAX_READ_BITS) {
+        emit errorOccurred(QString("Coil count (%1) exceeds maximum limit of %2 coils").arg(count).arg(MAX_READ_BITS));
+        return 0;
     }
     
     // Create request and add to queue
@@ -238,20 +362,20 @@ void ModbusManager::readCoils(int startAddress, int count, int unitId)
     request.dataType = ModbusDataType::Coil;
     request.requestTime = QDateTime::currentMSecsSinceEpoch();
     
-    queueRequest(request);
+    return queueRequest(request);
 }
 
-void ModbusManager::readDiscreteInputs(int startAddress, int count, int unitId)
+quint16 ModbusManager::readDiscreteInputs(int startAddress, int count, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check discrete input count limit
-    if (count > 125) {
-        emit errorOccurred(QString("Discrete input count (%1) exceeds maximum limit of 125 inputs").arg(count));
-        return;
+    if (count > MAX_READ_BITS) {
+        emit errorOccurred(QString("Discrete input count (%1) exceeds maximum limit of %2 inputs").arg(count).arg(MAX_READ_BITS));
+        return 0;
     }
     
     // Create request and add to queue
@@ -263,56 +387,71 @@ void ModbusManager::readDiscreteInputs(int startAddress, int count, int unitId)
     request.dataType = ModbusDataType::DiscreteInput;
     request.requestTime = QDateTime::currentMSecsSinceEpoch();
     
-    queueRequest(request);
+    return queueRequest(request);
 }
 
 // Single write operations
-void ModbusManager::writeHoldingRegister(int address, quint16 value, int unitId)
+quint16 ModbusManager::writeHoldingRegister(int address, quint16 value, int unitId)
 {
-    writeHoldingRegisters(address, QVector<quint16>() << value, unitId);
+    return writeHoldingRegisters(address, QVector<quint16>() << value, unitId);
 }
 
-void ModbusManager::writeHoldingRegisterFloat32(int address, float value, int unitId)
+quint16 ModbusManager::writeHoldingRegisterFloat32(int address, float value, int unitId)
 {
     auto registers = float32ToRegisters(value);
-    writeHoldingRegisters(address, QVector<quint16>() << registers.first << registers.second, unitId);
+    return writeHoldingRegisters(address, QVector<quint16>() << registers.first << registers.second, unitId);
 }
 
-void ModbusManager::writeHoldingRegisterDouble64(int address, double value, int unitId)
+quint16 ModbusManager::writeHoldingRegisterDouble64(int address, double value, int unitId)
 {
     auto registers = double64ToRegisters(value);
-    writeHoldingRegisters(address, registers, unitId);
+    return writeHoldingRegisters(address, registers, unitId);
 }
 
-void ModbusManager::writeHoldingRegisterLong32(int address, qint32 value, int unitId)
+quint16 ModbusManager::writeHoldingRegisterLong32(int address, qint32 value, int unitId)
 {
     auto registers = long32ToRegisters(value);
-    writeHoldingRegisters(address, QVector<quint16>() << registers.first << registers.second, unitId);
+    return writeHoldingRegisters(address, QVector<quint16>() << registers.first << registers.second, unitId);
 }
 
-void ModbusManager::writeHoldingRegisterLong64(int address, qint64 value, int unitId)
+quint16 ModbusManager::writeHoldingRegisterLong64(int address, qint64 value, int unitId)
 {
     auto registers = long64ToRegisters(value);
-    writeHoldingRegisters(address, registers, unitId);
+    return writeHoldingRegisters(address, registers, unitId);
 }
 
-void ModbusManager::writeCoil(int address, bool value, int unitId)
+quint16 ModbusManager::writeCoil(int address, bool value, int unitId)
 {
-    writeCoils(address, QVector<bool>() << value, unitId);
+    return writeCoils(address, QVector<bool>() << value, unitId);
 }
 
 // Multiple write operations
-void ModbusManager::writeHoldingRegisters(int startAddress, const QVector<quint16> &values, int unitId)
+quint16 ModbusManager::writeHoldingRegisters(int startAddress, const QVector<quint16> &values, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check register count limit
     if (values.size() > 125) {
         emit errorOccurred(QString("Register count (%1) exceeds maximum limit of 125 registers").arg(values.size()));
-        return;
+        return 0;
+    }
+    
+    if (m_nativeEngine) {
+        ModbusRequest request;
+        request.type = ModbusRequest::WriteHoldingRegisters;
+        request.startAddress = startAddress;
+        request.count = values.size();
+        request.unitId = unitId;
+        request.requestTime = QDateTime::currentMSecsSinceEpoch();
+        request.transactionId = nextTransactionId();
+        if (m_nativeEngine->sendWriteRegisters(request.transactionId, unitId, startAddress, values)) {
+            trackTransaction(request, nullptr);
+            return request.transactionId;
+        }
+        return 0;
     }
     
     QModbusDataUnit writeUnit(QModbusDataUnit::HoldingRegisters, startAddress, values.size());
@@ -324,63 +463,83 @@ void ModbusManager::writeHoldingRegisters(int startAddress, const QVector<quint1
         if (!reply->isFinished()) {
             connect(reply, &QModbusReply::finished, this, &ModbusManager::onWriteReady);
             m_replyAddressMap[reply] = qMakePair(startAddress, values.size());
-        } else {
-            delete reply;
+            quint16 transactionId = nextTransactionId();
+            m_replyTransactions.insert(reply, transactionId);
+            return transactionId;
         }
+        delete reply;
     }
+    return 0;
 }
 
-void ModbusManager::writeHoldingRegistersFloat32(int startAddress, const QVector<float> &values, int unitId)
+quint16 ModbusManager::writeHoldingRegistersFloat32(int startAddress, const QVector<float> &values, int unitId)
 {
     QVector<quint16> registers;
     for (const float &value : values) {
         auto regs = float32ToRegisters(value);
         registers << regs.first << regs.second;
     }
-    writeHoldingRegisters(startAddress, registers, unitId);
+    return writeHoldingRegisters(startAddress, registers, unitId);
 }
 
-void ModbusManager::writeHoldingRegistersDouble64(int startAddress, const QVector<double> &values, int unitId)
+quint16 ModbusManager::writeHoldingRegistersDouble64(int startAddress, const QVector<double> &values, int unitId)
 {
     QVector<quint16> registers;
     for (const double &value : values) {
         auto regs = double64ToRegisters(value);
         registers += regs;
     }
-    writeHoldingRegisters(startAddress, registers, unitId);
+    return writeHoldingRegisters(startAddress, registers, unitId);
 }
 
-void ModbusManager::writeHoldingRegistersLong32(int startAddress, const QVector<qint32> &values, int unitId)
+quint16 ModbusManager::writeHoldingRegistersLong32(int startAddress, const QVector<qint32> &values, int unitId)
 {
     QVector<quint16> registers;
     for (const qint32 &value : values) {
         auto regs = long32ToRegisters(value);
         registers << regs.first << regs.second;
     }
-    writeHoldingRegisters(startAddress, registers, unitId);
+    return writeHoldingRegisters(startAddress, registers, unitId);
 }
 
-void ModbusManager::writeHoldingRegistersLong64(int startAddress, const QVector<qint64> &values, int unitId)
+quint16 ModbusManager::writeHoldingRegistersLong64(int startAddress, const QVector<qint64> &values, int unitId)
 {
     QVector<quint16> registers;
     for (const qint64 &value : values) {
         auto regs = long64ToRegisters(value);
         registers += regs;
     }
-    writeHoldingRegisters(startAddress, registers, unitId);
+    return writeHoldingRegisters(startAddress, registers, unitId);
 }
 
-void ModbusManager::writeCoils(int startAddress, const QVector<bool> &values, int unitId)
+quint16 ModbusManager::writeCoils(int startAddress, const QVector<bool> &values, int unitId)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
-        return;
+        return 0;
     }
     
     // Check coil count limit
     if (values.size() > 125) {
         emit errorOccurred(QString("Coil count (%1) exceeds maximum limit of 125 coils").arg(values.size()));
-        return;
+        return 0;
+    }
+    
+    if (m_nativeEngine) {
+        ModbusRequest request;
+        request.type = ModbusRequest::WriteCoils;
+        request.startAddress = startAddress;
+        request.count = values.size();
+        request.unitId = unitId;
+        request.dataType = ModbusDataType::Coil;
+        request.requestTime = QDateTime::currentMSecsSinceEpoch();
+        request.transactionId = nextTransactionId();
+        request.writeBoolData = values;
+        if (m_nativeEngine->sendWriteCoils(request.transactionId, unitId, startAddress, values)) {
+            trackTransaction(request, nullptr);
+            return request.transactionId;
+        }
+        return 0;
     }
     
     QModbusDataUnit writeUnit(QModbusDataUnit::Coils, startAddress, values.size());
@@ -392,10 +551,13 @@ void ModbusManager::writeCoils(int startAddress, const QVector<bool> &values, in
         if (!reply->isFinished()) {
             connect(reply, &QModbusReply::finished, this, &ModbusManager::onWriteReady);
             m_replyAddressMap[reply] = qMakePair(startAddress, values.size());
-        } else {
-            delete reply;
+            quint16 transactionId = nextTransactionId();
+            m_replyTransactions.insert(reply, transactionId);
+            return transactionId;
         }
+        delete reply;
     }
+    return 0;
 }
 
 // IEEE 754 utility functions
@@ -599,43 +761,131 @@ double ModbusManager::boolToNumeric(bool value)
 }
 
 // Queue management methods
-void ModbusManager::queueRequest(const ModbusRequest &request)
+quint16 ModbusManager::queueRequest(const ModbusRequest &request)
 {
-    m_requestQueue.enqueue(request);
+    ModbusRequest queued = request;
+    queued.transactionId = nextTransactionId();
+    m_requestQueue.enqueue(queued);
     
-    // Start processing if no request is in progress
-    if (!m_requestInProgress && !m_requestTimer->isActive()) {
+    // Start processing if the in-flight window has room
+    if (m_inFlight.size() < m_maxInFlight && !m_requestTimer->isActive()) {
         m_requestTimer->start(0); // Process immediately
     }
+    
+    return queued.transactionId;
+}
+
+quint16 ModbusManager::nextTransactionId()
+{
+    // 0 is reserved for "rejected"; after a wrap, skip IDs that are still on the
+    // wire so a late response cannot complete the wrong request
+    do {
+        ++m_nextTransactionId;
+    } while (m_nextTransactionId == 0 || m_inFlight.contains(m_nextTransactionId));
+    return m_nextTransactionId;
 }
 
 void ModbusManager::processNextRequest()
 {
-    if (m_requestQueue.isEmpty() || m_requestInProgress) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    
+    // Queued requests already handed their transaction IDs to callers; answer each
+    // one instead of dropping it. Taken as a batch because a failure handler may
+    // queue a new request.
+    if (!isConnected()) {
+        const QQueue<ModbusRequest> unsent = m_requestQueue;
+        m_requestQueue.clear();
+        for (const ModbusRequest &request : unsent) {
+            failTransaction(request.transactionId, request, QModbusDevice::ConnectionError,
+                            "Not connected to Modbus server");
+        }
         return;
     }
     
-    ModbusRequest request = m_requestQueue.dequeue();
-    executeRequest(request);
+    // Fill the in-flight window; with m_maxInFlight == 1 this is plain request/response
+    while (!m_requestQueue.isEmpty() && m_inFlight.size() < m_maxInFlight) {
+        // Each device is paced by its own bucket. A unit out of tokens keeps its
+        // requests queued in order while other units behind the same gateway go ahead.
+        QVarLengthArray<int, 8> throttledUnits;
+        int waitMs = 0;
+        int next = -1;
+        for (int i = 0; i < m_requestQueue.size(); ++i) {
+            const int unitId = m_requestQueue.at(i).unitId;
+            if (throttledUnits.contains(unitId)) {
+                continue;
+            }
+            const int unitWaitMs = pacerFor(unitId).msUntilAvailable(now);
+            if (unitWaitMs == 0) {
+                next = i;
+                break;
+            }
+            throttledUnits.append(unitId);
+            waitMs = waitMs == 0 ? unitWaitMs : qMin(waitMs, unitWaitMs);
+        }
+        if (next < 0) {
+            m_requestTimer->start(waitMs);  // Earliest token of any waiting unit
+            break;
+        }
+        
+        ModbusRequest request = m_requestQueue.takeAt(next);
+        pacerFor(request.unitId).consume(now);
+        if (!executeRequest(request)) {
+            failTransaction(request.transactionId, request,
+                            isConnected() ? QModbusDevice::UnknownError : QModbusDevice::ConnectionError,
+                            "Modbus request could not be sent");
+            break;
+        }
+    }
+}
+
+ModbusRequestPacer &ModbusManager::pacerFor(int unitId)
+{
+    auto it = m_pacers.find(unitId);
+    if (it == m_pacers.end()) {
+        it = m_pacers.insert(unitId, ModbusRequestPacer(m_pacingRate, m_pacingBurst));
+        it.value().setAdaptive(m_adaptivePacing);
+    }
+    return it.value();
+}
+
+void ModbusManager::updatePacing(int unitId, bool success, bool deviceBusy, qint64 sentTime)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    ModbusRequestPacer &pacer = pacerFor(unitId);
+    
+    if (deviceBusy) {
+        if (pacer.onDeviceBusy(now, sentTime > 0 ? sentTime : now)) {
+            qDebug() << "ModbusManager - Unit" << unitId << "reported busy, pacing at"
+                     << pacer.currentRate() << "requests/s";
+        }
+    } else if (success) {
+        const bool wasThrottled = pacer.isThrottled();
+        pacer.onSuccess(now);
+        if (wasThrottled && !pacer.isThrottled()) {
+            qDebug() << "ModbusManager - Unit" << unitId << "pacing restored";
+        }
+    }
 }
 
-void ModbusManager::executeRequest(const ModbusRequest &request)
+bool ModbusManager::executeRequest(const ModbusRequest &request)
 {
     if (!isConnected()) {
         emit errorOccurred("Not connected to Modbus server");
         // Schedule next request
         if (!m_requestQueue.isEmpty()) {
-            m_requestTimer->start(m_requestInterval);
+            m_requestTimer->start(SEND_RETRY_DELAY_MS);
         }
-        return;
+        return false;
     }
     
-    m_requestInProgress = true;
-    m_currentRequestTime = QDateTime::currentMSecsSinceEpoch();
-    
     // Debug: Log the request details being executed
     qDebug() << "[ModbusManager::executeRequest] Creating QModbusDataUnit with count:" << request.count 
-             << "address:" << request.startAddress << "type:" << static_cast<int>(request.type);
+             << "address:" << request.startAddress << "type:" << static_cast<int>(request.type)
+             << "transaction:" << request.transactionId << "in-flight:" << m_inFlight.size();
+    
+    if (m_nativeEngine) {
+        return executeNativeRequest(request);
+    }
     
     QModbusDataUnit readUnit;
     
@@ -662,46 +912,161 @@ void ModbusManager::executeRequest(const ModbusRequest &request)
     
     if (auto *reply = m_modbusClient->sendReadRequest(readUnit, request.unitId)) {
         if (!reply->isFinished()) {
-            m_currentReply = reply;
             connect(reply, &QModbusReply::finished, this, &ModbusManager::onReadReady);
-            m_pendingReads[reply] = request.dataType;
-            m_replyAddressMap[reply] = qMakePair(request.startAddress, request.count);
-            
-            // Start timeout timer
-            m_timeoutTimer->start(m_requestTimeout);
-        } else {
-            delete reply;
-            completeCurrentRequest();
+            trackTransaction(request, reply);
+            return true;
         }
-    } else {
-        completeCurrentRequest();
+        delete reply;
     }
+    
+    // Nothing went on the wire - keep the queue moving
+    if (!m_requestQueue.isEmpty() && !m_requestTimer->isActive()) {
+        m_requestTimer->start(SEND_RETRY_DELAY_MS);
+    }
+    return false;
 }
 
-void ModbusManager::completeCurrentRequest()
+bool ModbusManager::executeNativeRequest(const ModbusRequest &request)
 {
-    m_requestInProgress = false;
-    m_currentReply = nullptr;
-    m_timeoutTimer->stop();
+    ModbusTcpEngine::FunctionCode functionCode = ModbusTcpEngine::ReadHoldingRegisters;
+    switch (request.type) {
+        case ModbusRequest::ReadHoldingRegisters:
+            functionCode = ModbusTcpEngine::ReadHoldingRegisters;
+            break;
+        case ModbusRequest::ReadInputRegisters:
+            functionCode = ModbusTcpEngine::ReadInputRegisters;
+            break;
+        case ModbusRequest::ReadCoils:
+            functionCode = ModbusTcpEngine::ReadCoils;
+            break;
+        case ModbusRequest::ReadDiscreteInputs:
+            functionCode = ModbusTcpEngine::ReadDiscreteInputs;
+            break;
+        case ModbusRequest::WriteHoldingRegisters:
+        case ModbusRequest::WriteCoils:
+            // Writes are sent directly by the write* methods
+            return false;
+    }
+    
+    if (m_nativeEngine->sendReadRequest(request.transactionId, request.unitId, functionCode,
+                                        request.startAddress, request.count)) {
+        trackTransaction(request, nullptr);
+        return true;
+    }
+    
+    if (!m_requestQueue.isEmpty() && !m_requestTimer->isActive()) {
+        m_requestTimer->start(SEND_RETRY_DELAY_MS);
+    }
+    return false;
+}
+
+void ModbusManager::trackTransaction(const ModbusRequest &request, QModbusReply *reply)
+{
+    InFlightTransaction transaction;
+    transaction.request = request;
+    transaction.reply = reply;
+    transaction.sentTime = QDateTime::currentMSecsSinceEpoch();
+    transaction.deadline = transaction.sentTime + m_requestTimeout;
+    m_inFlight.insert(request.transactionId, transaction);
+    
+    if (reply) {
+        m_replyTransactions.insert(reply, request.transactionId);
+    }
+    
+    // Each transaction has its own deadline; the timer tracks the earliest one
+    armTimeoutTimer();
+}
+
+void ModbusManager::completeTransaction(quint16 transactionId)
+{
+    QModbusReply *reply = m_inFlight.value(transactionId).reply;
+    if (reply) {
+        m_replyTransactions.remove(reply);
+    }
+    m_inFlight.remove(transactionId);
+    armTimeoutTimer();
     
-    // Schedule next request
+    // Schedule next request now, even over a pacing wait: processNextRequest applies
+    // per-device pacing, and a freed slot may go to a unit that still has tokens
     if (!m_requestQueue.isEmpty()) {
-        m_requestTimer->start(m_requestInterval);
+        m_requestTimer->start(0);
+    }
+}
+
+void ModbusManager::failTransaction(quint16 transactionId, const ModbusRequest &request,
+                                    QModbusDevice::Error errorType, const QString &errorString)
+{
+    if (isWriteRequest(request)) {
+        ModbusWriteResult result;
+        result.timestamp = QDateTime::currentMSecsSinceEpoch();
+        result.startAddress = request.startAddress;
+        result.registerCount = request.count;
+        result.transactionId = transactionId;
+        result.errorType = errorType;
+        result.errorString = errorString;
+        emit writeCompleted(result);
+        return;
     }
+    
+    ModbusReadResult result;
+    result.timestamp = QDateTime::currentMSecsSinceEpoch();
+    result.dataType = request.dataType;
+    result.startAddress = request.startAddress;
+    result.transactionId = transactionId;
+    result.errorType = errorType;
+    result.errorString = errorString;
+    emit readCompleted(result);
+}
+
+void ModbusManager::armTimeoutTimer()
+{
+    if (m_inFlight.isEmpty()) {
+        m_timeoutTimer->stop();
+        return;
+    }
+    
+    qint64 earliestDeadline = std::numeric_limits<qint64>::max();
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        earliestDeadline = qMin(earliestDeadline, it.value().deadline);
+    }
+    
+    qint64 remaining = earliestDeadline - QDateTime::currentMSecsSinceEpoch();
+    m_timeoutTimer->start(static_cast<int>(qMax<qint64>(0, remaining)));
 }
 
 void ModbusManager::handleRequestTimeout()
 {
-    if (m_currentReply) {
-        m_currentReply->deleteLater();
-        m_pendingReads.remove(m_currentReply);
-        m_replyAddressMap.remove(m_currentReply);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    
+    // Expire only the transactions whose own deadline has passed
+    QList<quint16> expired;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        if (it.value().deadline <= now) {
+            expired.append(it.key());
+        }
+    }
+    
+    for (quint16 transactionId : expired) {
+        const InFlightTransaction transaction = m_inFlight.take(transactionId);
         
-        qint64 elapsed = QDateTime::currentMSecsSinceEpoch() - m_currentRequestTime;
-        emit errorOccurred(QString("Modbus request timeout after %1ms").arg(elapsed));
+        // Late replies for this transaction must not complete anything
+        if (transaction.reply) {
+            disconnect(transaction.reply, nullptr, this, nullptr);
+            transaction.reply->deleteLater();
+            m_replyTransactions.remove(transaction.reply);
+            m_replyAddressMap.remove(transaction.reply);
+        }
+        
+        // Report the failure against the transaction so callers can release it
+        failTransaction(transactionId, transaction.request, QModbusDevice::TimeoutError,
+                        QString("Modbus request timeout after %1ms").arg(now - transaction.sentTime));
     }
     
-    completeCurrentRequest();
+    armTimeoutTimer();
+    
+    if (!m_requestQueue.isEmpty() && !m_requestTimer->isActive()) {
+        m_requestTimer->start(0);
+    }
 }
 
 // Private slots
@@ -716,26 +1081,152 @@ void ModbusManager::onReadReady()
     if (!reply)
         return;
     
-    // Stop timeout timer since we got a response
-    if (reply == m_currentReply) {
-        m_timeoutTimer->stop();
+    // Unknown replies were already expired by the timeout sweep
+    auto it = m_replyTransactions.constFind(reply);
+    if (it == m_replyTransactions.constEnd()) {
+        reply->deleteLater();
+        return;
     }
-        
-    ModbusDataType dataType = m_pendingReads.value(reply, ModbusDataType::HoldingRegister);
-    ModbusReadResult result = processReadReply(reply, dataType);
     
-    m_pendingReads.remove(reply);
-    m_replyAddressMap.remove(reply);
+    const quint16 transactionId = it.value();
+    const InFlightTransaction transaction = m_inFlight.value(transactionId);
+    const ModbusRequest &request = transaction.request;
+    ModbusReadResult result = processReadReply(reply, request.dataType);
+    result.transactionId = transactionId;
+    updatePacing(request.unitId, result.success, isDeviceBusyReply(reply), transaction.sentTime);
+    
     reply->deleteLater();
     
-    // Complete current request and process next one
-    if (reply == m_currentReply) {
-        completeCurrentRequest();
+    // Release the window slot and process next one
+    completeTransaction(transactionId);
+    
+    emit readCompleted(result);
+}
+
+QString ModbusManager::nativeResponseMismatch(const ModbusRequest &request, quint8 unitId,
+                                              quint8 functionCode, int byteCount)
+{
+    const quint8 expectedFunctionCode = nativeFunctionCode(request);
+    if (functionCode != expectedFunctionCode) {
+        return QString("Response function code 0x%1 does not match request function code 0x%2")
+                   .arg(functionCode, 2, 16, QChar('0'))
+                   .arg(expectedFunctionCode, 2, 16, QChar('0'));
+    }
+    if (unitId != static_cast<quint8>(request.unitId)) {
+        return QString("Response unit %1 does not match request unit %2").arg(unitId).arg(request.unitId);
+    }
+    if (!isWriteRequest(request)) {
+        const int expectedByteCount = isBitDataType(request.dataType) ? (request.count + 7) / 8
+                                                                     : request.count * 2;
+        if (byteCount != expectedByteCount) {
+            return QString("Response byte count %1 does not match %2 expected for %3 %4")
+                       .arg(byteCount).arg(expectedByteCount).arg(request.count)
+                       .arg(isBitDataType(request.dataType) ? "bits" : "registers");
+        }
+    }
+    return QString();
+}
+
+void ModbusManager::onNativeResponse(quint16 transactionId, quint8 unitId, quint8 functionCode,
+                                     int byteCount, const QVector<quint16> &values)
+{
+    auto it = m_inFlight.constFind(transactionId);
+    if (it == m_inFlight.constEnd()) {
+        return; // Late response for an expired transaction
+    }
+    const ModbusRequest request = it.value().request;
+    completeTransaction(transactionId);
+    
+    // A matching transaction ID alone does not make the frame an answer to this request
+    const QString mismatch = nativeResponseMismatch(request, unitId, functionCode, byteCount);
+    if (!mismatch.isEmpty()) {
+        qWarning() << "ModbusManager: Transaction" << transactionId << mismatch;
+        updatePacing(request.unitId, false, false);
+        failTransaction(transactionId, request, QModbusDevice::ProtocolError, mismatch);
+        return;
+    }
+    updatePacing(request.unitId, true, false);
+    
+    if (isWriteRequest(request)) {
+        ModbusWriteResult result;
+        result.timestamp = QDateTime::currentMSecsSinceEpoch();
+        result.startAddress = request.startAddress;
+        result.registerCount = request.count;
+        result.transactionId = transactionId;
+        result.success = true;
+        emit writeCompleted(result);
+        return;
+    }
+    
+    ModbusReadResult result;
+    result.timestamp = QDateTime::currentMSecsSinceEpoch();
+    result.dataType = request.dataType;
+    result.transactionId = transactionId;
+    result.success = true;
+    result.startAddress = request.startAddress;
+    result.hasValidData = true;
+    
+    if (isBitDataType(request.dataType)) {
+        // Bit responses are padded to whole bytes - trim to the requested count
+        result.bits = ModbusBitBuffer::fromPackedWords(values.constData(), request.count);
+        result.registerCount = result.bits.size();
+    } else {
+        result.rawData = ModbusRegisterBuffer(values);
+        result.registerCount = result.rawData.size();
     }
+    finalizeReadResult(result);
     
     emit readCompleted(result);
 }
 
+void ModbusManager::onNativeException(quint16 transactionId, quint8 functionCode, quint8 exceptionCode)
+{
+    auto it = m_inFlight.constFind(transactionId);
+    if (it == m_inFlight.constEnd()) {
+        return;
+    }
+    const ModbusRequest request = it.value().request;
+    const qint64 sentTime = it.value().sentTime;
+    completeTransaction(transactionId);
+    updatePacing(request.unitId, false, isDeviceBusyException(exceptionCode), sentTime);
+    
+    failTransaction(transactionId, request, QModbusDevice::ProtocolError,
+                    QString("Modbus exception 0x%1 for function code 0x%2")
+                        .arg(exceptionCode, 2, 16, QChar('0'))
+                        .arg(functionCode, 2, 16, QChar('0')));
+}
+
+void ModbusManager::onNativeMalformedResponse(quint16 transactionId, quint8 functionCode, const QString &error)
+{
+    Q_UNUSED(functionCode);
+    
+    auto it = m_inFlight.constFind(transactionId);
+    if (it == m_inFlight.constEnd()) {
+        return;
+    }
+    const ModbusRequest request = it.value().request;
+    completeTransaction(transactionId);
+    updatePacing(request.unitId, false, false);
+    
+    failTransaction(transactionId, request, QModbusDevice::ProtocolError, error);
+}
+
+void ModbusManager::onNativeStateChanged(QModbusDevice::State state)
+{
+    if (state == QModbusDevice::UnconnectedState && !m_inFlight.isEmpty()) {
+        // Outstanding transactions can no longer be answered on this socket; fail
+        // each one so callers release it instead of waiting for a reply
+        const QHash<quint16, InFlightTransaction> lost = m_inFlight;
+        m_inFlight.clear();
+        armTimeoutTimer();
+        for (auto it = lost.constBegin(); it != lost.constEnd(); ++it) {
+            failTransaction(it.key(), it.value().request, QModbusDevice::ConnectionError,
+                            "Modbus connection lost before the response arrived");
+        }
+    }
+    onStateChanged(state);
+}
+
 void ModbusManager::onWriteReady()
 {
     auto reply = qobject_cast<QModbusReply *>(sender());
@@ -744,6 +1235,9 @@ void ModbusManager::onWriteReady()
         
     auto addressInfo = m_replyAddressMap.value(reply, qMakePair(0, 0));
     ModbusWriteResult result = processWriteReply(reply, addressInfo.first, addressInfo.second);
+    result.transactionId = m_replyTransactions.take(reply);
+    updatePacing(reply->serverAddress(), result.success, isDeviceBusyReply(reply),
+                 m_inFlight.value(result.transactionId).sentTime);
     
     m_replyAddressMap.remove(reply);
     reply->deleteLater();
@@ -763,6 +1257,10 @@ void ModbusManager::onStateChanged(QModbusDevice::State state)
             qDebug() << "Connected to Modbus server (connection" << connectionCount << ")";
         }
     } else if (state == QModbusDevice::UnconnectedState) {
+        // Fail queued requests promptly rather than on the next queueRequest()
+        if (!m_requestQueue.isEmpty() && m_requestTimer) {
+            m_requestTimer->start(0);
+        }
         emit connectionStateChanged(false);
         static int disconnectionCount = 0;
         disconnectionCount++;
@@ -799,14 +1297,15 @@ ModbusReadResult ModbusManager::processReadReply(QModbusReply *reply, ModbusData
         result.registerCount = unit.valueCount();
         result.hasValidData = true;
         
-        // Extract raw data
-        for (int i = 0; i < unit.valueCount(); ++i) {
-            result.rawData.append(unit.value(i));
+        if (isBitDataType(dataType)) {
+            const QVector<quint16> values = unit.values();
+            result.bits = ModbusBitBuffer::fromBitValues(values.constData(), values.size());
+        } else {
+            // Adopt the reply's register storage instead of copying it value by value
+            result.rawData = ModbusRegisterBuffer(unit.values());
         }
         
-        // Convert and validate data
-        result.processedData = convertRawData(result.rawData, dataType);
-        validateIEEE754Data(result);
+        finalizeReadResult(result);
         
     } else {
         result.success = false;
@@ -836,20 +1335,80 @@ ModbusWriteResult ModbusManager::processWriteReply(QModbusReply *reply, int star
     return result;
 }
 
+void ModbusManager::finalizeReadResult(ModbusReadResult &result)
+{
+    // Convert and validate data
+    if (m_eagerDecode) {
+        result.processedData = isBitDataType(result.dataType) ? convertBitData(result.bits)
+                                                              : convertRawData(result.rawData.registers(), result.dataType);
+    }
+    validateIEEE754Data(result);
+}
+
+ModbusReadResult ModbusManager::sliceReadResult(const ModbusReadResult &result, int startAddress, int count,
+                                                ModbusDataType dataType)
+{
+    ModbusReadResult slice;
+    slice.success = result.success;
+    slice.errorString = result.errorString;
+    slice.errorType = result.errorType;
+    slice.timestamp = result.timestamp;
+    slice.transactionId = result.transactionId;
+    slice.startAddress = startAddress;
+    slice.dataType = dataType;
+    
+    if (!result.success) {
+        return slice;
+    }
+    
+    const int offset = startAddress - result.startAddress;
+    const int available = isBitDataType(result.dataType) ? result.bits.size() : result.rawData.size();
+    if (offset < 0 || offset + count > available) {
+        slice.success = false;
+        slice.errorType = QModbusDevice::UnknownError;
+        slice.errorString = QString("Coalesced read does not cover address %1 (+%2)").arg(startAddress).arg(count);
+        return slice;
+    }
+    
+    if (isBitDataType(result.dataType)) {
+        slice.bits = result.bits.mid(offset, count);
+    } else {
+        slice.rawData = result.rawData.mid(offset, count);
+    }
+    slice.registerCount = count;
+    slice.hasValidData = result.hasValidData;
+    finalizeReadResult(slice);
+    return slice;
+}
+
 void ModbusManager::validateIEEE754Data(ModbusReadResult &result)
 {
-    if (result.dataType == ModbusDataType::Float32 || result.dataType == ModbusDataType::Double64) {
-        for (auto it = result.processedData.begin(); it != result.processedData.end(); ++it) {
-            if (result.dataType == ModbusDataType::Float32) {
-                float value = it.value().toFloat();
-                if (isFloat32NaN(value)) result.hasNaN = true;
-                if (isFloat32Inf(value)) result.hasInf = true;
-                if (isFloat32Denormalized(value)) result.hasDenormalized = true;
-            } else if (result.dataType == ModbusDataType::Double64) {
-                double value = it.value().toDouble();
-                if (isDouble64NaN(value)) result.hasNaN = true;
-                if (isDouble64Inf(value)) result.hasInf = true;
-                if (isDouble64Denormalized(value)) result.hasDenormalized = true;
+    // Validate straight from the registers so lazy results get the same flags
+    const ModbusRegisterBuffer &rawData = result.rawData;
+    
+    if (result.dataType == ModbusDataType::Float32) {
+        // One batch pass decodes and flags non-finite values; only those are classified
+        QVarLengthArray<float, 64> values(rawData.size() / 2);
+        QVarLengthArray<quint64, 1> finiteMask((values.size() + 63) / 64);
+        RegisterDecodeKernels::decodeFloat32(rawData.constData(), rawData.size(), values.data(), finiteMask.data());
+        for (int i = 0; i < values.size(); ++i) {
+            if (!(finiteMask[i >> 6] & (quint64(1) << (i & 63)))) {
+                if (isFloat32NaN(values[i])) result.hasNaN = true;
+                else result.hasInf = true;
+            } else if (isFloat32Denormalized(values[i])) {
+                result.hasDenormalized = true;
+            }
+        }
+    } else if (result.dataType == ModbusDataType::Double64) {
+        QVarLengthArray<double, 32> values(rawData.size() / 4);
+        QVarLengthArray<quint64, 1> finiteMask((values.size() + 63) / 64);
+        RegisterDecodeKernels::decodeDouble64(rawData.constData(), rawData.size(), values.data(), finiteMask.data());
+        for (int i = 0; i < values.size(); ++i) {
+            if (!(finiteMask[i >> 6] & (quint64(1) << (i & 63)))) {
+                if (isDouble64NaN(values[i])) result.hasNaN = true;
+                else result.hasInf = true;
+            } else if (isDouble64Denormalized(values[i])) {
+                result.hasDenormalized = true;
             }
         }
     } else if (result.dataType == ModbusDataType::BOOL) {
@@ -879,38 +1438,34 @@ QVariantMap ModbusManager::convertRawData(const QVector<quint16> &rawData, Modbu
             
         case ModbusDataType::Coil:
         case ModbusDataType::DiscreteInput:
-            for (int i = 0; i < rawData.size(); ++i) {
-                convertedData[QString("bit_%1").arg(i)] = (rawData[i] != 0);
-            }
-            break;
+            return convertBitData(ModbusBitBuffer::fromBitValues(rawData.constData(), rawData.size()));
             
-        case ModbusDataType::Float32:
-            for (int i = 0; i < rawData.size(); i += 2) {
-                if (i + 1 < rawData.size()) {
-                    float value = registersToFloat32(rawData[i], rawData[i + 1]);
-                    convertedData[QString("float32_%1").arg(i / 2)] = value;
-                }
+        case ModbusDataType::Float32: {
+            QVarLengthArray<float, 64> values(rawData.size() / 2);
+            RegisterDecodeKernels::decodeFloat32(rawData.constData(), rawData.size(), values.data());
+            for (int i = 0; i < values.size(); ++i) {
+                convertedData[QString("float32_%1").arg(i)] = values[i];
             }
             break;
+        }
             
-        case ModbusDataType::Double64:
-            for (int i = 0; i < rawData.size(); i += 4) {
-                if (i + 3 < rawData.size()) {
-                    double value = registersToDouble64(rawData[i], rawData[i + 1], 
-                                                      rawData[i + 2], rawData[i + 3]);
-                    convertedData[QString("double64_%1").arg(i / 4)] = value;
-                }
+        case ModbusDataType::Double64: {
+            QVarLengthArray<double, 32> values(rawData.size() / 4);
+            RegisterDecodeKernels::decodeDouble64(rawData.constData(), rawData.size(), values.data());
+            for (int i = 0; i < values.size(); ++i) {
+                convertedData[QString("double64_%1").arg(i)] = values[i];
             }
             break;
+        }
             
-        case ModbusDataType::Long32:
-            for (int i = 0; i < rawData.size(); i += 2) {
-                if (i + 1 < rawData.size()) {
-                    qint32 value = registersToLong32(rawData[i], rawData[i + 1]);
-                    convertedData[QString("long32_%1").arg(i / 2)] = value;
-                }
+        case ModbusDataType::Long32: {
+            QVarLengthArray<qint32, 64> values(rawData.size() / 2);
+            RegisterDecodeKernels::decodeInt32(rawData.constData(), rawData.size(), values.data());
+            for (int i = 0; i < values.size(); ++i) {
+                convertedData[QString("long32_%1").arg(i)] = values[i];
             }
             break;
+        }
             
         case ModbusDataType::Long64:
             for (int i = 0; i < rawData.size(); i += 4) {
@@ -931,4 +1486,61 @@ QVariantMap ModbusManager::convertRawData(const QVector<quint16> &rawData, Modbu
     }
     
     return convertedData;
-}
\ No newline at end of file
+}
+
+QVariantMap ModbusManager::convertBitData(const ModbusBitBuffer &bits)
+{
+    // Two entries however many bits were read; consumers index the packed bytes
+    QVariantMap convertedData;
+    convertedData["bits"] = bits.toPackedBytes();
+    convertedData["bit_count"] = bits.size();
+    return convertedData;
+}
+
+// Typed on-demand view
+int ModbusReadResult::valueCount() const
+{
+    switch (dataType) {
+        case ModbusDataType::Coil:
+        case ModbusDataType::DiscreteInput:
+            return bits.size();
+        case ModbusDataType::Float32:
+        case ModbusDataType::Long32:
+            return rawData.size() / 2;
+        case ModbusDataType::Double64:
+        case ModbusDataType::Long64:
+            return rawData.size() / 4;
+        default:
+            return rawData.size();
+    }
+}
+
+QVariant ModbusReadResult::valueAt(int index) const
+{
+    if (index < 0 || index >= valueCount()) {
+        return QVariant();
+    }
+    
+    switch (dataType) {
+        case ModbusDataType::HoldingRegister:
+        case ModbusDataType::InputRegister:
+            return rawData[index];
+        case ModbusDataType::Coil:
+        case ModbusDataType::DiscreteInput:
+            return bits.testBit(index);
+        case ModbusDataType::Float32:
+            return ModbusManager::registersToFloat32(rawData[index * 2], rawData[index * 2 + 1]);
+        case ModbusDataType::Double64:
+            return ModbusManager::registersToDouble64(rawData[index * 4], rawData[index * 4 + 1],
+                                                      rawData[index * 4 + 2], rawData[index * 4 + 3]);
+        case ModbusDataType::Long32:
+            return ModbusManager::registersToLong32(rawData[index * 2], rawData[index * 2 + 1]);
+        case ModbusDataType::Long64:
+            return ModbusManager::registersToLong64(rawData[index * 4], rawData[index * 4 + 1],
+                                                    rawData[index * 4 + 2], rawData[index * 4 + 3]);
+        case ModbusDataType::BOOL:
+            return ModbusManager::registerToBool(rawData[index]);
+    }
+    
+    return QVariant();
+}
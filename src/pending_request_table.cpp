@@ -0,0 +1,119 @@
+#include "../include/pending_request_table.h"
+
+PendingRequestTable::PendingRequestTable(int initialCapacity)
+    : m_mask(0)
+    , m_size(0)
+{
+    int capacity = 8;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    m_slots.resize(capacity);
+    m_mask = capacity - 1;
+}
+
+int PendingRequestTable::homeSlot(quintptr source, qint64 requestId) const
+{
+    // Ids are sequential per worker; mix so neighbours don't cluster in one run
+    quint64 h = static_cast<quint64>(requestId) ^ (static_cast<quint64>(source) * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<int>(h & static_cast<quint64>(m_mask));
+}
+
+int PendingRequestTable::findSlot(quintptr source, qint64 requestId) const
+{
+    for (int i = homeSlot(source, requestId);; i = (i + 1) & m_mask) {
+        const Slot &slot = m_slots.at(i);
+        if (slot.source == 0) {
+            return -1;
+        }
+        if (slot.source == source && slot.requestId == requestId) {
+            return i;
+        }
+    }
+}
+
+void PendingRequestTable::insert(quintptr source, qint64 requestId, Handle handle)
+{
+    // Keep the load under 70% so probe runs stay short
+    if ((m_size + 1) * 10 > m_slots.size() * 7) {
+        grow();
+    }
+
+    int i = homeSlot(source, requestId);
+    while (m_slots.at(i).source != 0) {
+        if (m_slots.at(i).source == source && m_slots.at(i).requestId == requestId) {
+            m_slots[i].handle = handle;
+            return;
+        }
+        i = (i + 1) & m_mask;
+    }
+
+    Slot &slot = m_slots[i];
+    slot.source = source;
+    slot.requestId = requestId;
+    slot.handle = handle;
+    m_size++;
+}
+
+bool PendingRequestTable::take(quintptr source, qint64 requestId, Handle *handle)
+{
+    int hole = findSlot(source, requestId);
+    if (hole < 0) {
+        return false;
+    }
+    if (handle) {
+        *handle = m_slots.at(hole).handle;
+    }
+
+    // Backward-shift deletion: pull later entries of the run into the hole
+    // unless that would move them before their home slot
+    for (int next = (hole + 1) & m_mask; m_slots.at(next).source != 0; next = (next + 1) & m_mask) {
+        const int home = homeSlot(m_slots.at(next).source, m_slots.at(next).requestId);
+        const int distanceToNext = (next - home) & m_mask;
+        const int distanceToHole = (hole - home) & m_mask;
+        if (distanceToHole < distanceToNext) {
+            m_slots[hole] = m_slots.at(next);
+            hole = next;
+        }
+    }
+
+    m_slots[hole] = Slot();
+    m_size--;
+    return true;
+}
+
+void PendingRequestTable::clear()
+{
+    m_slots.fill(Slot());
+    m_size = 0;
+}
+
+void PendingRequestTable::removePoint(quint32 pointIndex)
+{
+    for (Slot &slot : m_slots) {
+        if (slot.source != 0 && slot.handle.pointIndex > pointIndex) {
+            slot.handle.pointIndex--;
+        }
+    }
+}
+
+void PendingRequestTable::grow()
+{
+    QVector<Slot> old;
+    old.swap(m_slots);
+    m_slots.resize(old.size() * 2);
+    m_mask = m_slots.size() - 1;
+
+    for (const Slot &slot : old) {
+        if (slot.source != 0) {
+            int i = homeSlot(slot.source, slot.requestId);
+            while (m_slots.at(i).source != 0) {
+                i = (i + 1) & m_mask;
+            }
+            m_slots[i] = slot;
+        }
+    }
+}
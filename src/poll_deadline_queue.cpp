@@ -0,0 +1,96 @@
+#include "../include/poll_deadline_queue.h"
+#include <algorithm>
+#include <functional>
+
+PollDeadlineQueue::PollDeadlineQueue()
+    : m_nextSequence(1)
+{
+}
+
+void PollDeadlineQueue::schedule(int index, qint64 deadlineMs)
+{
+    cancel(index);
+
+    // Mostly stale entries (frequent reschedules): rebuild from the live set
+    if (m_heap.size() > 2 * m_live.size() + 64) {
+        compact();
+    }
+
+    Entry entry;
+    entry.deadline = deadlineMs;
+    entry.sequence = m_nextSequence++;
+    m_heap.append(entry);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+
+    m_indexBySequence.insert(entry.sequence, index);
+    m_live.insert(index, entry.sequence);
+}
+
+void PollDeadlineQueue::cancel(int index)
+{
+    auto live = m_live.find(index);
+    if (live == m_live.end()) {
+        return;
+    }
+    m_indexBySequence.remove(live.value());
+    m_live.erase(live);
+
+    // Nothing live left: release the stale entries at once
+    if (m_live.isEmpty()) {
+        m_heap.clear();
+    }
+}
+
+void PollDeadlineQueue::clear()
+{
+    m_heap.clear();
+    m_indexBySequence.clear();
+    m_live.clear();
+}
+
+void PollDeadlineQueue::compact()
+{
+    QVector<Entry> live;
+    live.reserve(m_live.size());
+    for (const Entry &entry : m_heap) {
+        if (m_indexBySequence.contains(entry.sequence)) {
+            live.append(entry);
+        }
+    }
+    std::make_heap(live.begin(), live.end(), std::greater<Entry>());
+    m_heap.swap(live);
+}
+
+void PollDeadlineQueue::dropStaleTop()
+{
+    while (!m_heap.isEmpty() && !m_indexBySequence.contains(m_heap.first().sequence)) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+        m_heap.removeLast();
+    }
+}
+
+qint64 PollDeadlineQueue::nextDeadline()
+{
+    dropStaleTop();
+    return m_heap.isEmpty() ? -1 : m_heap.first().deadline;
+}
+
+QVector<int> PollDeadlineQueue::takeDue(qint64 nowMs, int maxCount)
+{
+    QVector<int> due;
+
+    dropStaleTop();
+    while (!m_heap.isEmpty() && m_heap.first().deadline <= nowMs && due.size() != maxCount) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+        const quint64 sequence = m_heap.last().sequence;
+        m_heap.removeLast();
+
+        const int index = m_indexBySequence.take(sequence);
+        m_live.remove(index);
+        due.append(index);
+
+        dropStaleTop();
+    }
+
+    return due;
+}
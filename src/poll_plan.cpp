@@ -0,0 +1,171 @@
+#include "../include/poll_plan.h"
+#include <QDebug>
+
+namespace {
+
+const int MAX_BLOCK_REGISTERS = 125;  // Modbus limit for one register read
+
+int registerCount(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::Float32:
+    case ModbusDataType::Long32:
+        return 2;
+    case ModbusDataType::Double64:
+    case ModbusDataType::Long64:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+// HOLDING_REGISTER points: the data_type tag or the point's own type selects the decode type
+ModbusDataType holdingDataType(const QString &dataType, ModbusDataType pointType)
+{
+    if (dataType == "Int16" || pointType == ModbusDataType::HoldingRegister) {
+        return ModbusDataType::HoldingRegister;
+    } else if (dataType == "Float32" || pointType == ModbusDataType::Float32) {
+        return ModbusDataType::Float32;
+    } else if (dataType == "Double64" || pointType == ModbusDataType::Double64) {
+        return ModbusDataType::Double64;
+    } else if (dataType == "Long32" || pointType == ModbusDataType::Long32) {
+        return ModbusDataType::Long32;
+    } else if (dataType == "Long64" || pointType == ModbusDataType::Long64) {
+        return ModbusDataType::Long64;
+    }
+    return ModbusDataType::HoldingRegister;
+}
+
+// Fallback when no register_type tag is given
+ModbusRequest::Type functionForDataType(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::InputRegister:
+        return ModbusRequest::ReadInputRegisters;
+    case ModbusDataType::Coil:
+        return ModbusRequest::ReadCoils;
+    case ModbusDataType::DiscreteInput:
+    case ModbusDataType::BOOL:
+        return ModbusRequest::ReadDiscreteInputs;
+    default:
+        return ModbusRequest::ReadHoldingRegisters;
+    }
+}
+
+// Blocks first by their data type priority tag, then individual points by
+// data type (INT16=1, FLOAT32/LONG32=2, DOUBLE64/LONG64=3)
+int pollRank(const DataAcquisitionPoint &point)
+{
+    if (point.tags.contains("block_type")) {
+        return point.tags.value("data_type_priority", "99").toInt();
+    }
+    
+    switch (point.dataType) {
+    case ModbusDataType::Float32:
+    case ModbusDataType::Long32:
+        return 1000 + 2;
+    case ModbusDataType::Double64:
+    case ModbusDataType::Long64:
+        return 1000 + 3;
+    default:
+        return 1000 + 1;
+    }
+}
+
+} // namespace
+
+PollPlan PollPlan::compile(const DataAcquisitionPoint &point, bool singleThreaded)
+{
+    PollPlan plan;
+    const QString unitIdStr = point.tags.value("unit_id", "1");
+    plan.unitId = unitIdStr.toInt();
+    plan.startAddress = point.address;
+    plan.deviceKey = QString("%1:%2:%3").arg(point.host).arg(point.port).arg(unitIdStr);
+    plan.simulated = point.tags.value("simulation_mode") == "true";
+    plan.isBlock = point.tags.value("block_type") == "optimized_read";
+    plan.rank = pollRank(point);
+
+    const QString registerType = point.tags.value("register_type");
+    const QString dataType = point.tags.value("data_type");
+
+    if (plan.isBlock) {
+        plan.count = point.tags.value("block_size").toInt();
+        if (plan.count > MAX_BLOCK_REGISTERS) {
+            qWarning() << "Block size" << plan.count << "exceeds maximum limit of 125 registers for point" << point.name
+                       << "- limiting to 125 registers";
+            plan.count = MAX_BLOCK_REGISTERS;
+        }
+        qDebug() << "Compiled block poll plan:" << point.name << "Address:" << point.address << "Size:" << plan.count
+                 << "Register Type:" << registerType << "Data Type:" << dataType << "Unit ID:" << plan.unitId;
+    }
+
+    if (singleThreaded) {
+        // ModbusManager decodes with the point's own type; individual reads are one register
+        plan.dataType = point.dataType;
+        if (!plan.isBlock) {
+            plan.count = 1;
+        }
+
+        if (registerType == "HOLDING_REGISTER") {
+            plan.functionType = ModbusRequest::ReadHoldingRegisters;
+        } else if (registerType == "INPUT_REGISTER") {
+            plan.functionType = ModbusRequest::ReadInputRegisters;
+        } else if (registerType == "COIL") {
+            plan.functionType = ModbusRequest::ReadCoils;
+        } else if (registerType == "DISCRETE_INPUT" || registerType == "STATUS") {
+            plan.functionType = ModbusRequest::ReadDiscreteInputs;
+        } else {
+            plan.functionType = functionForDataType(point.dataType);
+        }
+        return plan;
+    }
+
+    // Multi-threaded mode: register_type + data_type select the function and decode type
+    if (registerType == "HOLDING_REGISTER") {
+        plan.functionType = ModbusRequest::ReadHoldingRegisters;
+        plan.dataType = holdingDataType(dataType, point.dataType);
+    } else if (registerType == "INPUT_REGISTER") {
+        plan.functionType = ModbusRequest::ReadInputRegisters;
+        plan.dataType = point.dataType;
+    } else if (registerType == "COIL") {
+        plan.functionType = ModbusRequest::ReadCoils;
+        plan.dataType = ModbusDataType::Coil;
+    } else if (registerType == "STATUS" && !plan.isBlock && dataType != "Bool" &&
+               point.dataType == ModbusDataType::Coil) {
+        plan.functionType = ModbusRequest::ReadCoils;
+        plan.dataType = ModbusDataType::Coil;
+    } else if (registerType == "DISCRETE_INPUT" || registerType == "STATUS") {
+        plan.functionType = ModbusRequest::ReadDiscreteInputs;
+        plan.dataType = ModbusDataType::DiscreteInput;
+    } else {
+        plan.functionType = functionForDataType(point.dataType);
+        switch (plan.functionType) {
+        case ModbusRequest::ReadCoils:
+            plan.dataType = ModbusDataType::Coil;
+            break;
+        case ModbusRequest::ReadDiscreteInputs:
+            plan.dataType = ModbusDataType::DiscreteInput;
+            break;
+        default:
+            plan.dataType = point.dataType;
+            break;
+        }
+    }
+
+    if (!plan.isBlock) {
+        plan.count = plan.functionType == ModbusRequest::ReadHoldingRegisters ? registerCount(plan.dataType) : 1;
+    }
+    return plan;
+}
+
+ModbusRequest PollPlan::request(qint64 nowMs) const
+{
+    ModbusRequest request;
+    request.type = functionType;
+    request.startAddress = startAddress;
+    request.count = count;
+    request.unitId = unitId;
+    request.dataType = dataType;
+    request.requestTime = nowMs;
+    return request;
+}
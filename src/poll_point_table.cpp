@@ -0,0 +1,47 @@
+#include "../include/poll_point_table.h"
+
+void PollPointTable::append(int intervalMs, bool enabled)
+{
+    m_nextDue.append(0);
+    m_intervalMs.append(intervalMs);
+    m_lastPolled.append(0);
+    m_enabled.append(enabled ? 1 : 0);
+    m_generation.append(m_nextGeneration++);
+}
+
+void PollPointTable::setPoint(int index, int intervalMs, bool enabled)
+{
+    m_intervalMs[index] = intervalMs;
+    m_enabled[index] = enabled ? 1 : 0;
+    m_generation[index] = m_nextGeneration++;
+}
+
+void PollPointTable::removeAt(int index)
+{
+    m_nextDue.removeAt(index);
+    m_intervalMs.removeAt(index);
+    m_lastPolled.removeAt(index);
+    m_enabled.removeAt(index);
+    m_generation.removeAt(index);
+}
+
+void PollPointTable::clear()
+{
+    m_nextDue.clear();
+    m_intervalMs.clear();
+    m_lastPolled.clear();
+    m_enabled.clear();
+    m_generation.clear();
+}
+
+qint64 PollPointTable::reschedule(int index, qint64 nowMs, int minIntervalMs)
+{
+    const qint64 interval = qMax(m_intervalMs.at(index), minIntervalMs);
+    qint64 next = m_nextDue.at(index) + interval;
+    if (next <= nowMs) {
+        next = nowMs + interval;
+    }
+    m_nextDue[index] = next;
+    m_lastPolled[index] = nowMs;
+    return next;
+}
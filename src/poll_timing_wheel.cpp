@@ -0,0 +1,146 @@
+#include "../include/poll_timing_wheel.h"
+
+PollTimingWheel::PollTimingWheel(qint64 tickMs)
+    : m_tickMs(qMax<qint64>(1, tickMs))
+    , m_currentTick(0)
+    , m_started(false)
+    , m_nextGeneration(1)
+{
+}
+
+void PollTimingWheel::schedule(int id, qint64 dueMs)
+{
+    Entry entry;
+    entry.id = id;
+    entry.generation = m_nextGeneration++;
+    // Round up so an entry never fires before its due time
+    entry.dueTick = dueMs <= 0 ? 0 : (dueMs + m_tickMs - 1) / m_tickMs;
+
+    m_live.insert(id, entry.generation);
+    if (m_started) {
+        place(entry);
+    } else {
+        m_overflow.append(entry);
+    }
+}
+
+void PollTimingWheel::cancel(int id)
+{
+    m_live.remove(id);
+}
+
+void PollTimingWheel::clear()
+{
+    for (int i = 0; i < LEVEL0_SLOTS; ++i) {
+        m_level0[i].clear();
+    }
+    for (int i = 0; i < LEVEL1_SLOTS; ++i) {
+        m_level1[i].clear();
+    }
+    m_overflow.clear();
+    m_ready.clear();
+    m_live.clear();
+}
+
+bool PollTimingWheel::isLive(const Entry &entry) const
+{
+    auto live = m_live.constFind(entry.id);
+    return live != m_live.constEnd() && live.value() == entry.generation;
+}
+
+void PollTimingWheel::place(const Entry &entry)
+{
+    const qint64 delta = entry.dueTick - m_currentTick;
+    if (delta <= 0) {
+        m_ready.append(entry);
+    } else if (delta < LEVEL0_SLOTS) {
+        m_level0[entry.dueTick & (LEVEL0_SLOTS - 1)].append(entry);
+    } else if (delta < WHEEL_SPAN) {
+        m_level1[(entry.dueTick >> LEVEL0_BITS) & (LEVEL1_SLOTS - 1)].append(entry);
+    } else {
+        m_overflow.append(entry);
+    }
+}
+
+void PollTimingWheel::cascade(QVector<Entry> &slot)
+{
+    QVector<Entry> entries;
+    entries.swap(slot);
+    for (const Entry &entry : entries) {
+        if (isLive(entry)) {
+            place(entry);
+        }
+    }
+}
+
+void PollTimingWheel::rebuild(qint64 targetTick)
+{
+    // Too far behind to step tick by tick: re-place every live entry around the target
+    QVector<Entry> entries;
+    entries.swap(m_overflow);
+    for (int i = 0; i < LEVEL0_SLOTS; ++i) {
+        entries += m_level0[i];
+        m_level0[i].clear();
+    }
+    for (int i = 0; i < LEVEL1_SLOTS; ++i) {
+        entries += m_level1[i];
+        m_level1[i].clear();
+    }
+
+    m_currentTick = targetTick;
+    for (const Entry &entry : entries) {
+        if (isLive(entry)) {
+            place(entry);
+        }
+    }
+}
+
+void PollTimingWheel::expire(QVector<Entry> &slot, QVector<int> &due)
+{
+    for (const Entry &entry : slot) {
+        if (isLive(entry)) {
+            m_live.remove(entry.id);
+            due.append(entry.id);
+        }
+    }
+    slot.clear();
+}
+
+QVector<int> PollTimingWheel::advance(qint64 nowMs)
+{
+    QVector<int> due;
+    const qint64 targetTick = nowMs / m_tickMs;
+
+    if (!m_started) {
+        m_started = true;
+        rebuild(targetTick);
+    } else if (targetTick - m_currentTick >= WHEEL_SPAN) {
+        rebuild(targetTick);
+    }
+
+    // Entries scheduled after the last advance with a due time already passed
+    QVector<Entry> ready;
+    ready.swap(m_ready);
+    expire(ready, due);
+
+    while (m_currentTick < targetTick) {
+        m_currentTick++;
+
+        if ((m_currentTick & (LEVEL0_SLOTS - 1)) == 0) {
+            // Start of a level 1 slot; once per revolution also pull in the overflow
+            if ((m_currentTick & (WHEEL_SPAN - 1)) == 0) {
+                cascade(m_overflow);
+            }
+            cascade(m_level1[(m_currentTick >> LEVEL0_BITS) & (LEVEL1_SLOTS - 1)]);
+        }
+
+        expire(m_level0[m_currentTick & (LEVEL0_SLOTS - 1)], due);
+    }
+
+    // Cascades can land entries due exactly now in the ready list
+    ready.clear();
+    ready.swap(m_ready);
+    expire(ready, due);
+
+    return due;
+}
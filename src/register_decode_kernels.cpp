@@ -0,0 +1,353 @@
+#include "../include/register_decode_kernels.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define REGISTER_DECODE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const quint32 FLOAT32_EXPONENT_MASK = 0x7F800000u;
+const quint64 DOUBLE64_EXPONENT_MASK = 0x7FF0000000000000ull;
+const int BYTE_ORDER_COUNT = 4;
+
+typedef int (*Float32Kernel)(const quint16 *, int, float *, quint64 *);
+typedef int (*Int32Kernel)(const quint16 *, int, qint32 *);
+typedef int (*Double64Kernel)(const quint16 *, int, double *, quint64 *);
+
+struct KernelSet {
+    Float32Kernel float32;
+    Int32Kernel int32;
+    Double64Kernel double64;
+};
+
+void clearMask(quint64 *finiteMask, int values)
+{
+    if (finiteMask) {
+        std::memset(finiteMask, 0, sizeof(quint64) * ((values + 63) / 64));
+    }
+}
+
+// Scalar tails start at any index, so bits are set one at a time
+void setFinite(quint64 *finiteMask, int index)
+{
+    finiteMask[index >> 6] |= quint64(1) << (index & 63);
+}
+
+// ---- Scalar ----------------------------------------------------------------
+
+template <RegisterByteOrder Order>
+int float32From(const quint16 *registers, int begin, int values, float *out, quint64 *finiteMask)
+{
+    for (int i = begin; i < values; ++i) {
+        const quint32 bits = RegisterWordOrder<Order>::combine32(registers + 2 * i);
+        std::memcpy(&out[i], &bits, sizeof(float));
+        if (finiteMask && (bits & FLOAT32_EXPONENT_MASK) != FLOAT32_EXPONENT_MASK) {
+            setFinite(finiteMask, i);
+        }
+    }
+    return values;
+}
+
+template <RegisterByteOrder Order>
+int int32From(const quint16 *registers, int begin, int values, qint32 *out)
+{
+    for (int i = begin; i < values; ++i) {
+        out[i] = static_cast<qint32>(RegisterWordOrder<Order>::combine32(registers + 2 * i));
+    }
+    return values;
+}
+
+template <RegisterByteOrder Order>
+int double64From(const quint16 *registers, int begin, int values, double *out, quint64 *finiteMask)
+{
+    for (int i = begin; i < values; ++i) {
+        const quint64 bits = RegisterWordOrder<Order>::combine64(registers + 4 * i);
+        std::memcpy(&out[i], &bits, sizeof(double));
+        if (finiteMask && (bits & DOUBLE64_EXPONENT_MASK) != DOUBLE64_EXPONENT_MASK) {
+            setFinite(finiteMask, i);
+        }
+    }
+    return values;
+}
+
+template <RegisterByteOrder Order>
+int float32Scalar(const quint16 *registers, int count, float *out, quint64 *finiteMask)
+{
+    const int values = count / 2;
+    clearMask(finiteMask, values);
+    return float32From<Order>(registers, 0, values, out, finiteMask);
+}
+
+template <RegisterByteOrder Order>
+int int32Scalar(const quint16 *registers, int count, qint32 *out)
+{
+    return int32From<Order>(registers, 0, count / 2, out);
+}
+
+template <RegisterByteOrder Order>
+int double64Scalar(const quint16 *registers, int count, double *out, quint64 *finiteMask)
+{
+    const int values = count / 4;
+    clearMask(finiteMask, values);
+    return double64From<Order>(registers, 0, values, out, finiteMask);
+}
+
+#ifdef REGISTER_DECODE_X86
+
+// ---- SSE4.1 ----------------------------------------------------------------
+// Registers are host-order words, so decoding is one byte shuffle per vector
+// that puts each lane's bytes in value order; the pattern comes from the byte
+// order at compile time. Shuffles stay within 128-bit halves, so AVX2 reuses it.
+
+template <RegisterByteOrder Order, int Words>
+__attribute__((target("sse4.1")))
+__m128i laneShuffle()
+{
+    alignas(16) qint8 bytes[16];
+    for (int i = 0; i < 16; ++i) {
+        const int lane = i / (2 * Words);
+        bytes[i] = static_cast<qint8>(lane * 2 * Words + RegisterWordOrder<Order>::sourceByte(i % (2 * Words), Words));
+    }
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(bytes));
+}
+
+template <RegisterByteOrder Order>
+__attribute__((target("sse4.1")))
+int float32Sse41(const quint16 *registers, int count, float *out, quint64 *finiteMask)
+{
+    const int values = count / 2;
+    clearMask(finiteMask, values);
+    const __m128i order = laneShuffle<Order, 2>();
+    const __m128i exponent = _mm_set1_epi32(static_cast<int>(FLOAT32_EXPONENT_MASK));
+
+    int i = 0;
+    for (; i + 4 <= values; i += 4) {
+        const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(registers + 2 * i)), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+        if (finiteMask) {
+            const __m128i special = _mm_cmpeq_epi32(_mm_and_si128(v, exponent), exponent);
+            const quint64 finite = ~_mm_movemask_ps(_mm_castsi128_ps(special)) & 0xF;
+            finiteMask[i >> 6] |= finite << (i & 63);
+        }
+    }
+    return float32From<Order>(registers, i, values, out, finiteMask);
+}
+
+template <RegisterByteOrder Order>
+__attribute__((target("sse4.1")))
+int int32Sse41(const quint16 *registers, int count, qint32 *out)
+{
+    const int values = count / 2;
+    const __m128i order = laneShuffle<Order, 2>();
+    int i = 0;
+    for (; i + 4 <= values; i += 4) {
+        const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(registers + 2 * i)), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+    }
+    return int32From<Order>(registers, i, values, out);
+}
+
+template <RegisterByteOrder Order>
+__attribute__((target("sse4.1")))
+int double64Sse41(const quint16 *registers, int count, double *out, quint64 *finiteMask)
+{
+    const int values = count / 4;
+    clearMask(finiteMask, values);
+    const __m128i order = laneShuffle<Order, 4>();
+    const __m128i exponent = _mm_set1_epi64x(static_cast<long long>(DOUBLE64_EXPONENT_MASK));
+
+    int i = 0;
+    for (; i + 2 <= values; i += 2) {
+        const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(registers + 4 * i)), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+        if (finiteMask) {
+            const __m128i special = _mm_cmpeq_epi64(_mm_and_si128(v, exponent), exponent);
+            const quint64 finite = ~_mm_movemask_pd(_mm_castsi128_pd(special)) & 0x3;
+            finiteMask[i >> 6] |= finite << (i & 63);
+        }
+    }
+    return double64From<Order>(registers, i, values, out, finiteMask);
+}
+
+// ---- AVX2 ------------------------------------------------------------------
+
+template <RegisterByteOrder Order>
+__attribute__((target("avx2")))
+int float32Avx2(const quint16 *registers, int count, float *out, quint64 *finiteMask)
+{
+    const int values = count / 2;
+    clearMask(finiteMask, values);
+    const __m256i order = _mm256_broadcastsi128_si256(laneShuffle<Order, 2>());
+    const __m256i exponent = _mm256_set1_epi32(static_cast<int>(FLOAT32_EXPONENT_MASK));
+
+    int i = 0;
+    for (; i + 8 <= values; i += 8) {
+        const __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(registers + 2 * i)), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), v);
+        if (finiteMask) {
+            const __m256i special = _mm256_cmpeq_epi32(_mm256_and_si256(v, exponent), exponent);
+            const quint64 finite = ~_mm256_movemask_ps(_mm256_castsi256_ps(special)) & 0xFF;
+            finiteMask[i >> 6] |= finite << (i & 63);
+        }
+    }
+    return float32From<Order>(registers, i, values, out, finiteMask);
+}
+
+template <RegisterByteOrder Order>
+__attribute__((target("avx2")))
+int int32Avx2(const quint16 *registers, int count, qint32 *out)
+{
+    const int values = count / 2;
+    const __m256i order = _mm256_broadcastsi128_si256(laneShuffle<Order, 2>());
+    int i = 0;
+    for (; i + 8 <= values; i += 8) {
+        const __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(registers + 2 * i)), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), v);
+    }
+    return int32From<Order>(registers, i, values, out);
+}
+
+template <RegisterByteOrder Order>
+__attribute__((target("avx2")))
+int double64Avx2(const quint16 *registers, int count, double *out, quint64 *finiteMask)
+{
+    const int values = count / 4;
+    clearMask(finiteMask, values);
+    const __m256i order = _mm256_broadcastsi128_si256(laneShuffle<Order, 4>());
+    const __m256i exponent = _mm256_set1_epi64x(static_cast<long long>(DOUBLE64_EXPONENT_MASK));
+
+    int i = 0;
+    for (; i + 4 <= values; i += 4) {
+        const __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(registers + 4 * i)), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), v);
+        if (finiteMask) {
+            const __m256i special = _mm256_cmpeq_epi64(_mm256_and_si256(v, exponent), exponent);
+            const quint64 finite = ~_mm256_movemask_pd(_mm256_castsi256_pd(special)) & 0xF;
+            finiteMask[i >> 6] |= finite << (i & 63);
+        }
+    }
+    return double64From<Order>(registers, i, values, out, finiteMask);
+}
+
+#endif // REGISTER_DECODE_X86
+
+template <RegisterByteOrder Order>
+KernelSet kernelsFor(RegisterDecodeKernels::Isa isa)
+{
+    switch (isa) {
+#ifdef REGISTER_DECODE_X86
+    case RegisterDecodeKernels::Isa::Avx2:
+        return {float32Avx2<Order>, int32Avx2<Order>, double64Avx2<Order>};
+    case RegisterDecodeKernels::Isa::Sse41:
+        return {float32Sse41<Order>, int32Sse41<Order>, double64Sse41<Order>};
+#endif
+    default:
+        return {float32Scalar<Order>, int32Scalar<Order>, double64Scalar<Order>};
+    }
+}
+
+KernelSet kernelsFor(RegisterDecodeKernels::Isa isa, RegisterByteOrder order)
+{
+    switch (order) {
+    case RegisterByteOrder::CDAB:
+        return kernelsFor<RegisterByteOrder::CDAB>(isa);
+    case RegisterByteOrder::BADC:
+        return kernelsFor<RegisterByteOrder::BADC>(isa);
+    case RegisterByteOrder::DCBA:
+        return kernelsFor<RegisterByteOrder::DCBA>(isa);
+    default:
+        return kernelsFor<RegisterByteOrder::ABCD>(isa);
+    }
+}
+
+// Chosen on first use, one set per byte order; the CPU doesn't change under us
+struct ActiveKernels {
+    KernelSet byOrder[BYTE_ORDER_COUNT];
+
+    ActiveKernels()
+    {
+        for (int order = 0; order < BYTE_ORDER_COUNT; ++order) {
+            byOrder[order] = kernelsFor(RegisterDecodeKernels::activeIsa(), RegisterByteOrder(order));
+        }
+    }
+};
+
+const KernelSet &activeKernels(RegisterByteOrder order)
+{
+    static const ActiveKernels kernels;
+    return kernels.byOrder[static_cast<int>(order)];
+}
+
+} // namespace
+
+bool RegisterDecodeKernels::isSupported(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar:
+        return true;
+#ifdef REGISTER_DECODE_X86
+    case Isa::Sse41:
+        return __builtin_cpu_supports("sse4.1");
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+RegisterDecodeKernels::Isa RegisterDecodeKernels::activeIsa()
+{
+    static const Isa isa = isSupported(Isa::Avx2) ? Isa::Avx2
+                         : isSupported(Isa::Sse41) ? Isa::Sse41
+                         : Isa::Scalar;
+    return isa;
+}
+
+const char *RegisterDecodeKernels::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Avx2:
+        return "avx2";
+    case Isa::Sse41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+int RegisterDecodeKernels::decodeFloat32(const quint16 *registers, int count, float *out, quint64 *finiteMask,
+                                         RegisterByteOrder order)
+{
+    return activeKernels(order).float32(registers, count, out, finiteMask);
+}
+
+int RegisterDecodeKernels::decodeInt32(const quint16 *registers, int count, qint32 *out, RegisterByteOrder order)
+{
+    return activeKernels(order).int32(registers, count, out);
+}
+
+int RegisterDecodeKernels::decodeDouble64(const quint16 *registers, int count, double *out, quint64 *finiteMask,
+                                          RegisterByteOrder order)
+{
+    return activeKernels(order).double64(registers, count, out, finiteMask);
+}
+
+int RegisterDecodeKernels::decodeFloat32(Isa isa, const quint16 *registers, int count, float *out, quint64 *finiteMask,
+                                         RegisterByteOrder order)
+{
+    return kernelsFor(isa, order).float32(registers, count, out, finiteMask);
+}
+
+int RegisterDecodeKernels::decodeInt32(Isa isa, const quint16 *registers, int count, qint32 *out, RegisterByteOrder order)
+{
+    return kernelsFor(isa, order).int32(registers, count, out);
+}
+
+int RegisterDecodeKernels::decodeDouble64(Isa isa, const quint16 *registers, int count, double *out, quint64 *finiteMask,
+                                          RegisterByteOrder order)
+{
+    return kernelsFor(isa, order).double64(registers, count, out, finiteMask);
+}
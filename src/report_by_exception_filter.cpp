@@ -0,0 +1,195 @@
+#include "../include/report_by_exception_filter.h"
+#include <QStringList>
+#include <QtMath>
+
+QString ReportDeadband::toString() const
+{
+    return QString("%1:%2:%3").arg(absolute).arg(percent).arg(maxSilenceMs);
+}
+
+ReportDeadband ReportDeadband::fromString(const QString &text, bool *ok)
+{
+    ReportDeadband deadband;
+    const QStringList fields = text.trimmed().split(':');
+    bool valid = fields.size() <= 3;
+
+    if (valid && fields.size() > 0 && !fields.at(0).isEmpty()) {
+        bool fieldOk = false;
+        deadband.absolute = fields.at(0).toDouble(&fieldOk);
+        valid = fieldOk && deadband.absolute >= 0;
+    }
+    if (valid && fields.size() > 1 && !fields.at(1).isEmpty()) {
+        bool fieldOk = false;
+        deadband.percent = fields.at(1).toDouble(&fieldOk);
+        valid = fieldOk && deadband.percent >= 0;
+    }
+    if (valid && fields.size() > 2 && !fields.at(2).isEmpty()) {
+        bool fieldOk = false;
+        deadband.maxSilenceMs = fields.at(2).toInt(&fieldOk);
+        valid = fieldOk && deadband.maxSilenceMs >= 0;
+    }
+
+    if (ok) {
+        *ok = valid;
+    }
+    return valid ? deadband : ReportDeadband();
+}
+
+void ReportByExceptionFilter::setDeadband(const QString &pointName, const ReportDeadband &deadband)
+{
+    if (!deadband.isEnabled()) {
+        remove(pointName);
+        return;
+    }
+
+    int slot = m_slots.value(pointName, -1);
+    if (slot < 0) {
+        slot = m_names.size();
+        m_slots.insert(pointName, slot);
+        m_names.append(pointName);
+        m_lastValue.append(0);
+        m_lastReportMs.append(0);
+        m_absolute.append(0);
+        m_percent.append(0);
+        m_maxSilenceMs.append(0);
+        m_kind.append(NoValue);
+    }
+    m_absolute[slot] = deadband.absolute;
+    m_percent[slot] = deadband.percent;
+    m_maxSilenceMs[slot] = deadband.maxSilenceMs;
+}
+
+void ReportByExceptionFilter::remove(const QString &pointName)
+{
+    const int slot = m_slots.value(pointName, -1);
+    if (slot < 0) {
+        return;
+    }
+    m_slots.remove(pointName);
+    m_lastOpaque.remove(slot);
+
+    // Move the last slot into the hole so the arrays stay dense
+    const int last = m_names.size() - 1;
+    if (slot != last) {
+        m_names[slot] = m_names.at(last);
+        m_lastValue[slot] = m_lastValue.at(last);
+        m_lastReportMs[slot] = m_lastReportMs.at(last);
+        m_absolute[slot] = m_absolute.at(last);
+        m_percent[slot] = m_percent.at(last);
+        m_maxSilenceMs[slot] = m_maxSilenceMs.at(last);
+        m_kind[slot] = m_kind.at(last);
+        m_slots[m_names.at(slot)] = slot;
+        if (m_lastOpaque.contains(last)) {
+            m_lastOpaque.insert(slot, m_lastOpaque.take(last));
+        }
+    }
+
+    m_names.removeLast();
+    m_lastValue.removeLast();
+    m_lastReportMs.removeLast();
+    m_absolute.removeLast();
+    m_percent.removeLast();
+    m_maxSilenceMs.removeLast();
+    m_kind.removeLast();
+}
+
+void ReportByExceptionFilter::clear()
+{
+    m_slots.clear();
+    m_names.clear();
+    m_lastValue.clear();
+    m_lastReportMs.clear();
+    m_absolute.clear();
+    m_percent.clear();
+    m_maxSilenceMs.clear();
+    m_kind.clear();
+    m_lastOpaque.clear();
+}
+
+bool ReportByExceptionFilter::shouldReport(const QString &pointName, const QVariant &value, qint64 timestampMs)
+{
+    const int slot = m_slots.isEmpty() ? -1 : m_slots.value(pointName, -1);
+    if (slot < 0 || !value.isValid()) {
+        ++m_reported;
+        return true;
+    }
+
+    const ValueKind kind = kindOf(value);
+    const double number = kind == Opaque ? 0 : value.toDouble();
+    const qint64 silentMs = timestampMs - m_lastReportMs.at(slot);
+    bool report = m_kind.at(slot) != kind || silentMs < 0 ||
+                  (m_maxSilenceMs.at(slot) > 0 && silentMs >= m_maxSilenceMs.at(slot));
+
+    if (!report) {
+        const double last = m_lastValue.at(slot);
+        switch (kind) {
+        case Numeric: {
+            const double band = qMax(m_absolute.at(slot), m_percent.at(slot) / 100.0 * qAbs(last));
+            if (qIsNaN(number) || qIsNaN(last)) {
+                report = qIsNaN(number) != qIsNaN(last);
+            } else {
+                report = band > 0 ? qAbs(number - last) > band : number != last;
+            }
+            break;
+        }
+        case Boolean:
+            report = number != last;
+            break;
+        case Opaque:
+            report = value != m_lastOpaque.value(slot);
+            break;
+        case NoValue:
+            break;
+        }
+    }
+
+    if (!report) {
+        ++m_suppressed;
+        return false;
+    }
+    record(slot, kind, value, number, timestampMs);
+    ++m_reported;
+    return true;
+}
+
+ReportFilterMetrics ReportByExceptionFilter::metrics() const
+{
+    ReportFilterMetrics metrics;
+    metrics.trackedPoints = m_names.size();
+    metrics.reported = m_reported;
+    metrics.suppressed = m_suppressed;
+    return metrics;
+}
+
+ReportByExceptionFilter::ValueKind ReportByExceptionFilter::kindOf(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::UnknownType:
+        return NoValue;
+    case QMetaType::Bool:
+        return Boolean;
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return Numeric;
+    default:
+        return Opaque;
+    }
+}
+
+void ReportByExceptionFilter::record(int slot, ValueKind kind, const QVariant &value, double number, qint64 timestampMs)
+{
+    m_kind[slot] = kind;
+    m_lastValue[slot] = number;
+    m_lastReportMs[slot] = timestampMs;
+    if (kind == Opaque) {
+        m_lastOpaque.insert(slot, value);
+    } else {
+        m_lastOpaque.remove(slot);
+    }
+}
@@ -1,4 +1,5 @@
 #include "../include/scada_core_service.h"
+#include "../include/block_decode_plan.h"
 #include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -16,8 +17,11 @@
 #include <QThreadPool>
 #include <QTime>
 #include <QRandomGenerator>
+#include <QVarLengthArray>
+#include <cerrno>
 #include <cstring>
 #include <algorithm>
+#include <limits>
 
 ScadaCoreService::ScadaCoreService(QObject *parent)
     : QObject(parent)
@@ -25,7 +29,13 @@ ScadaCoreService::ScadaCoreService(QObject *parent)
     , m_workerManager(nullptr)
     , m_telegrafSocketPath("/tmp/telegraf.sock")
     , m_serviceRunning(false)
-    , m_currentPointIndex(0)
+    , m_minPollIntervalMs(100)
+    , m_servicePollingActive(false)
+    , m_pollScheduleDirty(false)
+    , m_pollPlanGeneration(0)
+    , m_coverageIndexDirty(false)
+    , m_sinkDrainTimer(nullptr)
+    , m_acquisitionPauses(0)
     , m_dataPointsMutex()
     , m_statisticsMutex()
     , m_requestTrackingMutex()
@@ -49,10 +59,15 @@ ScadaCoreService::ScadaCoreService(QObject *parent)
     
     // Initialize components
     m_pollTimer = new QTimer(this);
+    m_pollTimer->setSingleShot(true);
+    m_pollTimer->setTimerType(Qt::PreciseTimer);
+    m_sinkDrainTimer = new QTimer(this);
+    m_sinkDrainTimer->setSingleShot(true);
     m_workerManager = new ModbusWorkerManager(this);
     
     // Connect worker manager signals with thread-safe queued connections
     connect(m_pollTimer, &QTimer::timeout, this, &ScadaCoreService::onPollTimer, Qt::QueuedConnection);
+    connect(m_sinkDrainTimer, &QTimer::timeout, this, &ScadaCoreService::drainSinkQueue);
     
     // Connect worker signals for request completion
     connect(m_workerManager, &ModbusWorkerManager::workerCreated,
@@ -71,6 +86,12 @@ ScadaCoreService::ScadaCoreService(QObject *parent)
             this, &ScadaCoreService::onParallelProcessingCompleted, Qt::QueuedConnection);
     connect(m_dataProcessor, &ParallelDataProcessor::taskFailed,
             this, &ScadaCoreService::onParallelProcessingFailed, Qt::QueuedConnection);
+    connect(m_dataProcessor, &ParallelDataProcessor::taskDiscarded,
+            this, &ScadaCoreService::onParallelProcessingDiscarded, Qt::QueuedConnection);
+    
+    // Stage queue bounds until a deployment config replaces them
+    m_dataProcessor->setQueueLimits(m_deploymentConfig.decodeQueueCapacity, m_deploymentConfig.decodeQueuePolicy);
+    m_sinkQueue.configure(m_deploymentConfig.sinkQueueCapacity, m_deploymentConfig.sinkQueuePolicy);
     
     // Initialize statistics
     resetStatistics();
@@ -128,7 +149,6 @@ bool ScadaCoreService::startService()
     
     // Initialize service state
     m_serviceRunning = true;
-    m_currentPointIndex = 0;
     m_statistics.serviceStartTime = QDateTime::currentMSecsSinceEpoch();
     
     // Initialize based on threading mode
@@ -137,90 +157,85 @@ bool ScadaCoreService::startService()
             const auto &firstPoint = m_dataPoints.first();
             m_singleThreadModbusManager = new ModbusManager(this);
             m_singleThreadModbusManager->initializeClient();
+            m_singleThreadModbusManager->setMaxInFlight(m_deploymentConfig.singleThreadMaxInFlight);
             m_singleThreadModbusManager->connectToServer(firstPoint.host, firstPoint.port);
             
             connect(m_singleThreadModbusManager, &ModbusManager::readCompleted,
                     this, &ScadaCoreService::onSingleThreadReadCompleted);
             connect(m_singleThreadModbusManager, &ModbusManager::errorOccurred,
                     this, &ScadaCoreService::errorOccurred);
+            connect(m_singleThreadModbusManager, &ModbusManager::connectionStateChanged,
+                    this, [this](bool connected) {
+                        if (!connected) {
+                            resetBitFrames(QString());
+                        }
+                    });
         }
     } else {
         // Multi-threaded mode: create workers for all configured devices
-        QSet<QString> uniqueDevices;
-        for (const auto &point : m_dataPoints) {
-            QString unitIdStr = point.tags.value("unit_id", "1");
-            int unitId = unitIdStr.toInt();
-            QString deviceKey = QString("%1:%2:%3").arg(point.host).arg(point.port).arg(unitId);
-            uniqueDevices.insert(deviceKey);
-        }
-        
-        // Create workers and assign data points to each
+        // Group data points by worker key (host:port:unit, or host:port when unit IDs
+        // behind one gateway share a connection)
         QMap<QString, QVector<DataAcquisitionPoint>> deviceDataPoints;
-        
-        // Group data points by device
         for (const auto &point : m_dataPoints) {
             QString unitIdStr = point.tags.value("unit_id", "1");
             int unitId = unitIdStr.toInt();
-            QString deviceKey = QString("%1:%2:%3").arg(point.host).arg(point.port).arg(unitId);
+            QString deviceKey = m_workerManager->deviceKeyFor(point.host, point.port, unitId);
             deviceDataPoints[deviceKey].append(point);
         }
         
-        for (const QString &deviceKey : uniqueDevices) {
-            QStringList parts = deviceKey.split(":");
-            if (parts.size() >= 3) {
-                QString host = parts[0];
-                int port = parts[1].toInt();
-                int unitId = parts[2].toInt();
+        // Create workers and assign data points to each
+        for (auto group = deviceDataPoints.constBegin(); group != deviceDataPoints.constEnd(); ++group) {
+            const QString &deviceKey = group.key();
+            const QVector<DataAcquisitionPoint> &points = group.value();
+            const DataAcquisitionPoint &firstPoint = points.first();
+            QString host = firstPoint.host;
+            int port = firstPoint.port;
+            int unitId = firstPoint.tags.value("unit_id", "1").toInt();
+            
+            ModbusWorker* worker = m_workerManager->getOrCreateWorker(host, port, unitId);
+            if (worker) {
+                connectWorkerSignals(worker);
                 
-                ModbusWorker* worker = m_workerManager->getOrCreateWorker(host, port, unitId);
-                if (worker) {
-                    connectWorkerSignals(worker);
-                    
-                    // Assign data points to this worker
-                    if (deviceDataPoints.contains(deviceKey)) {
-                        const QVector<DataAcquisitionPoint> &points = deviceDataPoints[deviceKey];
-                        
-                        // Set data point count first
-                        QMetaObject::invokeMethod(worker, "setDataPointCount", Qt::QueuedConnection,
-                                                  Q_ARG(int, points.size()));
-                        
-                        // Add each data point individually
-                        for (const auto &point : points) {
-                            // Convert QMap to QVariantMap for cross-thread invocation
-                            QVariantMap tagsVariant;
-                            for (auto it = point.tags.constBegin(); it != point.tags.constEnd(); ++it) {
-                                tagsVariant[it.key()] = it.value();
-                            }
-                            
-                            QMetaObject::invokeMethod(worker, "addDataPointByName", Qt::QueuedConnection,
-                                                      Q_ARG(QString, point.name),
-                                                      Q_ARG(QString, point.host),
-                                                      Q_ARG(int, point.port),
-                                                      Q_ARG(int, point.unitId),
-                                                      Q_ARG(int, point.address),
-                                                      Q_ARG(int, static_cast<int>(point.dataType)),
-                                                      Q_ARG(int, point.pollInterval),
-                                                      Q_ARG(QString, point.measurement),
-                                                      Q_ARG(bool, point.enabled),
-                                                      Q_ARG(QVariantMap, tagsVariant));
-                        }
-                        
-                        // Enable automatic polling for this worker
-                        QMetaObject::invokeMethod(worker, "enableAutomaticPolling", Qt::QueuedConnection,
-                                                  Q_ARG(bool, true));
-                        
-                        qDebug() << "Assigned" << points.size() << "data points to worker" << deviceKey;
+                // Assign data points to this worker; a shared gateway worker gets
+                // the points of every unit ID behind it. Set data point count first
+                QMetaObject::invokeMethod(worker, "setDataPointCount", Qt::QueuedConnection,
+                                          Q_ARG(int, points.size()));
+                
+                // Add each data point individually
+                for (const auto &point : points) {
+                    // Convert QMap to QVariantMap for cross-thread invocation
+                    QVariantMap tagsVariant;
+                    for (auto it = point.tags.constBegin(); it != point.tags.constEnd(); ++it) {
+                        tagsVariant[it.key()] = it.value();
                     }
+                    
+                    QMetaObject::invokeMethod(worker, "addDataPointByName", Qt::QueuedConnection,
+                                              Q_ARG(QString, point.name),
+                                              Q_ARG(QString, point.host),
+                                              Q_ARG(int, point.port),
+                                              Q_ARG(int, point.unitId),
+                                              Q_ARG(int, point.address),
+                                              Q_ARG(int, static_cast<int>(point.dataType)),
+                                              Q_ARG(int, point.pollInterval),
+                                              Q_ARG(QString, point.measurement),
+                                              Q_ARG(bool, point.enabled),
+                                              Q_ARG(QVariantMap, tagsVariant));
                 }
+                
+                // Enable automatic polling for this worker
+                QMetaObject::invokeMethod(worker, "enableAutomaticPolling", Qt::QueuedConnection,
+                                          Q_ARG(bool, true));
+                
+                qDebug() << "Assigned" << points.size() << "data points to worker" << deviceKey;
             }
         }
         // Workers will be started automatically via delayed startup mechanism in getOrCreateWorker()
         qDebug() << "✅ All workers created and will start via delayed startup mechanism";
         
         // Enable load balancing for multi-device scenarios
-        if (uniqueDevices.size() > 1) {
+        if (deviceDataPoints.size() > 1) {
             m_workerManager->setLoadBalancingEnabled(true);
-            qDebug() << "🔄 Load balancing enabled for" << uniqueDevices.size() << "devices";
+            qDebug() << "🔄 Load balancing enabled for" << deviceDataPoints.size() << "devices";
         } else {
             m_workerManager->setLoadBalancingEnabled(false);
             qDebug() << "Load balancing disabled for single device";
@@ -234,11 +249,13 @@ bool ScadaCoreService::startService()
             // Single-threaded mode: use ScadaCoreService poll timer
             optimizePollInterval();
             
-            // Add debug output for timer interval
-            qDebug() << "Poll timer interval before start:" << m_pollTimer->interval() << "ms";
-            m_pollTimer->start();
-            qDebug() << "Poll timer started. Active:" << m_pollTimer->isActive() << "Interval:" << m_pollTimer->interval() << "ms";
-            qDebug() << "Started optimized single-threaded polling timer";
+            {
+                QMutexLocker locker(&m_dataPointsMutex);
+                rebuildPollSchedule();
+            }
+            m_servicePollingActive = true;
+            armPollTimer();
+            qDebug() << "Started deadline-driven single-threaded polling for" << m_pollSchedule.size() << "points";
         } else {
             // Multi-threaded mode: workers handle their own polling, don't start ScadaCoreService poll timer
             qDebug() << "Multi-threaded mode: Workers handle polling independently. ScadaCoreService poll timer disabled.";
@@ -290,6 +307,7 @@ void ScadaCoreService::stopService()
     qDebug() << "Stopping SCADA Core Service...";
     
     m_serviceRunning = false;
+    m_servicePollingActive = false;
     m_pollTimer->stop();
     
     if (m_useSingleThreadedMode) {
@@ -348,6 +366,8 @@ void ScadaCoreService::optimizePollInterval()
         return;
     }
     
+    QMutexLocker locker(&m_dataPointsMutex);
+    
     int optimalInterval;
     
     if (m_useSingleThreadedMode) {
@@ -376,14 +396,15 @@ void ScadaCoreService::optimizePollInterval()
             optimalInterval = 500; // Moderate for many points
         }
         
-        qDebug() << "🔧 Single-threaded mode: optimized poll interval to" << optimalInterval << "ms for" << effectivePollingPoints << "effective polling points (" << m_dataPoints.size() << "total points)";
+        qDebug() << "🔧 Single-threaded mode: minimum point poll interval" << optimalInterval << "ms for" << effectivePollingPoints << "effective polling points (" << m_dataPoints.size() << "total points)";
     } else {
         // Multi-threaded mode: standard interval since workers handle concurrency
         optimalInterval = 1000; // Standard 1 second interval
-        qDebug() << "🔧 Multi-threaded mode: using standard poll interval of" << optimalInterval << "ms";
+        qDebug() << "🔧 Multi-threaded mode: using standard minimum point poll interval of" << optimalInterval << "ms";
     }
     
-    m_pollTimer->setInterval(optimalInterval);
+    // The poll timer is armed per deadline; the interval is a floor on how often one point is polled
+    m_minPollIntervalMs = optimalInterval;
 }
 
 void ScadaCoreService::enableLoadBalancing(bool enabled)
@@ -538,6 +559,26 @@ int ScadaCoreService::getActiveProcessingTasks() const
     return m_dataProcessor ? m_dataProcessor->getActiveTaskCount() : 0;
 }
 
+ScadaCoreService::PipelineMetrics ScadaCoreService::getPipelineMetrics() const
+{
+    PipelineMetrics metrics;
+    if (m_dataProcessor) {
+        metrics.decodeQueue = m_dataProcessor->getQueueMetrics();
+    }
+    metrics.sinkQueue = m_sinkQueue.metrics();
+    metrics.acquisitionPauses = m_acquisitionPauses;
+    {
+        QMutexLocker locker(&m_reportFilterMutex);
+        metrics.reportFilter = m_reportFilter.metrics();
+    }
+    return metrics;
+}
+
+bool ScadaCoreService::isPipelineBackpressured() const
+{
+    return m_sinkQueue.isBackpressured() || (m_dataProcessor && m_dataProcessor->isBackpressured());
+}
+
 void ScadaCoreService::setDeploymentConfig(const DeploymentConfig &config)
 {
     m_deploymentConfig = config;
@@ -547,6 +588,22 @@ void ScadaCoreService::setDeploymentConfig(const DeploymentConfig &config)
     enableLoadBalancing(config.enableLoadBalancing);
     enablePerformanceMonitoring(config.enablePerformanceMonitoring);
     
+    // Gateway sharing and loop sharding only affect workers created afterwards
+    if (m_workerManager) {
+        m_workerManager->setGatewayModeEnabled(config.shareGatewayConnections);
+        m_workerManager->setGatewayConcurrencyLimit(config.gatewayConcurrencyLimit);
+        m_workerManager->setEventLoopSharding(config.shardEventLoops, config.ioLoopThreads);
+    }
+    
+    if (m_singleThreadModbusManager) {
+        m_singleThreadModbusManager->setMaxInFlight(config.singleThreadMaxInFlight);
+    }
+    
+    if (m_dataProcessor) {
+        m_dataProcessor->setQueueLimits(config.decodeQueueCapacity, config.decodeQueuePolicy);
+    }
+    m_sinkQueue.configure(config.sinkQueueCapacity, config.sinkQueuePolicy);
+    
     // Note: maxWorkerThreads will be applied when creating new worker manager
     // Other settings like connectionTimeoutMs and maxRetryAttempts can be used
     // by individual components as needed
@@ -557,6 +614,56 @@ ScadaCoreService::DeploymentConfig ScadaCoreService::getDeploymentConfig() const
     return m_deploymentConfig;
 }
 
+namespace {
+
+StageQueuePolicy stageQueuePolicyFromString(const QString &name)
+{
+    if (name == "drop_oldest") {
+        return StageQueuePolicy::DropOldest;
+    } else if (name == "coalesce") {
+        return StageQueuePolicy::CoalesceLatest;
+    }
+    return StageQueuePolicy::Block;
+}
+
+QString stageQueuePolicyName(StageQueuePolicy policy)
+{
+    switch (policy) {
+    case StageQueuePolicy::DropOldest:
+        return "drop_oldest";
+    case StageQueuePolicy::CoalesceLatest:
+        return "coalesce";
+    case StageQueuePolicy::Block:
+        break;
+    }
+    return "block";
+}
+
+// Stored points carry their compiled decoders, even when not built by DatabaseManager:
+// the value decoder for the point's type and byte order, and a plan for blocks
+DataAcquisitionPoint withCompiledDecoders(const DataAcquisitionPoint &point)
+{
+    DataAcquisitionPoint stored = point;
+    stored.valueDecoder = BlockDecodePlan::valueDecoder(stored.dataType, stored.byteOrder);
+    if (!stored.blockDecodePlan && stored.tags.value("block_type") == "optimized_read") {
+        stored.blockDecodePlan = BlockDecodePlan::compile(stored);
+    }
+    return stored;
+}
+
+// Discrete states report on every change; only the heartbeat applies to them
+ReportDeadband reportDeadbandFor(const DataAcquisitionPoint &point)
+{
+    ReportDeadband deadband = point.deadband;
+    if (isBitDataType(point.dataType) || point.dataType == ModbusDataType::BOOL) {
+        deadband.absolute = 0;
+        deadband.percent = 0;
+    }
+    return deadband;
+}
+
+} // namespace
+
 bool ScadaCoreService::loadConfigFromFile(const QString &filePath)
 {
     QFile file(filePath);
@@ -595,6 +702,16 @@ bool ScadaCoreService::loadConfigFromFile(const QString &filePath)
     config.connectionTimeoutMs = obj["connectionTimeoutMs"].toInt(5000);
     config.maxRetryAttempts = obj["maxRetryAttempts"].toInt(3);
     config.configFilePath = obj["configFilePath"].toString("scada_config.json");
+    config.shareGatewayConnections = obj["shareGatewayConnections"].toBool(false);
+    config.gatewayConcurrencyLimit = obj["gatewayConcurrencyLimit"].toInt(1);
+    config.pollDispatchBudget = obj["pollDispatchBudget"].toInt(64);
+    config.singleThreadMaxInFlight = obj["singleThreadMaxInFlight"].toInt(1);
+    config.shardEventLoops = obj["shardEventLoops"].toBool(false);
+    config.ioLoopThreads = obj["ioLoopThreads"].toInt(0);
+    config.decodeQueueCapacity = obj["decodeQueueCapacity"].toInt(1024);
+    config.decodeQueuePolicy = stageQueuePolicyFromString(obj["decodeQueuePolicy"].toString("block"));
+    config.sinkQueueCapacity = obj["sinkQueueCapacity"].toInt(4096);
+    config.sinkQueuePolicy = stageQueuePolicyFromString(obj["sinkQueuePolicy"].toString("block"));
     
     setDeploymentConfig(config);
     return true;
@@ -627,6 +744,16 @@ bool ScadaCoreService::saveConfigToFile(const QString &filePath) const
     obj["connectionTimeoutMs"] = m_deploymentConfig.connectionTimeoutMs;
     obj["maxRetryAttempts"] = m_deploymentConfig.maxRetryAttempts;
     obj["configFilePath"] = m_deploymentConfig.configFilePath;
+    obj["shareGatewayConnections"] = m_deploymentConfig.shareGatewayConnections;
+    obj["gatewayConcurrencyLimit"] = m_deploymentConfig.gatewayConcurrencyLimit;
+    obj["pollDispatchBudget"] = m_deploymentConfig.pollDispatchBudget;
+    obj["singleThreadMaxInFlight"] = m_deploymentConfig.singleThreadMaxInFlight;
+    obj["shardEventLoops"] = m_deploymentConfig.shardEventLoops;
+    obj["ioLoopThreads"] = m_deploymentConfig.ioLoopThreads;
+    obj["decodeQueueCapacity"] = m_deploymentConfig.decodeQueueCapacity;
+    obj["decodeQueuePolicy"] = stageQueuePolicyName(m_deploymentConfig.decodeQueuePolicy);
+    obj["sinkQueueCapacity"] = m_deploymentConfig.sinkQueueCapacity;
+    obj["sinkQueuePolicy"] = stageQueuePolicyName(m_deploymentConfig.sinkQueuePolicy);
     
     QJsonDocument doc(obj);
     
@@ -653,14 +780,20 @@ void ScadaCoreService::addDataPoint(const DataAcquisitionPoint &point)
     // Check if point already exists
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         if (m_dataPoints[i].name == point.name) {
-            m_dataPoints[i] = point;
+            untrackReportDeadbands(m_dataPoints[i]);
+            m_dataPoints[i] = withCompiledDecoders(point);
+            trackReportDeadbands(m_dataPoints[i]);
+            m_pollPoints.setPoint(i, point.pollInterval, point.enabled);
+            invalidatePollSchedule();
             qDebug() << "Updated existing data point:" << point.name;
             return;
         }
     }
     
-    m_dataPoints.append(point);
-    m_lastPollTimes[point.name] = 0; // Initialize last poll time
+    m_dataPoints.append(withCompiledDecoders(point));
+    trackReportDeadbands(m_dataPoints.last());
+    m_pollPoints.append(point.pollInterval, point.enabled); // Due immediately
+    invalidatePollSchedule();
     qDebug() << "Added new data point:" << point.name << "at" << point.host << ":" << point.port;
 }
 
@@ -670,8 +803,16 @@ void ScadaCoreService::removeDataPoint(const QString &pointName)
     
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         if (m_dataPoints[i].name == pointName) {
+            untrackReportDeadbands(m_dataPoints[i]);
             m_dataPoints.removeAt(i);
-            m_lastPollTimes.remove(pointName);
+            m_pollPoints.removeAt(i);
+            m_previousBitFrames.remove(pointName);
+            {
+                // Reads in flight for later points follow them down one index
+                QMutexLocker trackingLocker(&m_requestTrackingMutex);
+                m_pendingReadRequests.removePoint(static_cast<quint32>(i));
+            }
+            invalidatePollSchedule();
             qDebug() << "Removed data point:" << pointName;
             return;
         }
@@ -684,7 +825,11 @@ void ScadaCoreService::updateDataPoint(const QString &pointName, const DataAcqui
     
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         if (m_dataPoints[i].name == pointName) {
-            m_dataPoints[i] = point;
+            untrackReportDeadbands(m_dataPoints[i]);
+            m_dataPoints[i] = withCompiledDecoders(point);
+            trackReportDeadbands(m_dataPoints[i]);
+            m_pollPoints.setPoint(i, point.pollInterval, point.enabled);
+            invalidatePollSchedule();
             qDebug() << "Updated data point:" << pointName;
             return;
         }
@@ -702,7 +847,16 @@ void ScadaCoreService::clearDataPoints()
     QMutexLocker locker(&m_dataPointsMutex);
     
     m_dataPoints.clear();
-    m_lastPollTimes.clear();
+    m_pollPoints.clear();
+    m_previousBitFrames.clear();
+    {
+        QMutexLocker filterLocker(&m_reportFilterMutex);
+        m_reportFilter.clear();
+    }
+    m_pollSchedule.clear();
+    m_pollPlans.clear();
+    m_blockCoverage.clear();
+    m_coverageIndexDirty = false;
     qDebug() << "Cleared all data points";
 }
 
@@ -725,7 +879,6 @@ ScadaCoreService::ServiceStatistics ScadaCoreService::getStatistics() const
 void ScadaCoreService::resetStatistics()
 {
     m_statistics = ServiceStatistics();
-    m_responseTimers.clear();
 }
 
 // Modbus write operations with priority support
@@ -1008,196 +1161,184 @@ void ScadaCoreService::connectWorkerSignals(ModbusWorker* worker)
 
 void ScadaCoreService::onPollTimer()
 {
-    // Reduce debug verbosity - only log every 50 poll cycles (5 seconds at 100ms intervals)
+    // Reduce debug verbosity - only log every 50 poll cycles
     static int pollCount = 0;
     pollCount++;
     
     if (pollCount % 50 == 0) {
-        qDebug() << "ScadaCoreService::onPollTimer() - Poll cycle" << pollCount << "- Service running:" << m_serviceRunning << "Data points count:" << m_dataPoints.size();
+        QMutexLocker locker(&m_dataPointsMutex);
+        qDebug() << "ScadaCoreService::onPollTimer() - Poll cycle" << pollCount << "- Service running:" << m_serviceRunning
+                 << "Scheduled points:" << m_pollSchedule.size();
     }
     
-    if (!m_serviceRunning || m_dataPoints.isEmpty()) {
-        if (pollCount % 50 == 0) {
-            qDebug() << "ScadaCoreService::onPollTimer() - Skipping poll: service running =" << m_serviceRunning << ", data points =" << m_dataPoints.size();
+    if (!m_serviceRunning) {
+        return;
+    }
+    
+    // Decode or sink can't keep up: leave points due and look again shortly,
+    // so acquisition slows down instead of queueing without bound
+    if (isPipelineBackpressured()) {
+        m_acquisitionPauses++;
+        if (m_acquisitionPauses % 50 == 1) {
+            qWarning() << "Pipeline backpressure, deferring polls - Sink queue:" << m_sinkQueue.size()
+                       << "Pauses:" << m_acquisitionPauses;
+        }
+        if (m_servicePollingActive) {
+            m_pollTimer->start(BACKPRESSURE_RETRY_MS);
         }
         return;
     }
     
-    processNextDataPoint();
+    processDueDataPoints();
+    armPollTimer();
 }
 
-void ScadaCoreService::processNextDataPoint()
+void ScadaCoreService::armPollTimer()
 {
-    if (m_currentPointIndex >= m_dataPoints.size()) {
-        m_currentPointIndex = 0;
-    }
-    
-    if (m_dataPoints.isEmpty()) {
+    if (!m_serviceRunning || !m_servicePollingActive || !m_pollTimer) {
         return;
     }
     
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    
-    // Optimized single-threaded mode: simplified polling without complex priority logic
-    if (m_useSingleThreadedMode) {
-        // Simple round-robin through all enabled points
-        int startIndex = m_currentPointIndex;
-        int attempts = 0;
-        
-        while (attempts < m_dataPoints.size()) {
-            const DataAcquisitionPoint &point = m_dataPoints[m_currentPointIndex];
-            
-            if (point.enabled) {
-                qint64 lastPollTime = m_lastPollTimes.value(point.name, 0);
-                if (currentTime - lastPollTime >= point.pollInterval) {
-                    // Process this point and move to next
-                    processDataPoint(point, currentTime);
-                    m_currentPointIndex = (m_currentPointIndex + 1) % m_dataPoints.size();
-                    return;
-                }
-            }
-            
-            m_currentPointIndex = (m_currentPointIndex + 1) % m_dataPoints.size();
-            attempts++;
-            
-            // Prevent infinite loop
-            if (m_currentPointIndex == startIndex) {
-                break;
-            }
+    qint64 nextDeadline;
+    {
+        QMutexLocker locker(&m_dataPointsMutex);
+        if (m_pollScheduleDirty) {
+            rebuildPollSchedule();
         }
-        return;
+        nextDeadline = m_pollSchedule.nextDeadline();
     }
     
-    // Multi-threaded mode: complex priority-based polling
-    // First pass: Look for ready block points to prioritize by data type
+    if (nextDeadline < 0) {
+        m_pollTimer->stop();
+        return;
+    }
     
-    // Collect ready block points and sort by priority
-    QVector<QPair<int, int>> readyBlockIndices; // priority, index
+    const qint64 delay = nextDeadline - QDateTime::currentMSecsSinceEpoch();
+    m_pollTimer->start(static_cast<int>(qBound<qint64>(0, delay, std::numeric_limits<int>::max())));
+}
+
+void ScadaCoreService::rebuildPollSchedule()
+{
+    // Points that will actually be polled: single-threaded mode polls every enabled
+    // point, multi-threaded mode skips individual points an optimized block covers
+    m_pollScheduleDirty = false;
+    m_pollSchedule.clear();
     
-    for (int i = 0; i < m_dataPoints.size(); i++) {
-        const DataAcquisitionPoint &blockPoint = m_dataPoints[i];
-        
-        // Skip if not enabled or not a block
-        if (!blockPoint.enabled || !blockPoint.tags.contains("block_type")) {
+    // Recompile every plan; workers are resolved again on first poll
+    m_pollPlans.resize(m_dataPoints.size());
+    m_pollPlanGeneration++;
+    for (int i = 0; i < m_dataPoints.size(); ++i) {
+        if (!m_pollPoints.isEnabled(i)) {
+            m_pollPlans[i] = PollPlan();
             continue;
         }
-        
-        // Check if block is ready for polling
-        qint64 lastPollTime = m_lastPollTimes.value(blockPoint.name, 0);
-        if (currentTime - lastPollTime >= blockPoint.pollInterval) {
-            // Get priority from block tags (lower number = higher priority)
-            int priority = blockPoint.tags.value("data_type_priority", "99").toInt();
-            readyBlockIndices.append(qMakePair(priority, i));
+        const DataAcquisitionPoint &point = m_dataPoints.at(i);
+        if (!m_useSingleThreadedMode && !point.tags.contains("block_type") && isPointCoveredByBlock(point)) {
+            m_pollPlans[i] = PollPlan();
+            continue;
         }
+        m_pollPlans[i] = PollPlan::compile(point, m_useSingleThreadedMode);
+        m_pollSchedule.schedule(i, m_pollPoints.nextDue(i));
     }
-    
-    // Sort by priority (INT16=1, FLOAT32=2, DOUBLE64=3)
-    if (!readyBlockIndices.isEmpty()) {
-        std::sort(readyBlockIndices.begin(), readyBlockIndices.end());
-        
-        // Process ALL ready blocks in priority order to ensure lower priority blocks get processed
-        for (const auto &pair : readyBlockIndices) {
-            int blockIndex = pair.second;
-            const DataAcquisitionPoint &prioritizedBlock = m_dataPoints[blockIndex];
-            
-            // Process prioritized block
-            
-            processDataPoint(prioritizedBlock, currentTime);
-        }
-        return;
+}
+
+void ScadaCoreService::invalidatePollSchedule()
+{
+    // Rebuilt once when the timer is next armed, so loading many points stays linear
+    m_coverageIndexDirty = true;
+    if (!m_pollScheduleDirty) {
+        m_pollScheduleDirty = true;
+        QMetaObject::invokeMethod(this, &ScadaCoreService::armPollTimer, Qt::QueuedConnection);
     }
+}
+
+namespace {
+
+// Register type name used in a block's register_type tag for a point's data type
+QString registerTypeName(ModbusDataType dataType)
+{
+    switch (dataType) {
+    case ModbusDataType::HoldingRegister:
+    case ModbusDataType::Float32:
+    case ModbusDataType::Double64:
+    case ModbusDataType::Long32:
+    case ModbusDataType::Long64:
+        return QStringLiteral("HOLDING_REGISTER");
+    case ModbusDataType::InputRegister:
+        return QStringLiteral("INPUT_REGISTER");
+    case ModbusDataType::Coil:
+        return QStringLiteral("COIL");
+    case ModbusDataType::DiscreteInput:
+    case ModbusDataType::BOOL:
+        return QStringLiteral("DISCRETE_INPUT");
+    }
+    return QString();
+}
+
+QString coverageKey(const QString &host, int port, const QString &registerType)
+{
+    return host + QLatin1Char(':') + QString::number(port) + QLatin1Char(':') + registerType;
+}
+
+} // namespace
+
+void ScadaCoreService::processDueDataPoints()
+{
+    struct DuePoll {
+        int index;
+        quint32 generation;
+        PollPlan plan;
+    };
     
-    // Second pass: Process individual points with priority ordering
-    // Collect ready individual points and sort by data type priority
-    QVector<QPair<int, int>> readyIndividualIndices; // priority, index
+    const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    QVector<DuePoll> duePolls;
+    QVector<DataAcquisitionPoint> points;  // Shared snapshot: no per-point copies
+    quint32 planGeneration;
     
-    for (int i = 0; i < m_dataPoints.size(); i++) {
-        const DataAcquisitionPoint &point = m_dataPoints[i];
-        
-        // Skip if not enabled or is a block
-        if (!point.enabled || point.tags.contains("block_type")) {
-            continue;
+    {
+        QMutexLocker locker(&m_dataPointsMutex);
+        if (m_pollScheduleDirty) {
+            rebuildPollSchedule();  // Indexes may have shifted since the timer was armed
         }
-        
-        // Skip individual points if they are covered by an optimized block
-        if (isPointCoveredByBlock(point)) {
-            continue;
-        }
-        
-        // Check if point is ready for polling
-        qint64 lastPollTime = m_lastPollTimes.value(point.name, 0);
-        qint64 timeSinceLastPoll = currentTime - lastPollTime;
-        bool isReady = timeSinceLastPoll >= point.pollInterval;
-        
-        if (isReady) {
-            // Determine priority based on data type
-            int priority = 99; // Default low priority
-            switch (point.dataType) {
-                case ModbusDataType::HoldingRegister:
-                    priority = 1; // INT16 - highest priority
-                    break;
-                case ModbusDataType::Float32:
-                case ModbusDataType::Long32:
-                    priority = 2; // FLOAT32/LONG32 - second priority
-                    break;
-                case ModbusDataType::Double64:
-                case ModbusDataType::Long64:
-                    priority = 3; // DOUBLE64/LONG64 - third priority
-                    break;
-                case ModbusDataType::InputRegister:
-                case ModbusDataType::Coil:
-                case ModbusDataType::DiscreteInput:
-                case ModbusDataType::BOOL:
-                    priority = 1; // Other types and BOOL - high priority
-                    break;
-            }
-            readyIndividualIndices.append(qMakePair(priority, i));
+        planGeneration = m_pollPlanGeneration;
+        points = m_dataPoints;
+        
+        // Over budget, the remaining points stay due and the timer fires again at once,
+        // so replies and other events are handled between batches
+        const int budget = m_deploymentConfig.pollDispatchBudget > 0 ? m_deploymentConfig.pollDispatchBudget : -1;
+        const QVector<int> due = m_pollSchedule.takeDue(currentTime, budget);
+        duePolls.reserve(due.size());
+        
+        for (int index : due) {
+            duePolls.append({index, m_pollPoints.generation(index), m_pollPlans.at(index)});
+            m_pollSchedule.schedule(index, m_pollPoints.reschedule(index, currentTime, m_minPollIntervalMs));
         }
     }
     
-    // Sort by priority and process the highest priority individual point
-    if (!readyIndividualIndices.isEmpty()) {
-        std::sort(readyIndividualIndices.begin(), readyIndividualIndices.end());
-        
-        // Find all points with the highest priority
-        int highestPriority = readyIndividualIndices.first().first;
-        QVector<QPair<int, int>> highestPriorityPoints;
-        
-        for (const auto &pair : readyIndividualIndices) {
-            if (pair.first == highestPriority) {
-                highestPriorityPoints.append(pair);
-            } else {
-                break; // Since sorted, no more highest priority points
-            }
-        }
-        
-        // Use round-robin selection for points with same priority
-        static int roundRobinIndex = 0;
-        int selectedIndex = roundRobinIndex % highestPriorityPoints.size();
-        roundRobinIndex = (roundRobinIndex + 1) % highestPriorityPoints.size();
-        
-        int pointIndex = highestPriorityPoints[selectedIndex].second;
-        const DataAcquisitionPoint &prioritizedPoint = m_dataPoints[pointIndex];
-        
-        // Process individual point
-        
-        processDataPoint(prioritizedPoint, currentTime);
-        return;
+    std::stable_sort(duePolls.begin(), duePolls.end(), [](const DuePoll &a, const DuePoll &b) {
+        return a.plan.rank < b.plan.rank;
+    });
+    
+    bool workersResolved = false;
+    for (DuePoll &due : duePolls) {
+        const bool hadWorker = !due.plan.worker.isNull();
+        processDataPoint(points.at(due.index), due.plan, PendingRequestTable::Handle(static_cast<quint32>(due.index), due.generation), currentTime);
+        workersResolved |= !hadWorker && !due.plan.worker.isNull();
     }
     
-    // Fallback: process next point in sequence if no prioritized points are ready
-    m_currentPointIndex++;
-    if (m_currentPointIndex >= m_dataPoints.size()) {
-        m_currentPointIndex = 0;
+    // Keep workers resolved on this pass unless the plans were recompiled meanwhile
+    if (workersResolved) {
+        QMutexLocker locker(&m_dataPointsMutex);
+        if (planGeneration == m_pollPlanGeneration) {
+            for (const DuePoll &due : duePolls) {
+                m_pollPlans[due.index].worker = due.plan.worker;
+            }
+        }
     }
 }
 
-void ScadaCoreService::processDataPoint(const DataAcquisitionPoint &point, qint64 currentTime)
+void ScadaCoreService::processDataPoint(const DataAcquisitionPoint &point, PollPlan &plan, PendingRequestTable::Handle handle, qint64 currentTime)
 {
-    QString unitIdStr = point.tags.value("unit_id", "1");
-    int unitId = unitIdStr.toInt();
-    QString deviceKey = QString("%1:%2:%3").arg(point.host).arg(point.port).arg(unitIdStr);
-    
     qint64 requestId = generateRequestId();
     
     // Track operation start time for performance monitoring
@@ -1207,12 +1348,8 @@ void ScadaCoreService::processDataPoint(const DataAcquisitionPoint &point, qint6
     }
     
     // Check for simulation mode
-    if (point.tags.contains("simulation_mode") && point.tags["simulation_mode"] == "true") {
+    if (plan.simulated) {
         // Generate simulated data
-        m_lastPollTimes[point.name] = currentTime;
-        m_responseTimers[point.name] = currentTime;
-        
-        // Simulation mode polling
         
         // Generate mock data based on data type
         QVariant simulatedValue;
@@ -1254,367 +1391,72 @@ void ScadaCoreService::processDataPoint(const DataAcquisitionPoint &point, qint6
             return;
         }
         
-        // Start data acquisition in single-threaded mode
-        m_lastPollTimes[point.name] = currentTime;
-        m_responseTimers[point.name] = currentTime;
-        
         // Reduce debug verbosity for single-threaded polling
         static int singleThreadPollCount = 0;
         singleThreadPollCount++;
         
         if (singleThreadPollCount % 100 == 0) {
-            qDebug() << "🔧 Single-threaded polling cycle" << singleThreadPollCount << ":" << point.name << "at address" << point.address << "Unit ID:" << unitId;
-        }
-        
-        // Create read request for single-threaded mode
-        ModbusRequest request;
-        request.startAddress = point.address;
-        request.unitId = unitId;
-        request.requestTime = QDateTime::currentMSecsSinceEpoch();
-        request.dataType = point.dataType;
-        
-        // Check if this is an optimized block read
-        if (point.tags.contains("block_type") && point.tags["block_type"] == "optimized_read") {
-            // This is a block read - use block size
-            qDebug() << "=== SINGLE-THREAD BLOCK DEBUG ===";
-            qDebug() << "Block point name:" << point.name;
-            qDebug() << "All tags:" << point.tags;
-            qDebug() << "Block size tag exists:" << point.tags.contains("block_size");
-            qDebug() << "Block size raw value:" << point.tags["block_size"];
-            
-            int blockSize = point.tags["block_size"].toInt();
-            qDebug() << "Block size converted:" << blockSize;
-            qDebug() << "================================";
-            
-            // Limit block size to maximum of 125 registers as per Modbus specification
-            if (blockSize > 125) {
-                qWarning() << "Block size" << blockSize << "exceeds maximum limit of 125 registers for point" << point.name
-                          << "- limiting to 125 registers";
-                blockSize = 125;
-            }
-            
-            request.count = blockSize;
-            if (singleThreadPollCount % 100 == 0) {
-                qDebug() << "🔧 Single-threaded block read:" << point.name << "Address:" << point.address 
-                         << "Block Size:" << blockSize << "Unit ID:" << unitId;
-            }
-        } else {
-            // Individual point read
-            request.count = 1;
-            if (singleThreadPollCount % 100 == 0) {
-                qDebug() << "🔧 Single-threaded individual read:" << point.name << "Address:" << point.address 
-                         << "Unit ID:" << unitId;
-            }
-        }
-        
-        // Apply the same register type logic as multi-threaded mode for single-threaded operations
-        QString registerType = point.tags.value("register_type", "");
-        QString dataType = point.tags.value("data_type", "");
-        
-        // Use combined condition: register_type + data_type for precise Modbus operation selection
-        if (registerType == "HOLDING_REGISTER") {
-            request.type = ModbusRequest::ReadHoldingRegisters;
-        } else if (registerType == "INPUT_REGISTER") {
-            request.type = ModbusRequest::ReadInputRegisters;
-        } else if (registerType == "COIL") {
-            request.type = ModbusRequest::ReadCoils;
-        } else if (registerType == "DISCRETE_INPUT") {
-            request.type = ModbusRequest::ReadDiscreteInputs;
-        } else if (registerType == "STATUS") {
-            // Handle STATUS register type - map to ReadDiscreteInputs for BOOL data types (function code 0x02)
-            if (dataType == "Bool" || point.dataType == ModbusDataType::BOOL) {
-                request.type = ModbusRequest::ReadDiscreteInputs;
-            } else {
-                // Default STATUS to DiscreteInput in single-threaded mode
-                request.type = ModbusRequest::ReadDiscreteInputs;
-            }
-        } else {
-            // Fallback to dataType-based logic if register_type is not specified
-            switch (point.dataType) {
-            case ModbusDataType::HoldingRegister:
-            case ModbusDataType::Float32:
-            case ModbusDataType::Double64:
-            case ModbusDataType::Long32:
-            case ModbusDataType::Long64:
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                break;
-            case ModbusDataType::InputRegister:
-                request.type = ModbusRequest::ReadInputRegisters;
-                break;
-            case ModbusDataType::Coil:
-                request.type = ModbusRequest::ReadCoils;
-                break;
-            case ModbusDataType::DiscreteInput:
-            case ModbusDataType::BOOL:
-                // Default BOOL to DiscreteInput in single-threaded mode
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                break;
-            default:
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                break;
-            }
+            qDebug() << "🔧 Single-threaded" << (plan.isBlock ? "block" : "individual") << "read cycle" << singleThreadPollCount << ":"
+                     << point.name << "Address:" << plan.startAddress << "Count:" << plan.count << "Unit ID:" << plan.unitId;
         }
         
-        // Execute read using appropriate function based on request type
-        switch (request.type) {
+        // Execute read using appropriate function based on the compiled function code
+        switch (plan.functionType) {
         case ModbusRequest::ReadHoldingRegisters:
-            m_singleThreadModbusManager->readHoldingRegisters(request.startAddress, request.count, request.dataType, request.unitId);
+            m_singleThreadModbusManager->readHoldingRegisters(plan.startAddress, plan.count, plan.dataType, plan.unitId);
             break;
         case ModbusRequest::ReadInputRegisters:
-            m_singleThreadModbusManager->readInputRegisters(request.startAddress, request.count, request.dataType, request.unitId);
+            m_singleThreadModbusManager->readInputRegisters(plan.startAddress, plan.count, plan.dataType, plan.unitId);
             break;
         case ModbusRequest::ReadCoils:
-            m_singleThreadModbusManager->readCoils(request.startAddress, request.count, request.unitId);
+            m_singleThreadModbusManager->readCoils(plan.startAddress, plan.count, plan.unitId);
             break;
         case ModbusRequest::ReadDiscreteInputs:
-            m_singleThreadModbusManager->readDiscreteInputs(request.startAddress, request.count, request.unitId);
+            m_singleThreadModbusManager->readDiscreteInputs(plan.startAddress, plan.count, plan.unitId);
+            break;
+        default:
             break;
         }
         return;
     }
     
-    // Multi-threaded mode: Get or create worker for this device
-    ModbusWorker* worker = m_workerManager->getOrCreateWorker(point.host, point.port, unitId);
+    // Multi-threaded mode: the worker is looked up once per plan
+    ModbusWorker* worker = plan.worker.data();
     if (!worker) {
-        emit errorOccurred(QString("Failed to create worker for device: %1").arg(deviceKey));
-        return;
+        worker = m_workerManager->getOrCreateWorker(point.host, point.port, plan.unitId);
+        if (!worker) {
+            emit errorOccurred(QString("Failed to create worker for device: %1").arg(plan.deviceKey));
+            return;
+        }
+        
+        // Connect worker signals if not already connected
+        connectWorkerSignals(worker);
+        plan.worker = worker;
     }
     
-    // Connect worker signals if not already connected
-    connectWorkerSignals(worker);
+    // Reduce debug verbosity for multi-threaded polling
+    static int multiThreadPollCount = 0;
+    multiThreadPollCount++;
     
-    // Start data acquisition
-    m_lastPollTimes[point.name] = currentTime;
-    m_responseTimers[point.name] = currentTime;
+    if (multiThreadPollCount % 100 == 0) {
+        qDebug() << "Polling cycle" << multiThreadPollCount << ":" << point.name << "Address:" << plan.startAddress
+                 << "Count:" << plan.count << "Unit ID:" << plan.unitId << "Device:" << plan.deviceKey;
+    }
     
-    qDebug() << "Polling data point:" << point.name << "at address" << point.address << "Unit ID:" << unitId << "Device:" << deviceKey;
+    ModbusRequest request = plan.request(QDateTime::currentMSecsSinceEpoch());
     
-    // Create read request for the worker
-    ModbusRequest request;
-    request.startAddress = point.address;
-    request.unitId = unitId;
-    request.requestTime = QDateTime::currentMSecsSinceEpoch();
-    
-    // Check if this is an optimized block read with combined conditions
-    if (point.tags.contains("block_type") && point.tags["block_type"] == "optimized_read") {
-        // This is a block read - use block methods with register_type and data_type validation
-        qDebug() << "=== BLOCK DEBUG INFO ===";
-        qDebug() << "Block point name:" << point.name;
-        qDebug() << "All tags:" << point.tags;
-        qDebug() << "Block size tag exists:" << point.tags.contains("block_size");
-        qDebug() << "Block size raw value:" << point.tags["block_size"];
-        
-        int blockSize = point.tags["block_size"].toInt();
-        qDebug() << "Block size converted:" << blockSize;
-        
-        QString registerType = point.tags.value("register_type", "");
-        QString dataType = point.tags.value("data_type", "");
-        
-        qDebug() << "Register type:" << registerType;
-        qDebug() << "Data type:" << dataType;
-        qDebug() << "========================";
-        
-        // Limit block size to maximum of 125 registers as per Modbus specification
-        if (blockSize > 125) {
-            qWarning() << "Block size" << blockSize << "exceeds maximum limit of 125 registers for point" << point.name
-                      << "- limiting to 125 registers";
-            blockSize = 125;
-        }
-        
-        qDebug() << "Performing block read - Address:" << point.address << "Size:" << blockSize
-                 << "Register Type:" << registerType << "Data Type:" << dataType << "Unit ID:" << unitId;
-        
-        request.count = blockSize;
-        
-        // Use combined condition: register_type + data_type for precise Modbus operation selection
-        if (registerType == "HOLDING_REGISTER") {
-            // Handle holding register types based on data_type
-            if (dataType == "Int16" || point.dataType == ModbusDataType::HoldingRegister) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::HoldingRegister;
-            } else if (dataType == "Float32" || point.dataType == ModbusDataType::Float32) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Float32;
-            } else if (dataType == "Double64" || point.dataType == ModbusDataType::Double64) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Double64;
-            } else if (dataType == "Long32" || point.dataType == ModbusDataType::Long32) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Long32;
-            } else if (dataType == "Long64" || point.dataType == ModbusDataType::Long64) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Long64;
-            } else {
-                // Default to HoldingRegister for unknown data types
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::HoldingRegister;
-            }
-        } else if (registerType == "INPUT_REGISTER") {
-            // Handle input register types
-            request.type = ModbusRequest::ReadInputRegisters;
-            request.dataType = point.dataType;
-        } else if (registerType == "COIL") {
-            // Handle coil types
-            request.type = ModbusRequest::ReadCoils;
-            request.dataType = ModbusDataType::Coil;
-        } else if (registerType == "DISCRETE_INPUT") {
-            // Handle discrete input types
-            request.type = ModbusRequest::ReadDiscreteInputs;
-            request.dataType = ModbusDataType::DiscreteInput;
-        } else if (registerType == "STATUS") {
-            // Handle STATUS register type for block reads - map to DiscreteInput for BOOL data types
-            request.type = ModbusRequest::ReadDiscreteInputs;
-            request.dataType = ModbusDataType::DiscreteInput;
-        } else {
-            // Fallback to original dataType-based logic if register_type is not specified
-            switch (point.dataType) {
-            case ModbusDataType::HoldingRegister:
-            case ModbusDataType::Float32:
-            case ModbusDataType::Double64:
-            case ModbusDataType::Long32:
-            case ModbusDataType::Long64:
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = point.dataType;
-                break;
-            case ModbusDataType::InputRegister:
-                request.type = ModbusRequest::ReadInputRegisters;
-                request.dataType = point.dataType;
-                break;
-            case ModbusDataType::Coil:
-                request.type = ModbusRequest::ReadCoils;
-                request.dataType = ModbusDataType::Coil;
-                break;
-            case ModbusDataType::DiscreteInput:
-            case ModbusDataType::BOOL:
-                // Default BOOL to DiscreteInput for block reads
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                break;
-            }
-        }
-    } else {
-        // Individual point read with combined conditions
-        QString registerType = point.tags.value("register_type", "");
-        QString dataType = point.tags.value("data_type", "");
-        
-        // Reduce debug verbosity for individual reads
-        static int individualReadCount = 0;
-        individualReadCount++;
-        
-        if (individualReadCount % 100 == 0) {
-            qDebug() << "Performing individual read cycle" << individualReadCount << "- Address:" << point.address
-                     << "Register Type:" << registerType << "Data Type:" << dataType << "Unit ID:" << unitId;
-        }
-        
-        // Use combined condition: register_type + data_type for precise Modbus operation selection
-        if (registerType == "HOLDING_REGISTER") {
-            // Handle holding register types based on data_type
-            if (dataType == "Int16" || point.dataType == ModbusDataType::HoldingRegister) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::HoldingRegister;
-                request.count = 1;
-            } else if (dataType == "Float32" || point.dataType == ModbusDataType::Float32) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Float32;
-                request.count = 2;
-            } else if (dataType == "Double64" || point.dataType == ModbusDataType::Double64) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Double64;
-                request.count = 4;
-            } else if (dataType == "Long32" || point.dataType == ModbusDataType::Long32) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Long32;
-                request.count = 2;
-            } else if (dataType == "Long64" || point.dataType == ModbusDataType::Long64) {
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::Long64;
-                request.count = 4;
-            } else {
-                // Default to HoldingRegister for unknown data types
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = ModbusDataType::HoldingRegister;
-                request.count = 1;
-            }
-        } else if (registerType == "INPUT_REGISTER") {
-            // Handle input register types
-            request.type = ModbusRequest::ReadInputRegisters;
-            request.dataType = point.dataType;
-            request.count = 1;
-        } else if (registerType == "COIL") {
-            // Handle coil types
-            request.type = ModbusRequest::ReadCoils;
-            request.dataType = ModbusDataType::Coil;
-            request.count = 1;
-        } else if (registerType == "DISCRETE_INPUT") {
-            // Handle discrete input types
-            request.type = ModbusRequest::ReadDiscreteInputs;
-            request.dataType = ModbusDataType::DiscreteInput;
-            request.count = 1;
-        } else if (registerType == "STATUS") {
-            // Handle STATUS register type - map to ReadDiscreteInputs for BOOL data types (function code 0x02)
-            if (dataType == "Bool" || point.dataType == ModbusDataType::BOOL) {
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                request.count = 1;
-            } else if (point.dataType == ModbusDataType::Coil) {
-                request.type = ModbusRequest::ReadCoils;
-                request.dataType = ModbusDataType::Coil;
-                request.count = 1;
-            } else if (point.dataType == ModbusDataType::DiscreteInput) {
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                request.count = 1;
-            } else {
-                // Default STATUS+BOOL to DiscreteInput
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                request.count = 1;
-            }
-        } else {
-            // Fallback to original dataType-based logic if register_type is not specified
-            switch (point.dataType) {
-            case ModbusDataType::HoldingRegister:
-            case ModbusDataType::Float32:
-            case ModbusDataType::Double64:
-            case ModbusDataType::Long32:
-            case ModbusDataType::Long64:
-                request.type = ModbusRequest::ReadHoldingRegisters;
-                request.dataType = point.dataType;
-                request.count = (point.dataType == ModbusDataType::Float32 || point.dataType == ModbusDataType::Long32) ? 2 :
-                               (point.dataType == ModbusDataType::Double64 || point.dataType == ModbusDataType::Long64) ? 4 : 1;
-                break;
-            case ModbusDataType::InputRegister:
-                request.type = ModbusRequest::ReadInputRegisters;
-                request.dataType = point.dataType;
-                request.count = 1;
-                break;
-            case ModbusDataType::Coil:
-                request.type = ModbusRequest::ReadCoils;
-                request.dataType = ModbusDataType::Coil;
-                request.count = 1;
-                break;
-            case ModbusDataType::DiscreteInput:
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                request.count = 1;
-                break;
-            case ModbusDataType::BOOL:
-                // Default BOOL to DiscreteInput when no register_type specified
-                request.type = ModbusRequest::ReadDiscreteInputs;
-                request.dataType = ModbusDataType::DiscreteInput;
-                request.count = 1;
-                break;
-            }
-        }
+    // Data from this poll is stale once the next one is due
+    if (point.pollInterval > 0) {
+        request.deadline = currentTime + point.pollInterval;
     }
     
     // Submit the request to the worker using thread-safe queued connection
     requestId = worker->queueReadRequest(request, RequestPriority::Normal);
     
-    // Track the request for completion handling with thread safety
+    // Track the request by point handle; the point itself is looked up on completion
     {
         QMutexLocker locker(&m_requestTrackingMutex);
-        m_pendingReadRequests[requestId] = point;
+        m_pendingReadRequests.insert(reinterpret_cast<quintptr>(worker), requestId, handle);
     }
     
     // Update statistics with thread safety
@@ -1626,7 +1468,7 @@ void ScadaCoreService::processDataPoint(const DataAcquisitionPoint &point, qint6
 
 // Obsolete ModbusManager methods removed - now using ModbusWorkerManager architecture
 
-bool ScadaCoreService::writeToTelegrafSocket(const QString& socketPath, const QByteArray& message)
+bool ScadaCoreService::writeToTelegrafSocket(const QString& socketPath, const QByteArray& message, bool *wouldBlock)
 {
     if (!QFileInfo::exists(socketPath)) {
         qCritical() << "Unix socket does not exist:" << socketPath;
@@ -1643,11 +1485,20 @@ bool ScadaCoreService::writeToTelegrafSocket(const QString& socketPath, const QB
     addr.sun_family = AF_UNIX;
     strncpy(addr.sun_path, socketPath.toUtf8().constData(), sizeof(addr.sun_path) - 1);
     
-    int result = ::sendto(sockfd, message.constData(), message.size(), 0,
+    // Never block the event loop on a slow reader; a full receive buffer is reported back
+    int result = ::sendto(sockfd, message.constData(), message.size(), MSG_DONTWAIT,
                           reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    const int sendError = errno;
     ::close(sockfd);
     
     if (result < 0) {
+        if (sendError == EAGAIN || sendError == EWOULDBLOCK) {
+            if (wouldBlock) {
+                *wouldBlock = true;
+            }
+            return false;
+        }
+        errno = sendError;
         perror("sendto");
         return false;
     }
@@ -1697,7 +1548,7 @@ bool ScadaCoreService::writeToInflux(const QString& measurement, const QString&
 }
 
 // Enhanced InfluxDB write method with full tag support
-bool ScadaCoreService::writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint)
+bool ScadaCoreService::writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint, bool *wouldBlock)
 {
     if (!dataPoint.isValid || dataPoint.measurement.isEmpty()) {
         qDebug() << "Invalid data point:" << dataPoint.pointName;
@@ -1746,7 +1597,10 @@ bool ScadaCoreService::writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint)
     
     line += "\n";
     
-    bool success = writeToTelegrafSocket(m_telegrafSocketPath, line.toUtf8());
+    bool success = writeToTelegrafSocket(m_telegrafSocketPath, line.toUtf8(), wouldBlock);
+    if (wouldBlock && *wouldBlock) {
+        return false;  // Not an error; the caller retries later
+    }
     qDebug() << "Optimized InfluxDB line with mandatory tags:" << line.trimmed();
     
     if (!success) {
@@ -1760,6 +1614,55 @@ bool ScadaCoreService::writeToInfluxEnhanced(const AcquiredDataPoint &dataPoint)
     return success;
 }
 
+void ScadaCoreService::trackReportDeadbands(const DataAcquisitionPoint &point)
+{
+    QMutexLocker locker(&m_reportFilterMutex);
+    
+    // Samples of a block are reported under the original points' names
+    if (point.blockDecodePlan) {
+        for (const BlockDecodePlan::Point &source : point.blockDecodePlan->points()) {
+            m_reportFilter.setDeadband(source.name, reportDeadbandFor(source.source));
+        }
+    } else {
+        m_reportFilter.setDeadband(point.name, reportDeadbandFor(point));
+    }
+}
+
+void ScadaCoreService::untrackReportDeadbands(const DataAcquisitionPoint &point)
+{
+    QMutexLocker locker(&m_reportFilterMutex);
+    
+    if (point.blockDecodePlan) {
+        for (const BlockDecodePlan::Point &source : point.blockDecodePlan->points()) {
+            m_reportFilter.remove(source.name);
+        }
+    } else {
+        m_reportFilter.remove(point.name);
+    }
+}
+
+bool ScadaCoreService::reportByException(const AcquiredDataPoint &dataPoint)
+{
+    QMutexLocker locker(&m_reportFilterMutex);
+    return m_reportFilter.shouldReport(dataPoint.pointName, dataPoint.value, dataPoint.timestamp);
+}
+
+void ScadaCoreService::resetBitFrames(const QString &deviceKey)
+{
+    // The next good read is compared against nothing rather than a stale frame
+    QMutexLocker locker(&m_dataPointsMutex);
+    if (deviceKey.isEmpty()) {
+        m_previousBitFrames.clear();
+        return;
+    }
+    for (const DataAcquisitionPoint &point : m_dataPoints) {
+        if (m_previousBitFrames.contains(point.name) && m_workerManager &&
+            m_workerManager->deviceKeyFor(point.host, point.port, point.tags.value("unit_id", "1").toInt()) == deviceKey) {
+            m_previousBitFrames.remove(point.name);
+        }
+    }
+}
+
 bool ScadaCoreService::sendDataToInflux(const AcquiredDataPoint &dataPoint)
 {
     if (!dataPoint.isValid || dataPoint.measurement.isEmpty()) {
@@ -1767,17 +1670,48 @@ bool ScadaCoreService::sendDataToInflux(const AcquiredDataPoint &dataPoint)
         return false;
     }
     
-    // Use the enhanced InfluxDB write method with full tag support
-    bool success = writeToInfluxEnhanced(dataPoint);
+    // Queue for the sink stage; a coalesced point simply replaces its unsent value
+    AcquiredDataPoint displaced;
+    if (m_sinkQueue.push(dataPoint.pointName, dataPoint, &displaced) == BoundedStageQueue<AcquiredDataPoint>::QueuedDroppedOldest) {
+        qWarning() << "Sink queue full, dropped point:" << displaced.pointName;
+        emit dataPointSentToInflux(displaced.pointName, false);
+    }
     
-    if (success) {
-        emit dataPointSentToInflux(dataPoint.pointName, true);
-    } else {
-        emit dataPointSentToInflux(dataPoint.pointName, false);
-        emit errorOccurred(QString("Failed to send data point to InfluxDB: %1").arg(dataPoint.pointName));
+    // A pending retry after EAGAIN is left alone; the socket is still full
+    if (!m_sinkDrainTimer->isActive()) {
+        m_sinkDrainTimer->start(0);
     }
     
-    return success;
+    return true;
+}
+
+void ScadaCoreService::drainSinkQueue()
+{
+    // Bounded batch per pass so replies and poll timers are handled in between
+    int budget = SINK_DRAIN_BATCH;
+    
+    while (!m_sinkQueue.isEmpty() && budget-- > 0) {
+        bool wouldBlock = false;
+        bool success = writeToInfluxEnhanced(m_sinkQueue.head(), &wouldBlock);
+        
+        if (wouldBlock) {
+            // Telegraf is behind; keep the point queued and retry shortly
+            m_sinkDrainTimer->start(SINK_RETRY_DELAY_MS);
+            return;
+        }
+        
+        const AcquiredDataPoint dataPoint = m_sinkQueue.take();
+        if (success) {
+            emit dataPointSentToInflux(dataPoint.pointName, true);
+        } else {
+            emit dataPointSentToInflux(dataPoint.pointName, false);
+            emit errorOccurred(QString("Failed to send data point to InfluxDB: %1").arg(dataPoint.pointName));
+        }
+    }
+    
+    if (!m_sinkQueue.isEmpty()) {
+        m_sinkDrainTimer->start(0);
+    }
 }
 
 
@@ -1872,282 +1806,100 @@ void ScadaCoreService::handleBlockReadResult(const ModbusReadResult &result, con
         return;
     }
     
+    // Blocks from DatabaseManager carry a compiled plan; others are compiled here
+    QSharedPointer<const BlockDecodePlan> plan = blockPoint.blockDecodePlan;
+    if (!plan) {
+        plan = BlockDecodePlan::compile(blockPoint);
+        if (!plan) {
+            return;
+        }
+    }
+    
     // Get block information from tags
     int blockSize = blockPoint.tags.value("block_size", "1").toInt();
     int startAddress = blockPoint.address;
+    const QVector<BlockDecodePlan::Point> &points = plan->points();
     
-    // Get original point metadata from block tags
-    QStringList originalAddresses = blockPoint.tags.value("original_addresses", "").split(",", Qt::SkipEmptyParts);
-    QStringList originalNames = blockPoint.tags.value("original_names", "").split(",", Qt::SkipEmptyParts);
-    QStringList originalDataTypes = blockPoint.tags.value("original_data_types", "").split(",", Qt::SkipEmptyParts);
-    QStringList originalDescriptions = blockPoint.tags.value("original_descriptions", "").split(",", Qt::SkipEmptyParts);
-    QStringList originalMeasurements = blockPoint.tags.value("original_measurements", "").split(",", Qt::SkipEmptyParts);
+    // Coil and discrete blocks arrive as packed bits, register blocks as registers
+    const bool bitBlock = isBitDataType(result.dataType);
+    const int available = bitBlock ? result.bits.size() : result.rawData.size();
     
     qDebug() << "Processing block read result for" << blockPoint.name 
              << "Start address:" << startAddress 
              << "Block size:" << blockSize
-             << "Original points:" << originalAddresses.size()
-             << "Raw data size:" << result.rawData.size();
+             << "Original points:" << points.size()
+             << "Raw data size:" << available;
     
     // Validate we have enough data
-    if (result.rawData.size() < blockSize) {
+    if (available < blockSize) {
         qWarning() << "Insufficient data in block read. Expected:" << blockSize 
-                   << "Got:" << result.rawData.size();
+                   << "Got:" << available;
         return;
     }
     
-    // Validate metadata consistency
-    if (originalAddresses.size() != originalNames.size() || 
-        originalAddresses.size() != originalDataTypes.size() ||
-        originalAddresses.size() != originalDescriptions.size() ||
-        originalAddresses.size() != originalMeasurements.size()) {
-        qWarning() << "Inconsistent original point metadata in block" << blockPoint.name;
-        return;
+    // Decode every point of the block in one pass; register blocks hold at most 125 registers
+    QVarLengthArray<QVariant, 128> values(points.size());
+    ModbusBitBuffer changedBits;
+    bool allBitsChanged = true;
+    if (bitBlock) {
+        plan->decodeBits(result.bits, values.data());
+        
+        // XOR + popcount against the previous frame counts the flipped inputs a word
+        // at a time; the per-bit mask is only built when some but not all flipped.
+        // It only trims logging: every input is still emitted and offered to the sink.
+        ModbusBitBuffer &previous = m_previousBitFrames[blockPoint.name];
+        const int changedCount = result.bits.changedCountSince(previous);
+        allBitsChanged = changedCount == result.bits.size();
+        if (changedCount > 0 && !allBitsChanged) {
+            changedBits = result.bits.changedSince(previous);
+        }
+        previous = result.bits;
+    } else {
+        plan->decode(result.rawData.constData(), result.rawData.size(), values.data());
     }
     
-    // Process each original point
-    for (int pointIndex = 0; pointIndex < originalAddresses.size(); pointIndex++) {
-        int originalAddress = originalAddresses[pointIndex].toInt();
-        QString dataTypeStr = originalDataTypes[pointIndex];
+    for (const BlockDecodeEntry &entry : plan->entries()) {
+        const BlockDecodePlan::Point &source = points.at(entry.slot);
         
-        // Convert string data type to enum
-        ModbusDataType dataType;
-        if (dataTypeStr == "FLOAT32" || dataTypeStr == "Float32") {
-            dataType = ModbusDataType::Float32;
-        } else if (dataTypeStr == "DOUBLE" || dataTypeStr == "Double64" || dataTypeStr == "DOUBLE64") {
-            dataType = ModbusDataType::Double64;
-        } else if (dataTypeStr == "INT16" || dataTypeStr == "Int16") {
-            dataType = ModbusDataType::HoldingRegister;
-        } else if (dataTypeStr == "INT32" || dataTypeStr == "Int32") {
-            dataType = ModbusDataType::Long32;
-        } else if (dataTypeStr == "INT64" || dataTypeStr == "Int64") {
-            dataType = ModbusDataType::Long64;
-        } else if (dataTypeStr == "COIL" || dataTypeStr == "Coil") {
-            dataType = ModbusDataType::Coil;
-        } else if (dataTypeStr == "DISCRETE_INPUT" || dataTypeStr == "DiscreteInput") {
-            dataType = ModbusDataType::DiscreteInput;
-        } else if (dataTypeStr == "BOOL" || dataTypeStr == "Bool" || dataTypeStr == "Boolean") {
-            dataType = ModbusDataType::BOOL;
-        } else {
-            dataType = ModbusDataType::HoldingRegister; // Default
-        }
-        
-        // Calculate offset from start address based on actual register address difference
-        int offset = originalAddress - startAddress;
-        
-        qDebug() << "Processing point" << pointIndex << ":"
-                 << "Name:" << originalNames[pointIndex]
-                 << "Address:" << originalAddress
-                 << "Start Address:" << startAddress
-                 << "Calculated Offset:" << offset
-                 << "Data Type:" << dataTypeStr
-                 << "Raw data at offset:" << (offset < result.rawData.size() ? QString::number(result.rawData[offset]) : "OUT_OF_BOUNDS");
-        
-        // Register count validation for different data types
-        
-        // Validate offset bounds
-        int registersNeeded = 1;
-        switch (dataType) {
-            case ModbusDataType::Float32:
-            case ModbusDataType::Long32:
-                registersNeeded = 2;
-                break;
-            case ModbusDataType::Double64:
-            case ModbusDataType::Long64:
-                registersNeeded = 4;
-                break;
-            default:
-                registersNeeded = 1;
-                break;
+        if (!values.at(entry.slot).isValid()) {
+            qWarning() << "Address offset out of range:" << entry.offset << "(needs" << entry.width << "registers) for address"
+                       << source.address << "in block of size" << available;
+            continue;
         }
         
-        if (offset < 0 || (offset + registersNeeded - 1) >= result.rawData.size()) {
-            qWarning() << "Address offset out of range:" << offset << "(needs" << registersNeeded << "registers) for address" << originalAddress << "in block of size" << result.rawData.size();
-            continue;
+        if (!bitBlock && entry.dataType == ModbusDataType::BOOL && result.rawData[entry.offset] > 1) {
+            qWarning() << "BOOL conversion warning for" << source.name 
+                      << "- raw value" << result.rawData[entry.offset] << "exceeds typical boolean range (0-1)."
+                      << "Converting non-zero to true.";
         }
         
-        // Create acquired data point with enhanced mapping
+        // Create acquired data point with the mapping tags prepared by the plan
         AcquiredDataPoint dataPoint;
-        dataPoint.pointName = originalNames[pointIndex];
+        dataPoint.pointName = source.name;
         dataPoint.timestamp = result.timestamp;
-        dataPoint.measurement = originalMeasurements[pointIndex];
-        dataPoint.tags = blockPoint.tags; // Start with block tags
+        dataPoint.measurement = source.measurement;
+        dataPoint.tags = source.tags;
+        dataPoint.value = values.at(entry.slot);
         dataPoint.isValid = true;
         
-        // Enhanced InfluxDB mapping fields
-        dataPoint.tags["device_name"] = blockPoint.tags.value("device_name", "STATION_TEST");
-        dataPoint.tags["address"] = QString::number(originalAddress);
-        dataPoint.tags["description"] = originalDescriptions[pointIndex];
-        
-        // Map read_mode based on data type
-        QString readMode;
-        switch (dataType) {
-            case ModbusDataType::HoldingRegister:
-            case ModbusDataType::InputRegister:
-                readMode = "single_register";
-                break;
-            case ModbusDataType::Float32:
-            case ModbusDataType::Long32:
-                readMode = "dual_register";
-                break;
-            case ModbusDataType::Double64:
-            case ModbusDataType::Long64:
-                readMode = "quad_register";
-                break;
-            case ModbusDataType::Coil:
-            case ModbusDataType::DiscreteInput:
-                readMode = "single_bit";
-                break;
-            default:
-                readMode = "single_register";
-        }
-        dataPoint.tags["read_mode"] = readMode;
+        // Validate and ensure all required InfluxDB tags are present
+        validateAndSetInfluxTags(dataPoint, source.source);
         
-        // Preserve original database data_type format for consistency
-        QString originalDataType = originalDataTypes[pointIndex];
-        dataPoint.tags["data_type"] = originalDataType;
+        // Subscribers see every decoded sample; the deadband only gates the sink
+        emit dataPointAcquired(dataPoint);
         
-        // Extract value based on data type
-        switch (dataType) {
-        case ModbusDataType::Float32:
-            if (offset + 1 < result.rawData.size()) {
-                quint16 high = result.rawData[offset];
-                quint16 low = result.rawData[offset + 1];
-                quint32 combined = (static_cast<quint32>(high) << 16) | low;
-                float floatValue;
-                memcpy(&floatValue, &combined, sizeof(float));
-                dataPoint.value = floatValue;
-                
-#ifdef FLOAT32_DECODE_DEBUG
-                qDebug() << "Float32 decode for" << originalNames[pointIndex] << ":"
-                         << "High register [" << offset << "]:" << QString::number(high, 16)
-                         << "Low register [" << (offset + 1) << "]:" << QString::number(low, 16)
-                         << "Combined hex:" << QString::number(combined, 16)
-                         << "Float value:" << floatValue;
-#endif
-            } else {
-                qWarning() << "Float32 decode failed for" << originalNames[pointIndex] 
-                          << "- insufficient data. Offset:" << offset 
-                          << "Data size:" << result.rawData.size();
-            }
-            break;
-        case ModbusDataType::Double64:
-            if (offset + 3 < result.rawData.size()) {
-                quint16 reg0 = result.rawData[offset];
-                quint16 reg1 = result.rawData[offset + 1];
-                quint16 reg2 = result.rawData[offset + 2];
-                quint16 reg3 = result.rawData[offset + 3];
-                
-                quint64 combined = (static_cast<quint64>(reg0) << 48) |
-                                 (static_cast<quint64>(reg1) << 32) |
-                                 (static_cast<quint64>(reg2) << 16) |
-                                 reg3;
-                double doubleValue;
-                memcpy(&doubleValue, &combined, sizeof(double));
-                dataPoint.value = doubleValue;
-                
-#ifdef MODBUS_DEBUG_ENABLED
-                qDebug() << "Double64 decode for" << originalNames[pointIndex] << ":"
-                         << "Registers [" << offset << "-" << (offset+3) << "]:" 
-                         << "[" << reg0 << ", " << reg1 << ", " << reg2 << ", " << reg3 << "]"
-                         << "Hex: [0x" << QString::number(reg0, 16).toUpper()
-                         << ", 0x" << QString::number(reg1, 16).toUpper()
-                         << ", 0x" << QString::number(reg2, 16).toUpper()
-                         << ", 0x" << QString::number(reg3, 16).toUpper() << "]"
-                         << "Combined: 0x" << QString::number(combined, 16).toUpper()
-                         << "Double value:" << doubleValue;
-#endif
-            } else {
-                qWarning() << "Double64 decode failed for" << originalNames[pointIndex] 
-                          << "- insufficient data. Offset:" << offset 
-                          << "Data size:" << result.rawData.size();
-            }
-            break;
-        case ModbusDataType::Long32:
-            if (offset + 1 < result.rawData.size()) {
-                qint32 combined = (static_cast<qint32>(result.rawData[offset]) << 16) | result.rawData[offset + 1];
-                dataPoint.value = combined;
-            }
-            break;
-        case ModbusDataType::Long64:
-            if (offset + 3 < result.rawData.size()) {
-                qint64 combined = (static_cast<qint64>(result.rawData[offset]) << 48) |
-                                (static_cast<qint64>(result.rawData[offset + 1]) << 32) |
-                                (static_cast<qint64>(result.rawData[offset + 2]) << 16) |
-                                result.rawData[offset + 3];
-                dataPoint.value = combined;
-            }
-            break;
-        case ModbusDataType::BOOL:
-            // Handle BOOL data type with comprehensive error handling
-            if (offset < result.rawData.size()) {
-                quint16 rawValue = result.rawData[offset];
-                
-                // Validate raw value range for BOOL conversion
-                if (rawValue > 1) {
-                    qWarning() << "BOOL conversion warning for" << originalNames[pointIndex] 
-                              << "- raw value" << rawValue << "exceeds typical boolean range (0-1)."
-                              << "Converting non-zero to true.";
-                }
-                
-                // Convert to boolean: 0 = false, non-zero = true
-                bool boolValue = (rawValue != 0);
-                dataPoint.value = boolValue;
-                
-                // Validate QVariant conversion success
-                if (!dataPoint.value.canConvert<bool>()) {
-                    qWarning() << "BOOL QVariant conversion failed for" << originalNames[pointIndex]
-                              << "- unable to convert to boolean type. Using default false.";
-                    dataPoint.value = false;
-                    dataPoint.isValid = false;
-                    dataPoint.errorMessage = QString("BOOL conversion failed: QVariant cannot convert to bool");
-                }
-                
-#ifdef MODBUS_DEBUG_ENABLED
-                qDebug() << "BOOL decode for" << originalNames[pointIndex] << ":"
-                         << "Raw value:" << rawValue
-                         << "Boolean value:" << boolValue
-                         << "Conversion valid:" << dataPoint.value.canConvert<bool>();
-#endif
-            } else {
-                qWarning() << "BOOL decode failed for" << originalNames[pointIndex] 
-                          << "- insufficient data. Offset:" << offset 
-                          << "Data size:" << result.rawData.size();
-                dataPoint.value = false; // Default to false on error
-                dataPoint.isValid = false;
-                dataPoint.errorMessage = QString("BOOL decode failed: insufficient data at offset %1").arg(offset);
-            }
-            break;
-        default:
-            // For simple types (HoldingRegister, InputRegister)
-            dataPoint.value = result.rawData[offset];
-            break;
+        // Report by exception: a sample inside its deadband stops here, before the sink
+        if (!reportByException(dataPoint)) {
+            continue;
         }
         
-        qDebug() << "📊 Block Data Point Extracted:";
-        qDebug() << "   Point Name:" << dataPoint.pointName;
-        qDebug() << "   Address:" << originalAddress << "(offset" << offset << "from block start" << startAddress << ")";
-        qDebug() << "   Data Type:" << dataTypeStr;
-        qDebug() << "   Raw Value:" << result.rawData[offset] << "(register" << (startAddress + offset) << ")";
-        qDebug() << "   Processed Value:" << dataPoint.value.toString();
-        qDebug() << "   Measurement:" << dataPoint.measurement;
-        qDebug() << "   Description:" << originalDescriptions[pointIndex];
-        qDebug() << "   Timestamp:" << QDateTime::fromMSecsSinceEpoch(dataPoint.timestamp).toString("yyyy-MM-dd hh:mm:ss.zzz");
-        qDebug() << "   ----------------------------------------";
-        
-        // Create a temporary source point for validation
-        DataAcquisitionPoint tempSourcePoint;
-        tempSourcePoint.address = originalAddress;
-        tempSourcePoint.host = blockPoint.host;
-        tempSourcePoint.dataType = dataType;
-        tempSourcePoint.name = originalNames[pointIndex];
-        tempSourcePoint.tags = blockPoint.tags;
-        
-        // Validate and ensure all required InfluxDB tags are present
-        validateAndSetInfluxTags(dataPoint, tempSourcePoint);
-        
-        // Emit signal and send to InfluxDB
-        emit dataPointAcquired(dataPoint);
+        // Unchanged inputs of a bit block were already logged with their last change
+        if (!bitBlock || allBitsChanged || (!changedBits.isEmpty() && changedBits.testBit(entry.offset))) {
+            qDebug() << "📊 Block Data Point Extracted:" << dataPoint.pointName
+                     << "Address:" << source.address << "(offset" << entry.offset << "from block start" << startAddress << ")"
+                     << "Data Type:" << source.dataTypeName
+                     << "Value:" << dataPoint.value.toString();
+        }
         
         if (dataPoint.isValid) {
             bool sent = sendDataToInflux(dataPoint);
@@ -2165,59 +1917,61 @@ void ScadaCoreService::handleBlockReadResult(const ModbusReadResult &result, con
 
 bool ScadaCoreService::isPointCoveredByBlock(const DataAcquisitionPoint &point)
 {
-    // Check if there's a block that covers this individual point
+    if (m_coverageIndexDirty) {
+        rebuildCoverageIndex();
+    }
+    
+    const auto ranges = m_blockCoverage.constFind(coverageKey(point.host, point.port, registerTypeName(point.dataType)));
+    if (ranges == m_blockCoverage.constEnd()) {
+        return false;
+    }
+    
+    // Last merged range starting at or before the address
+    auto range = std::upper_bound(ranges->constBegin(), ranges->constEnd(), point.address,
+                                  [](int address, const QPair<int, int> &r) { return address < r.first; });
+    if (range == ranges->constBegin()) {
+        return false;
+    }
+    --range;
+    return point.address < range->second;
+}
+
+void ScadaCoreService::rebuildCoverageIndex()
+{
+    m_blockCoverage.clear();
+    m_coverageIndexDirty = false;
+    
     for (const DataAcquisitionPoint &blockPoint : m_dataPoints) {
-        // Skip if this is not a block point
         if (!blockPoint.tags.contains("block_type")) {
             continue;
         }
         
-        // Check if the individual point matches the block's device and register type
-        if (blockPoint.host != point.host || blockPoint.port != point.port) {
-            continue;
-        }
-        
-        // Get block information
         bool ok;
-        int blockStartAddress = blockPoint.tags.value("block_start_address").toInt(&ok);
+        const int blockStartAddress = blockPoint.tags.value("block_start_address").toInt(&ok);
         if (!ok) continue;
         
-        int blockSize = blockPoint.tags.value("block_size").toInt(&ok);
-        if (!ok) continue;
-        
-        QString blockRegisterType = blockPoint.tags.value("register_type");
-        QString pointRegisterType;
+        const int blockSize = blockPoint.tags.value("block_size").toInt(&ok);
+        if (!ok || blockSize <= 0) continue;
         
-        // Map point data type to register type string
-        switch (point.dataType) {
-        case ModbusDataType::HoldingRegister:
-        case ModbusDataType::Float32:
-        case ModbusDataType::Double64:
-        case ModbusDataType::Long32:
-        case ModbusDataType::Long64:
-            pointRegisterType = "HOLDING_REGISTER";
-            break;
-        case ModbusDataType::InputRegister:
-            pointRegisterType = "INPUT_REGISTER";
-            break;
-        case ModbusDataType::Coil:
-            pointRegisterType = "COIL";
-            break;
-        case ModbusDataType::DiscreteInput:
-        case ModbusDataType::BOOL:
-            pointRegisterType = "DISCRETE_INPUT";
-            break;
-        }
+        const QString key = coverageKey(blockPoint.host, blockPoint.port, blockPoint.tags.value("register_type"));
+        m_blockCoverage[key].append(qMakePair(blockStartAddress, blockStartAddress + blockSize));
+    }
+    
+    // Sort and merge overlapping or adjacent ranges so a lookup is one binary search
+    for (auto it = m_blockCoverage.begin(); it != m_blockCoverage.end(); ++it) {
+        QVector<QPair<int, int>> &ranges = it.value();
+        std::sort(ranges.begin(), ranges.end());
         
-        // Check if register types match and point address is within block range
-        if (blockRegisterType == pointRegisterType &&
-            point.address >= blockStartAddress &&
-            point.address < blockStartAddress + blockSize) {
-            return true;
+        int merged = 0;
+        for (int i = 1; i < ranges.size(); ++i) {
+            if (ranges[i].first <= ranges[merged].second) {
+                ranges[merged].second = qMax(ranges[merged].second, ranges[i].second);
+            } else {
+                ranges[++merged] = ranges[i];
+            }
         }
+        ranges.resize(merged + 1);
     }
-    
-    return false;
 }
 
 void ScadaCoreService::validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, const DataAcquisitionPoint &sourcePoint)
@@ -2270,37 +2024,37 @@ void ScadaCoreService::validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, co
     };
     
     // MANDATORY TAG 1: address - Ensure address tag is always set (critical for InfluxDB mapping)
-    if (!dataPoint.tags.contains("address") || dataPoint.tags["address"].isEmpty()) {
+    if (!dataPoint.tags.contains("address") || dataPoint.tags.value("address").isEmpty()) {
         dataPoint.tags["address"] = QString::number(sourcePoint.address);
         qDebug() << "WARNING: Missing address tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // MANDATORY TAG 2: data_type - Ensure data_type tag is set
-    if (!dataPoint.tags.contains("data_type") || dataPoint.tags["data_type"].isEmpty()) {
+    if (!dataPoint.tags.contains("data_type") || dataPoint.tags.value("data_type").isEmpty()) {
         dataPoint.tags["data_type"] = getDataTypeString(sourcePoint.dataType);
         qDebug() << "WARNING: Missing data_type tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // MANDATORY TAG 3: data_type_priority - Set priority based on data type
-    if (!dataPoint.tags.contains("data_type_priority") || dataPoint.tags["data_type_priority"].isEmpty()) {
+    if (!dataPoint.tags.contains("data_type_priority") || dataPoint.tags.value("data_type_priority").isEmpty()) {
         dataPoint.tags["data_type_priority"] = QString::number(getDataTypePriority(sourcePoint.dataType));
         qDebug() << "WARNING: Missing data_type_priority tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // MANDATORY TAG 4: description - Ensure description tag is set (use point name as fallback)
-    if (!dataPoint.tags.contains("description") || dataPoint.tags["description"].isEmpty()) {
+    if (!dataPoint.tags.contains("description") || dataPoint.tags.value("description").isEmpty()) {
         dataPoint.tags["description"] = sourcePoint.name.isEmpty() ? dataPoint.pointName : sourcePoint.name;
         qDebug() << "WARNING: Missing description tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // MANDATORY TAG 5: device_name - Ensure device_name tag is set
-    if (!dataPoint.tags.contains("device_name") || dataPoint.tags["device_name"].isEmpty()) {
+    if (!dataPoint.tags.contains("device_name") || dataPoint.tags.value("device_name").isEmpty()) {
         dataPoint.tags["device_name"] = sourcePoint.host;
         qDebug() << "WARNING: Missing device_name tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // MANDATORY TAG 6: original_address - Store the original address before any transformations
-    if (!dataPoint.tags.contains("original_address") || dataPoint.tags["original_address"].isEmpty()) {
+    if (!dataPoint.tags.contains("original_address") || dataPoint.tags.value("original_address").isEmpty()) {
         // If we have the original address in source tags, use it; otherwise use current address + 1 (convert back to 1-based)
         QString originalAddr = sourcePoint.tags.value("original_address", QString::number(sourcePoint.address + 1));
         dataPoint.tags["original_address"] = originalAddr;
@@ -2308,7 +2062,7 @@ void ScadaCoreService::validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, co
     }
     
     // MANDATORY TAG 7: tag_name - Ensure tag_name is set
-    if (!dataPoint.tags.contains("tag_name") || dataPoint.tags["tag_name"].isEmpty()) {
+    if (!dataPoint.tags.contains("tag_name") || dataPoint.tags.value("tag_name").isEmpty()) {
         // Extract tag name from point name or use the point name itself
         QString tagName = sourcePoint.tags.value("tag_name", dataPoint.pointName);
         dataPoint.tags["tag_name"] = tagName;
@@ -2316,14 +2070,14 @@ void ScadaCoreService::validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, co
     }
     
     // MANDATORY TAG 8: unit_id - Ensure unit_id tag is set
-    if (!dataPoint.tags.contains("unit_id") || dataPoint.tags["unit_id"].isEmpty()) {
+    if (!dataPoint.tags.contains("unit_id") || dataPoint.tags.value("unit_id").isEmpty()) {
         dataPoint.tags["unit_id"] = QString::number(sourcePoint.unitId);
         qDebug() << "WARNING: Missing unit_id tag detected and fixed for point:" << dataPoint.pointName;
     }
     
     // Copy any additional tags from source point
     for (auto it = sourcePoint.tags.constBegin(); it != sourcePoint.tags.constEnd(); ++it) {
-        if (!dataPoint.tags.contains(it.key()) || dataPoint.tags[it.key()].isEmpty()) {
+        if (!dataPoint.tags.contains(it.key()) || dataPoint.tags.value(it.key()).isEmpty()) {
             dataPoint.tags[it.key()] = it.value();
         }
     }
@@ -2332,7 +2086,7 @@ void ScadaCoreService::validateAndSetInfluxTags(AcquiredDataPoint &dataPoint, co
     QStringList mandatoryTags = {"address", "data_type", "data_type_priority", "description", 
                                 "device_name", "original_address", "tag_name", "unit_id"};
     for (const QString &tag : mandatoryTags) {
-        if (!dataPoint.tags.contains(tag) || dataPoint.tags[tag].isEmpty()) {
+        if (!dataPoint.tags.contains(tag) || dataPoint.tags.value(tag).isEmpty()) {
             qWarning() << "CRITICAL: Mandatory tag validation failed for" << tag << "in point:" << dataPoint.pointName;
         }
     }
@@ -2365,37 +2119,38 @@ void ScadaCoreService::onWorkerReadCompleted(qint64 requestId, const ModbusReadR
         }
     }
     
-    // Remove from pending requests and get the corresponding data point with thread safety
-    DataAcquisitionPoint point;
+    // Remove from pending requests and resolve the point handle with thread safety
+    ModbusWorker* senderWorker = qobject_cast<ModbusWorker*>(sender());
+    PendingRequestTable::Handle handle;
     bool found = false;
     {
         QMutexLocker locker(&m_requestTrackingMutex);
-        if (m_pendingReadRequests.contains(requestId)) {
-            point = m_pendingReadRequests.take(requestId);
-            found = true;
-        }
+        found = m_pendingReadRequests.take(reinterpret_cast<quintptr>(senderWorker), requestId, &handle);
     }
     
-    if (!found) {
+    DataAcquisitionPoint point;
+    if (found) {
+        QMutexLocker locker(&m_dataPointsMutex);
+        if (handle.pointIndex >= static_cast<quint32>(m_dataPoints.size()) ||
+            handle.generation != m_pollPoints.generation(static_cast<int>(handle.pointIndex))) {
+            // This point was removed or changed while the read was in flight; the next poll replaces it
+            qDebug() << "Discarding read for a point that changed in flight - Request ID:" << requestId;
+            return;
+        }
+        point = m_dataPoints.at(static_cast<int>(handle.pointIndex));
+    } else {
         // Handle automatic polling requests that aren't tracked in pending requests
-        // Get the worker that sent this signal to determine the device key
-        ModbusWorker* senderWorker = qobject_cast<ModbusWorker*>(sender());
-        QString deviceKey = "unknown";
+        QString host = "unknown";
+        int port = 502;
+        int unitId = 1;
         if (senderWorker) {
-            deviceKey = senderWorker->getDeviceKey();
+            host = senderWorker->getHost();
+            port = senderWorker->getPort();
+            unitId = senderWorker->getUnitId();
         }
         
         qDebug() << "🔧 Processing automatic polling request ID:" << requestId 
-                 << "- Device:" << deviceKey << "Address:" << result.startAddress << "Count:" << result.registerCount;
-        
-        // Parse device key to extract host and port (format: "host:port:unitId")
-        QStringList parts = deviceKey.split(':');
-        QString host = "unknown";
-        int port = 502;
-        if (parts.size() >= 2) {
-            host = parts[0];
-            port = parts[1].toInt();
-        }
+                 << "- Device:" << host << ":" << port << "Address:" << result.startAddress << "Count:" << result.registerCount;
         
         // Create a synthetic DataAcquisitionPoint for automatic polling results
         point.address = result.startAddress;
@@ -2404,11 +2159,10 @@ void ScadaCoreService::onWorkerReadCompleted(qint64 requestId, const ModbusReadR
         point.measurement = "modbus_auto_poll";
         point.host = host;
         point.port = port;
-        point.tags["unit_id"] = "1";
+        point.unitId = unitId;
+        point.tags["unit_id"] = QString::number(unitId);
         point.tags["auto_generated"] = "true";
         point.enabled = true;
-        
-        found = true; // Continue processing
     }
     
     if (result.success && result.hasValidData) {
@@ -2440,17 +2194,22 @@ void ScadaCoreService::onWorkerReadCompleted(qint64 requestId, const ModbusReadR
             acquiredPoint.tags = point.tags;
             acquiredPoint.isValid = true;
             
-            // Extract value from processed data
-            if (!result.processedData.isEmpty()) {
-                acquiredPoint.value = result.processedData.first();
+            // Multi-register values decode in the point's byte order; the typed view assumes ABCD
+            const int width = BlockDecodePlan::registerWidth(point.dataType);
+            if (width > 1 && point.valueDecoder && result.rawData.size() >= width) {
+                acquiredPoint.value = point.valueDecoder(result.rawData.constData());
+            } else if (result.valueCount() > 0) {
+                acquiredPoint.value = result.valueAt(0);
             } else if (!result.rawData.isEmpty()) {
                 acquiredPoint.value = result.rawData.first();
             }
             
             validateAndSetInfluxTags(acquiredPoint, point);
             
-            // Send to InfluxDB
-            sendDataToInflux(acquiredPoint);
+            // Send to InfluxDB unless the sample is inside its deadband
+            if (reportByException(acquiredPoint)) {
+                sendDataToInflux(acquiredPoint);
+            }
             
             // Emit signal
             emit dataPointAcquired(acquiredPoint);
@@ -2497,6 +2256,12 @@ void ScadaCoreService::onWorkerRequestInterrupted(qint64 requestId, const QStrin
 {
     qDebug() << "Worker request interrupted:" << requestId << "reason:" << reason;
     
+    // Shed polls (expired or superseded) never complete; stop tracking them
+    {
+        QMutexLocker locker(&m_requestTrackingMutex);
+        m_pendingReadRequests.take(reinterpret_cast<quintptr>(qobject_cast<ModbusWorker*>(sender())), requestId);
+    }
+    
     // Remove from pending requests if it was a write
     if (m_pendingWriteRequests.contains(requestId)) {
         QString operation = m_pendingWriteRequests.take(requestId);
@@ -2543,6 +2308,9 @@ void ScadaCoreService::onWorkerConnectionStateChanged(const QString &deviceId, b
     
     // Update connection state tracking
     m_connectionStates[deviceId] = connected;
+    if (!connected) {
+        resetBitFrames(deviceId);
+    }
     
     // Emit connection state change signal if needed
     // emit connectionStateChanged(deviceId, connected);
@@ -2613,7 +2381,11 @@ void ScadaCoreService::onSingleThreadReadCompleted(const ModbusReadResult &resul
                     dataPoint.isValid = true;
                     
                     // Extract value based on data type
-                    if (!result.rawData.isEmpty()) {
+                    if (isBitDataType(point.dataType)) {
+                        if (!result.bits.isEmpty()) {
+                            dataPoint.value = static_cast<int>(result.bits.testBit(0));
+                        }
+                    } else if (!result.rawData.isEmpty()) {
                         switch (point.dataType) {
                             case ModbusDataType::HoldingRegister:
                                 dataPoint.value = result.rawData.first();
@@ -2639,8 +2411,10 @@ void ScadaCoreService::onSingleThreadReadCompleted(const ModbusReadResult &resul
                         }
                     }
                     
-                    // Send data to InfluxDB
-                    sendDataToInflux(dataPoint);
+                    // Send data to InfluxDB unless the sample is inside its deadband
+                    if (reportByException(dataPoint)) {
+                        sendDataToInflux(dataPoint);
+                    }
                     emit dataPointAcquired(dataPoint);
                 }
                 
@@ -2651,6 +2425,14 @@ void ScadaCoreService::onSingleThreadReadCompleted(const ModbusReadResult &resul
     } else {
         qWarning() << "Single-threaded read failed:" << result.errorString;
         updateStatistics(false, responseTime);
+        
+        // A failed block read leaves a gap; do not diff the next frame across it
+        QMutexLocker locker(&m_dataPointsMutex);
+        for (const auto &point : m_dataPoints) {
+            if (point.address == result.startAddress) {
+                m_previousBitFrames.remove(point.name);
+            }
+        }
     }
 }
 
@@ -2690,14 +2472,16 @@ void ScadaCoreService::onParallelProcessingCompleted(qint64 requestId, const Acq
                  << "Request ID:" << requestId;
     }
     
-    // Send processed data to InfluxDB
-    bool influxSuccess = sendDataToInflux(dataPoint);
-    
-    // Log InfluxDB write result for debugging
-    if (!influxSuccess) {
-        qWarning() << "[Multi-threaded] InfluxDB write failed for point:" << dataPoint.pointName;
-    } else {
-        qDebug() << "[Multi-threaded] 📈 InfluxDB write successful for point:" << dataPoint.pointName;
+    // Send processed data to InfluxDB; a sample inside its deadband never reaches the sink queue
+    if (reportByException(dataPoint)) {
+        bool influxSuccess = sendDataToInflux(dataPoint);
+        
+        // Log InfluxDB queueing result for debugging
+        if (!influxSuccess) {
+            qWarning() << "[Multi-threaded] InfluxDB write rejected for point:" << dataPoint.pointName;
+        } else {
+            qDebug() << "[Multi-threaded] 📈 InfluxDB write queued for point:" << dataPoint.pointName;
+        }
     }
     
     // Emit signal for UI updates
@@ -2749,4 +2533,16 @@ void ScadaCoreService::onParallelProcessingFailed(qint64 requestId, const QStrin
     emit errorOccurred(QString("Parallel processing failed for request %1: %2").arg(requestId).arg(errorMessage));
     
     qWarning() << "❌ Parallel processing failed for request" << requestId << ":" << errorMessage;
+}
+
+void ScadaCoreService::onParallelProcessingDiscarded(qint64 requestId, const QString &reason, const QString &deviceKey)
+{
+    // A newer reading superseded the task or the full queue shed it; the decode
+    // queue metrics count it, so only the response-time bookkeeping is released
+    {
+        QMutexLocker perfLocker(&m_performanceMetricsMutex);
+        m_operationStartTimes.remove(requestId);
+    }
+    
+    qDebug() << "Parallel processing skipped request" << requestId << "device:" << deviceKey << "-" << reason;
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "../include/single_flight_table.h"
+
+void SingleFlightTable::lead(quint64 key, qint64 leaderId, RequestPriority priority)
+{
+    Flight flight;
+    flight.key = key;
+    flight.priority = priority;
+    m_flights.insert(leaderId, flight);
+    m_index.insert(key, leaderId);
+}
+
+void SingleFlightTable::markDispatched(qint64 leaderId)
+{
+    auto flight = m_flights.find(leaderId);
+    if (flight != m_flights.end()) {
+        flight.value().dispatched = true;
+    }
+}
+
+bool SingleFlightTable::join(quint64 key, const PriorityModbusRequest &follower)
+{
+    const auto indexed = m_index.constFind(key);
+    if (indexed == m_index.constEnd()) {
+        return false;
+    }
+
+    auto flight = m_flights.find(indexed.value());
+    if (flight == m_flights.end() || !flight.value().dispatched ||
+        flight.value().priority < follower.priority) {
+        return false;
+    }
+
+    flight.value().followers.append(follower);
+    return true;
+}
+
+QList<PriorityModbusRequest> SingleFlightTable::take(qint64 leaderId)
+{
+    auto flight = m_flights.find(leaderId);
+    if (flight == m_flights.end()) {
+        return QList<PriorityModbusRequest>();
+    }
+
+    const Flight finished = flight.value();
+    m_flights.erase(flight);
+    if (m_index.value(finished.key) == leaderId) {
+        m_index.remove(finished.key);
+    }
+    return finished.followers;
+}
+
+void SingleFlightTable::clear()
+{
+    m_index.clear();
+    m_flights.clear();
+}
@@ -7,6 +7,23 @@
 
 #include "test_modbus_worker.h"
 #include "test_modbus_worker_manager.h"
+#include "test_modbus_request_scheduler.h"
+#include "test_modbus_submission_queue.h"
+#include "test_poll_timing_wheel.h"
+#include "test_poll_deadline_queue.h"
+#include "test_poll_plan.h"
+#include "test_poll_point_table.h"
+#include "test_consistent_hash_ring.h"
+#include "test_bounded_stage_queue.h"
+#include "test_pending_request_table.h"
+#include "test_block_decode_plan.h"
+#include "test_register_decode_kernels.h"
+#include "test_modbus_bit_buffer.h"
+#include "test_report_by_exception_filter.h"
+#include "test_single_flight_table.h"
+#include "test_modbus_tcp_engine.h"
+#include "test_modbus_manager_pipeline.h"
+#include "test_modbus_request_pacer.h"
 
 class TestRunner
 {
@@ -35,6 +52,125 @@ public:
         totalFailures += managerFailures;
         testResults << QString("ModbusWorkerManager Tests: %1 failures").arg(managerFailures);
         
+        // Run ModbusRequestScheduler tests
+        qDebug() << "\n=== Running ModbusRequestScheduler Tests ===";
+        TestModbusRequestScheduler schedulerTest;
+        int schedulerFailures = QTest::qExec(&schedulerTest, argc, argv);
+        totalFailures += schedulerFailures;
+        testResults << QString("ModbusRequestScheduler Tests: %1 failures").arg(schedulerFailures);
+        
+        // Run ModbusSubmissionQueue tests
+        qDebug() << "\n=== Running ModbusSubmissionQueue Tests ===";
+        TestModbusSubmissionQueue submissionTest;
+        int submissionFailures = QTest::qExec(&submissionTest, argc, argv);
+        totalFailures += submissionFailures;
+        testResults << QString("ModbusSubmissionQueue Tests: %1 failures").arg(submissionFailures);
+        
+        // Run PollTimingWheel tests
+        qDebug() << "\n=== Running PollTimingWheel Tests ===";
+        TestPollTimingWheel wheelTest;
+        int wheelFailures = QTest::qExec(&wheelTest, argc, argv);
+        totalFailures += wheelFailures;
+        testResults << QString("PollTimingWheel Tests: %1 failures").arg(wheelFailures);
+        
+        // Run PollDeadlineQueue tests
+        qDebug() << "\n=== Running PollDeadlineQueue Tests ===";
+        TestPollDeadlineQueue deadlineTest;
+        int deadlineFailures = QTest::qExec(&deadlineTest, argc, argv);
+        totalFailures += deadlineFailures;
+        testResults << QString("PollDeadlineQueue Tests: %1 failures").arg(deadlineFailures);
+        
+        // Run PollPlan tests
+        qDebug() << "\n=== Running PollPlan Tests ===";
+        TestPollPlan planTest;
+        int planFailures = QTest::qExec(&planTest, argc, argv);
+        totalFailures += planFailures;
+        testResults << QString("PollPlan Tests: %1 failures").arg(planFailures);
+        
+        // Run PollPointTable tests
+        qDebug() << "\n=== Running PollPointTable Tests ===";
+        TestPollPointTable pointTableTest;
+        int pointTableFailures = QTest::qExec(&pointTableTest, argc, argv);
+        totalFailures += pointTableFailures;
+        testResults << QString("PollPointTable Tests: %1 failures").arg(pointTableFailures);
+        
+        // Run ConsistentHashRing tests
+        qDebug() << "\n=== Running ConsistentHashRing Tests ===";
+        TestConsistentHashRing ringTest;
+        int ringFailures = QTest::qExec(&ringTest, argc, argv);
+        totalFailures += ringFailures;
+        testResults << QString("ConsistentHashRing Tests: %1 failures").arg(ringFailures);
+        
+        // Run BoundedStageQueue tests
+        qDebug() << "\n=== Running BoundedStageQueue Tests ===";
+        TestBoundedStageQueue stageQueueTest;
+        int stageQueueFailures = QTest::qExec(&stageQueueTest, argc, argv);
+        totalFailures += stageQueueFailures;
+        testResults << QString("BoundedStageQueue Tests: %1 failures").arg(stageQueueFailures);
+        
+        // Run PendingRequestTable tests
+        qDebug() << "\n=== Running PendingRequestTable Tests ===";
+        TestPendingRequestTable pendingTableTest;
+        int pendingTableFailures = QTest::qExec(&pendingTableTest, argc, argv);
+        totalFailures += pendingTableFailures;
+        testResults << QString("PendingRequestTable Tests: %1 failures").arg(pendingTableFailures);
+        
+        // Run BlockDecodePlan tests
+        qDebug() << "\n=== Running BlockDecodePlan Tests ===";
+        TestBlockDecodePlan blockPlanTest;
+        int blockPlanFailures = QTest::qExec(&blockPlanTest, argc, argv);
+        totalFailures += blockPlanFailures;
+        testResults << QString("BlockDecodePlan Tests: %1 failures").arg(blockPlanFailures);
+        
+        // Run RegisterDecodeKernels tests
+        qDebug() << "\n=== Running RegisterDecodeKernels Tests ===";
+        TestRegisterDecodeKernels decodeKernelsTest;
+        int decodeKernelsFailures = QTest::qExec(&decodeKernelsTest, argc, argv);
+        totalFailures += decodeKernelsFailures;
+        testResults << QString("RegisterDecodeKernels Tests: %1 failures").arg(decodeKernelsFailures);
+        
+        // Run ModbusBitBuffer tests
+        qDebug() << "\n=== Running ModbusBitBuffer Tests ===";
+        TestModbusBitBuffer bitBufferTest;
+        int bitBufferFailures = QTest::qExec(&bitBufferTest, argc, argv);
+        totalFailures += bitBufferFailures;
+        testResults << QString("ModbusBitBuffer Tests: %1 failures").arg(bitBufferFailures);
+        
+        // Run ReportByExceptionFilter tests
+        qDebug() << "\n=== Running ReportByExceptionFilter Tests ===";
+        TestReportByExceptionFilter reportFilterTest;
+        int reportFilterFailures = QTest::qExec(&reportFilterTest, argc, argv);
+        totalFailures += reportFilterFailures;
+        testResults << QString("ReportByExceptionFilter Tests: %1 failures").arg(reportFilterFailures);
+        
+        // Run SingleFlightTable tests
+        qDebug() << "\n=== Running SingleFlightTable Tests ===";
+        TestSingleFlightTable singleFlightTest;
+        int singleFlightFailures = QTest::qExec(&singleFlightTest, argc, argv);
+        totalFailures += singleFlightFailures;
+        testResults << QString("SingleFlightTable Tests: %1 failures").arg(singleFlightFailures);
+        
+        // Run ModbusTcpEngine tests
+        qDebug() << "\n=== Running ModbusTcpEngine Tests ===";
+        TestModbusTcpEngine tcpEngineTest;
+        int tcpEngineFailures = QTest::qExec(&tcpEngineTest, argc, argv);
+        totalFailures += tcpEngineFailures;
+        testResults << QString("ModbusTcpEngine Tests: %1 failures").arg(tcpEngineFailures);
+        
+        // Run ModbusManager pipeline tests
+        qDebug() << "\n=== Running ModbusManager Pipeline Tests ===";
+        TestModbusManagerPipeline pipelineTest;
+        int pipelineFailures = QTest::qExec(&pipelineTest, argc, argv);
+        totalFailures += pipelineFailures;
+        testResults << QString("ModbusManager Pipeline Tests: %1 failures").arg(pipelineFailures);
+        
+        // Run ModbusRequestPacer tests
+        qDebug() << "\n=== Running ModbusRequestPacer Tests ===";
+        TestModbusRequestPacer pacerTest;
+        int pacerFailures = QTest::qExec(&pacerTest, argc, argv);
+        totalFailures += pacerFailures;
+        testResults << QString("ModbusRequestPacer Tests: %1 failures").arg(pacerFailures);
+        
         // Print summary
         printTestSummary(testResults, totalFailures);
         
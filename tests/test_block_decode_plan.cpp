@@ -0,0 +1,211 @@
+#include "test_block_decode_plan.h"
+
+namespace {
+
+// Block at 100: INT16@100, FLOAT32@101, INT32@103, DOUBLE64@105, BOOL@109
+DataAcquisitionPoint mixedBlock()
+{
+    DataAcquisitionPoint block;
+    block.name = "RTU1_BLOCK_100_109";
+    block.host = "10.0.0.5";
+    block.address = 100;
+    block.tags["device_name"] = "RTU1";
+    block.tags["block_type"] = "optimized_read";
+    block.tags["block_size"] = "10";
+    block.tags["original_addresses"] = "100,101,103,105,109";
+    block.tags["original_names"] = "p_int,p_float,p_long,p_double,p_bool";
+    block.tags["original_data_types"] = "INT16,FLOAT32,INT32,DOUBLE64,BOOL";
+    block.tags["original_descriptions"] = "d0,d1,d2,d3,d4";
+    block.tags["original_measurements"] = "m,m,m,m,m";
+    return block;
+}
+
+const quint16 MIXED_REGISTERS[10] = {
+    7,                          // INT16 7
+    0x3FC0, 0x0000,             // FLOAT32 1.5
+    0xFFFF, 0xFFFE,             // INT32 -2
+    0x4000, 0x0000, 0x0000, 0x0000, // DOUBLE64 2.0
+    5                           // BOOL true
+};
+
+// Block at 200: six FLOAT32 back to back (n + 0.5 for n = 0..5), then INT16@212
+DataAcquisitionPoint floatRunBlock()
+{
+    DataAcquisitionPoint block = mixedBlock();
+    block.name = "RTU1_BLOCK_200_212";
+    block.address = 200;
+    block.tags["block_size"] = "13";
+    block.tags["original_addresses"] = "200,202,204,206,208,210,212";
+    block.tags["original_names"] = "f0,f1,f2,f3,f4,f5,p_int";
+    block.tags["original_data_types"] = "FLOAT32,FLOAT32,FLOAT32,FLOAT32,FLOAT32,FLOAT32,INT16";
+    block.tags["original_descriptions"] = "d,d,d,d,d,d,d";
+    block.tags["original_measurements"] = "m,m,m,m,m,m,m";
+    return block;
+}
+
+const quint16 FLOAT_RUN_REGISTERS[13] = {
+    0x3F00, 0x0000,             // 0.5
+    0x3FC0, 0x0000,             // 1.5
+    0x4020, 0x0000,             // 2.5
+    0x4060, 0x0000,             // 3.5
+    0x4090, 0x0000,             // 4.5
+    0x40B0, 0x0000,             // 5.5
+    9                           // INT16 9
+};
+
+} // namespace
+
+void TestBlockDecodePlan::testCompileFromBlockTags()
+{
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(mixedBlock());
+    QVERIFY(plan);
+    QCOMPARE(plan->entries().size(), 5);
+    QCOMPARE(plan->requiredRegisters(), 10);
+
+    const BlockDecodeEntry &doubleEntry = plan->entries().at(3);
+    QCOMPARE(doubleEntry.offset, 5);
+    QCOMPARE(doubleEntry.width, 4);
+    QVERIFY(doubleEntry.dataType == ModbusDataType::Double64);
+
+    // Output tags are prepared once per point
+    const BlockDecodePlan::Point &floatPoint = plan->points().at(plan->entries().at(1).slot);
+    QCOMPARE(floatPoint.name, QString("p_float"));
+    QCOMPARE(floatPoint.tags.value("address"), QString("101"));
+    QCOMPARE(floatPoint.tags.value("description"), QString("d1"));
+    QCOMPARE(floatPoint.tags.value("read_mode"), QString("dual_register"));
+    QCOMPARE(floatPoint.tags.value("data_type"), QString("FLOAT32"));
+    QCOMPARE(floatPoint.tags.value("device_name"), QString("RTU1"));
+    QVERIFY(floatPoint.source.dataType == ModbusDataType::Float32);
+}
+
+void TestBlockDecodePlan::testInconsistentMetadataIsRejected()
+{
+    DataAcquisitionPoint block = mixedBlock();
+    block.tags["original_names"] = "p_int,p_float";
+    QVERIFY(!BlockDecodePlan::compile(block));
+
+    block.tags.remove("original_addresses");
+    QVERIFY(!BlockDecodePlan::compile(block));
+}
+
+void TestBlockDecodePlan::testDecodeMixedTypes()
+{
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(mixedBlock());
+    QVERIFY(plan);
+
+    QVector<QVariant> values(plan->points().size());
+    plan->decode(MIXED_REGISTERS, 10, values.data());
+
+    QCOMPARE(values.at(0).toInt(), 7);
+    QCOMPARE(values.at(1).toFloat(), 1.5f);
+    QCOMPARE(values.at(2).toInt(), -2);
+    QCOMPARE(values.at(3).toDouble(), 2.0);
+    QCOMPARE(values.at(4).toBool(), true);
+}
+
+void TestBlockDecodePlan::testShortReplyLeavesOutOfRangeInvalid()
+{
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(mixedBlock());
+    QVERIFY(plan);
+
+    // The double needs registers 105..108; only 105..106 arrived
+    QVector<QVariant> values(plan->points().size());
+    plan->decode(MIXED_REGISTERS, 7, values.data());
+
+    QVERIFY(values.at(0).isValid());
+    QVERIFY(values.at(2).isValid());
+    QVERIFY(!values.at(3).isValid());
+    QVERIFY(!values.at(4).isValid());
+}
+
+void TestBlockDecodePlan::testContiguousFloatsDecodeAsSpan()
+{
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(floatRunBlock());
+    QVERIFY(plan);
+    QCOMPARE(plan->spans().size(), 1);
+    QCOMPARE(plan->spans().at(0).values, 6);
+    QCOMPARE(plan->entries().at(6).span, -1);
+
+    QVector<QVariant> values(plan->points().size());
+    plan->decode(FLOAT_RUN_REGISTERS, 13, values.data());
+    for (int i = 0; i < 6; ++i) {
+        QCOMPARE(values.at(i).toFloat(), i + 0.5f);
+    }
+    QCOMPARE(values.at(6).toInt(), 9);
+
+    // A span cut short by the reply falls back to decoding what fits
+    QVector<QVariant> shortValues(plan->points().size());
+    plan->decode(FLOAT_RUN_REGISTERS, 7, shortValues.data());
+    QCOMPARE(shortValues.at(2).toFloat(), 2.5f);
+    QVERIFY(!shortValues.at(3).isValid());
+    QVERIFY(!shortValues.at(6).isValid());
+}
+
+void TestBlockDecodePlan::testValueDecodersPerByteOrder()
+{
+    // 1.5f is 0x3FC00000: bytes A=3F B=C0 C=00 D=00
+    const quint16 floatWords[4][2] = {{0x3FC0, 0x0000}, {0x0000, 0x3FC0}, {0xC03F, 0x0000}, {0x0000, 0xC03F}};
+    // -2 as INT64 is 0xFFFFFFFFFFFFFFFE
+    const quint16 longWords[4][4] = {{0xFFFF, 0xFFFF, 0xFFFF, 0xFFFE}, {0xFFFE, 0xFFFF, 0xFFFF, 0xFFFF},
+                                     {0xFFFF, 0xFFFF, 0xFFFF, 0xFEFF}, {0xFEFF, 0xFFFF, 0xFFFF, 0xFFFF}};
+    const char *names[4] = {"ABCD", "CDAB", "BADC", "dcba"};
+
+    for (int i = 0; i < 4; ++i) {
+        bool ok = false;
+        const RegisterByteOrder order = BlockDecodePlan::byteOrderFromName(names[i], &ok);
+        QVERIFY(ok);
+        QVERIFY(order == RegisterByteOrder(i));
+        QCOMPARE(BlockDecodePlan::valueDecoder(ModbusDataType::Float32, order)(floatWords[i]).toFloat(), 1.5f);
+        QCOMPARE(BlockDecodePlan::valueDecoder(ModbusDataType::Long64, order)(longWords[i]).toLongLong(), qint64(-2));
+    }
+
+    bool ok = true;
+    QVERIFY(BlockDecodePlan::byteOrderFromName("little", &ok) == RegisterByteOrder::ABCD);
+    QVERIFY(!ok);
+}
+
+void TestBlockDecodePlan::testPerTagByteOrderSplitsSpans()
+{
+    // f0..f3 are CDAB, f4..f5 stay ABCD: one span of four, then two single entries
+    DataAcquisitionPoint block = floatRunBlock();
+    block.tags["original_byte_orders"] = "CDAB,CDAB,CDAB,CDAB,ABCD,ABCD,ABCD";
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(block);
+    QVERIFY(plan);
+    QCOMPARE(plan->spans().size(), 1);
+    QCOMPARE(plan->spans().at(0).values, 4);
+    QVERIFY(plan->spans().at(0).byteOrder == RegisterByteOrder::CDAB);
+    QCOMPARE(plan->entries().at(4).span, -1);
+
+    QVector<quint16> registers(FLOAT_RUN_REGISTERS, FLOAT_RUN_REGISTERS + 13);
+    for (int i = 0; i < 4; ++i) {
+        qSwap(registers[2 * i], registers[2 * i + 1]);
+    }
+    QVector<QVariant> values(plan->points().size());
+    plan->decode(registers.constData(), registers.size(), values.data());
+    for (int i = 0; i < 6; ++i) {
+        QCOMPARE(values.at(i).toFloat(), i + 0.5f);
+    }
+
+    // A byte order list that doesn't match the points is inconsistent metadata
+    block.tags["original_byte_orders"] = "CDAB";
+    QVERIFY(!BlockDecodePlan::compile(block));
+}
+
+void TestBlockDecodePlan::testDecodeCoilBlockFromBits()
+{
+    DataAcquisitionPoint block = mixedBlock();
+    block.tags["original_addresses"] = "100,103,104";
+    block.tags["original_names"] = "c0,c3,c4";
+    block.tags["original_data_types"] = "COIL,COIL,COIL";
+    block.tags["original_descriptions"] = "d,d,d";
+    block.tags["original_measurements"] = "m,m,m";
+    QSharedPointer<const BlockDecodePlan> plan = BlockDecodePlan::compile(block);
+    QVERIFY(plan);
+
+    const quint16 states[5] = {1, 0, 0, 0, 1};
+    QVector<QVariant> values(plan->points().size());
+    plan->decodeBits(ModbusBitBuffer::fromBitValues(states, 4), values.data());
+    QCOMPARE(values.at(0).toInt(), 1);
+    QCOMPARE(values.at(1).toInt(), 0);
+    QVERIFY(!values.at(2).isValid());  // Bit 4 was not in the reply
+}
@@ -0,0 +1,22 @@
+#ifndef TEST_BLOCK_DECODE_PLAN_H
+#define TEST_BLOCK_DECODE_PLAN_H
+
+#include <QtTest/QtTest>
+#include "../include/block_decode_plan.h"
+
+class TestBlockDecodePlan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCompileFromBlockTags();
+    void testInconsistentMetadataIsRejected();
+    void testDecodeMixedTypes();
+    void testShortReplyLeavesOutOfRangeInvalid();
+    void testContiguousFloatsDecodeAsSpan();
+    void testValueDecodersPerByteOrder();
+    void testPerTagByteOrderSplitsSpans();
+    void testDecodeCoilBlockFromBits();
+};
+
+#endif // TEST_BLOCK_DECODE_PLAN_H
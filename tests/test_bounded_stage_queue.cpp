@@ -0,0 +1,126 @@
+#include "test_bounded_stage_queue.h"
+
+namespace {
+
+QString pointKey(int i)
+{
+    return QString("point_%1").arg(i);
+}
+
+} // namespace
+
+void TestBoundedStageQueue::testFifoOrder()
+{
+    BoundedStageQueue<int> queue(8, StageQueuePolicy::DropOldest);
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.push(pointKey(i), i) == BoundedStageQueue<int>::Queued);
+    }
+
+    QCOMPARE(queue.size(), 5);
+    QCOMPARE(queue.head(), 0);
+    for (int i = 0; i < 5; ++i) {
+        QCOMPARE(queue.take(), i);
+    }
+    QVERIFY(queue.isEmpty());
+
+    const StageQueueMetrics metrics = queue.metrics();
+    QCOMPARE(metrics.depth, 0);
+    QCOMPARE(metrics.highWater, 5);
+    QCOMPARE(metrics.accepted, qint64(5));
+    QCOMPARE(metrics.dropped, qint64(0));
+}
+
+void TestBoundedStageQueue::testDropOldestKeepsCapacity()
+{
+    BoundedStageQueue<int> queue(4, StageQueuePolicy::DropOldest);
+    for (int i = 0; i < 4; ++i) {
+        queue.push(pointKey(i), i);
+    }
+
+    int displaced = -1;
+    QVERIFY(queue.push(pointKey(4), 4, &displaced) == BoundedStageQueue<int>::QueuedDroppedOldest);
+    QCOMPARE(displaced, 0);
+    QCOMPARE(queue.size(), 4);
+    QVERIFY(!queue.isBackpressured());  // Only Block asks producers to slow down
+
+    for (int expected = 1; expected <= 4; ++expected) {
+        QCOMPARE(queue.take(), expected);
+    }
+    QCOMPARE(queue.metrics().dropped, qint64(1));
+}
+
+void TestBoundedStageQueue::testCoalesceLatestReplacesQueuedPoint()
+{
+    BoundedStageQueue<int> queue(4, StageQueuePolicy::CoalesceLatest);
+    queue.push("a", 1);
+    queue.push("b", 2);
+
+    int displaced = -1;
+    QVERIFY(queue.push("a", 10, &displaced) == BoundedStageQueue<int>::Coalesced);
+    QCOMPARE(displaced, 1);
+    QCOMPARE(queue.size(), 2);
+
+    // The point keeps its place in line but carries the latest value
+    QCOMPARE(queue.take(), 10);
+    QCOMPARE(queue.take(), 2);
+
+    // Once taken, the key starts a new entry
+    QVERIFY(queue.push("a", 11) == BoundedStageQueue<int>::Queued);
+    QCOMPARE(queue.metrics().coalesced, qint64(1));
+}
+
+void TestBoundedStageQueue::testCoalesceAfterPartialDrain()
+{
+    BoundedStageQueue<int> queue(3, StageQueuePolicy::CoalesceLatest);
+    queue.push("a", 1);
+    queue.push("b", 2);
+    queue.push("c", 3);
+    QCOMPARE(queue.take(), 1);
+
+    // Index positions must follow the head after takes and drops
+    QVERIFY(queue.push("c", 30) == BoundedStageQueue<int>::Coalesced);
+    queue.push("d", 4);
+    int displaced = -1;
+    QVERIFY(queue.push("e", 5, &displaced) == BoundedStageQueue<int>::QueuedDroppedOldest);
+    QCOMPARE(displaced, 2);
+    QVERIFY(queue.push("d", 40) == BoundedStageQueue<int>::Coalesced);
+
+    QCOMPARE(queue.take(), 30);
+    QCOMPARE(queue.take(), 40);
+    QCOMPARE(queue.take(), 5);
+    QVERIFY(queue.isEmpty());
+}
+
+void TestBoundedStageQueue::testBlockBackpressureHysteresis()
+{
+    BoundedStageQueue<int> queue(4, StageQueuePolicy::Block);
+    for (int i = 0; i < 3; ++i) {
+        queue.push(pointKey(i), i);
+    }
+    QVERIFY(!queue.isBackpressured());
+
+    queue.push(pointKey(3), 3);
+    QVERIFY(queue.isBackpressured());
+
+    // Stays on until the queue is down to half its capacity
+    queue.take();
+    QVERIFY(queue.isBackpressured());
+    queue.take();
+    QVERIFY(!queue.isBackpressured());
+}
+
+void TestBoundedStageQueue::testBlockHardLimitDropsOldest()
+{
+    BoundedStageQueue<int> queue(4, StageQueuePolicy::Block);
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(queue.push(pointKey(i), i) == BoundedStageQueue<int>::Queued);
+    }
+
+    // Producers that ignore backpressure can't grow it past twice the capacity
+    int displaced = -1;
+    QVERIFY(queue.push(pointKey(8), 8, &displaced) == BoundedStageQueue<int>::QueuedDroppedOldest);
+    QCOMPARE(displaced, 0);
+    QCOMPARE(queue.size(), 8);
+    QCOMPARE(queue.metrics().highWater, 8);
+    QCOMPARE(queue.metrics().capacity, 4);
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_BOUNDED_STAGE_QUEUE_H
+#define TEST_BOUNDED_STAGE_QUEUE_H
+
+#include <QtTest/QtTest>
+#include "../include/bounded_stage_queue.h"
+
+class TestBoundedStageQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFifoOrder();
+    void testDropOldestKeepsCapacity();
+    void testCoalesceLatestReplacesQueuedPoint();
+    void testCoalesceAfterPartialDrain();
+    void testBlockBackpressureHysteresis();
+    void testBlockHardLimitDropsOldest();
+};
+
+#endif // TEST_BOUNDED_STAGE_QUEUE_H
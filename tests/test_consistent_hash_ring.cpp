@@ -0,0 +1,105 @@
+#include "test_consistent_hash_ring.h"
+
+namespace {
+
+const int KEY_COUNT = 10000;
+
+QStringList deviceKeys()
+{
+    QStringList keys;
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        keys.append(QString("10.0.%1.%2:502:1").arg(i / 250).arg(i % 250));
+    }
+    return keys;
+}
+
+QVector<int> assign(const ConsistentHashRing &ring, const QStringList &keys)
+{
+    QVector<int> nodes;
+    nodes.reserve(keys.size());
+    for (const QString &key : keys) {
+        nodes.append(ring.nodeFor(key));
+    }
+    return nodes;
+}
+
+} // namespace
+
+void TestConsistentHashRing::testEmptyRing()
+{
+    ConsistentHashRing ring;
+    QVERIFY(ring.isEmpty());
+    QCOMPARE(ring.nodeFor("10.0.0.1:502:1"), -1);
+    
+    ring.addNode(3);
+    ring.addNode(3);  // Duplicate is ignored
+    QCOMPARE(ring.nodeCount(), 1);
+    QCOMPARE(ring.nodeFor("10.0.0.1:502:1"), 3);
+}
+
+void TestConsistentHashRing::testStableHash()
+{
+    // Placement must not depend on the per-process qHash seed
+    QCOMPARE(ConsistentHashRing::hashKey("abc"), quint32(482950588U));
+    QVERIFY(ConsistentHashRing::hashKey("10.0.0.1:502:1") != ConsistentHashRing::hashKey("10.0.0.1:502:2"));
+}
+
+void TestConsistentHashRing::testEvenDistribution()
+{
+    ConsistentHashRing ring;
+    for (int node = 0; node < 4; ++node) {
+        ring.addNode(node);
+    }
+    
+    const QVector<int> nodes = assign(ring, deviceKeys());
+    for (int node = 0; node < 4; ++node) {
+        const int share = nodes.count(node);
+        QVERIFY2(share > KEY_COUNT * 15 / 100 && share < KEY_COUNT * 35 / 100,
+                 qPrintable(QString("node %1 got %2 keys").arg(node).arg(share)));
+    }
+}
+
+void TestConsistentHashRing::testAddingNodeOnlyMovesKeysToIt()
+{
+    ConsistentHashRing ring;
+    for (int node = 0; node < 4; ++node) {
+        ring.addNode(node);
+    }
+    const QStringList keys = deviceKeys();
+    const QVector<int> before = assign(ring, keys);
+    
+    ring.addNode(4);
+    const QVector<int> after = assign(ring, keys);
+    
+    int moved = 0;
+    for (int i = 0; i < keys.size(); ++i) {
+        if (before[i] != after[i]) {
+            QCOMPARE(after[i], 4);
+            moved++;
+        }
+    }
+    QVERIFY(moved > 0);
+    QVERIFY(moved < KEY_COUNT * 40 / 100);
+}
+
+void TestConsistentHashRing::testRemovingNodeOnlyMovesItsKeys()
+{
+    ConsistentHashRing ring;
+    for (int node = 0; node < 4; ++node) {
+        ring.addNode(node);
+    }
+    const QStringList keys = deviceKeys();
+    const QVector<int> before = assign(ring, keys);
+    
+    ring.removeNode(2);
+    QCOMPARE(ring.nodeCount(), 3);
+    const QVector<int> after = assign(ring, keys);
+    
+    for (int i = 0; i < keys.size(); ++i) {
+        if (before[i] == 2) {
+            QVERIFY(after[i] != 2);
+        } else {
+            QCOMPARE(after[i], before[i]);
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_CONSISTENT_HASH_RING_H
+#define TEST_CONSISTENT_HASH_RING_H
+
+#include <QtTest/QtTest>
+#include "../include/consistent_hash_ring.h"
+
+class TestConsistentHashRing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmptyRing();
+    void testStableHash();
+    void testEvenDistribution();
+    void testAddingNodeOnlyMovesKeysToIt();
+    void testRemovingNodeOnlyMovesItsKeys();
+};
+
+#endif // TEST_CONSISTENT_HASH_RING_H
@@ -0,0 +1,141 @@
+#include "test_modbus_bit_buffer.h"
+#include "../include/modbusmanager.h"
+#include <QRandomGenerator>
+
+namespace {
+
+// Random 0/1 (and some non-zero non-one) values, one per bit
+QVector<quint16> randomBitValues(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QVector<quint16> values(count);
+    for (int i = 0; i < count; ++i) {
+        const int roll = random.bounded(4);
+        values[i] = roll == 0 ? 0xFF00 : (roll == 1 ? 1 : 0);
+    }
+    return values;
+}
+
+} // namespace
+
+void TestModbusBitBuffer::testFromBitValues()
+{
+    // 2000 coils: the largest FC 1 read
+    const QVector<quint16> values = randomBitValues(2000, 1);
+    const ModbusBitBuffer bits = ModbusBitBuffer::fromBitValues(values.constData(), values.size());
+    QCOMPARE(bits.size(), 2000);
+    QCOMPARE(bits.wordCount(), 32);
+
+    int set = 0;
+    for (int i = 0; i < values.size(); ++i) {
+        QCOMPARE(bits.testBit(i), values[i] != 0);
+        set += values[i] != 0;
+    }
+    QCOMPARE(bits.count(), set);
+    QCOMPARE(bits.toBitValues().size(), 2000);
+}
+
+void TestModbusBitBuffer::testPackedWordsMatchPduBytes()
+{
+    // Modbus spec example: 19 coils as bytes 0xCD 0x6B 0x05, the last byte
+    // holding only three requested coils
+    const quint16 words[2] = {0x6BCD, 0x0005};
+    const ModbusBitBuffer bits = ModbusBitBuffer::fromPackedWords(words, 19);
+    QCOMPARE(bits.size(), 19);
+    QCOMPARE(bits.testBit(0), true);
+    QCOMPARE(bits.testBit(1), false);
+    QCOMPARE(bits.testBit(8), true);
+    QCOMPARE(bits.testBit(16), true);
+    QCOMPARE(bits.testBit(17), false);
+    QCOMPARE(bits.testBit(18), true);
+    QCOMPARE(bits.toPackedBytes(), QByteArray("\xCD\x6B\x05", 3));
+
+    // Padding bits past the requested count are dropped
+    const quint16 allSet[2] = {0xFFFF, 0xFFFF};
+    QCOMPARE(ModbusBitBuffer::fromPackedWords(allSet, 20).count(), 20);
+}
+
+void TestModbusBitBuffer::testMidAcrossWordBoundary()
+{
+    const QVector<quint16> values = randomBitValues(300, 2);
+    const ModbusBitBuffer bits = ModbusBitBuffer::fromBitValues(values.constData(), values.size());
+
+    const ModbusBitBuffer slice = bits.mid(60, 100);
+    QCOMPARE(slice.size(), 100);
+    for (int i = 0; i < slice.size(); ++i) {
+        QCOMPARE(slice.testBit(i), bits.testBit(60 + i));
+    }
+
+    // Clamped to the buffer
+    QCOMPARE(bits.mid(290, 50).size(), 10);
+}
+
+void TestModbusBitBuffer::testChangeDetection()
+{
+    const QVector<quint16> values = randomBitValues(2000, 3);
+    const ModbusBitBuffer previous = ModbusBitBuffer::fromBitValues(values.constData(), values.size());
+    QCOMPARE(previous.changedCountSince(previous), 0);
+
+    ModbusBitBuffer current = previous;
+    const int flipped[] = {0, 63, 64, 1000, 1999};
+    for (int index : flipped) {
+        current.setBit(index, !current.testBit(index));
+    }
+    QCOMPARE(current.changedCountSince(previous), 5);
+
+    QVector<int> changed;
+    current.changedSince(previous).forEachSetBit([&changed](int index) { changed.append(index); });
+    QCOMPARE(changed, QVector<int>({0, 63, 64, 1000, 1999}));
+
+    // No previous frame yet: every input counts as changed
+    QCOMPARE(current.changedCountSince(ModbusBitBuffer()), 2000);
+}
+
+void TestModbusBitBuffer::testBitReadsStayPacked()
+{
+    const QVector<quint16> values = randomBitValues(2000, 4);
+    const QVariantMap converted = ModbusManager::convertRawData(values, ModbusDataType::Coil);
+    QCOMPARE(converted.size(), 2);
+    QCOMPARE(converted.value("bit_count").toInt(), 2000);
+    QCOMPARE(converted.value("bits").toByteArray(),
+             ModbusBitBuffer::fromBitValues(values.constData(), values.size()).toPackedBytes());
+
+    ModbusReadResult result;
+    result.dataType = ModbusDataType::DiscreteInput;
+    result.bits = ModbusBitBuffer::fromBitValues(values.constData(), values.size());
+    QCOMPARE(result.valueCount(), 2000);
+    QCOMPARE(result.valueAt(1999).toBool(), values[1999] != 0);
+    QVERIFY(result.rawData.isEmpty());
+}
+
+void TestModbusBitBuffer::testLazyBitDecodeMatchesEager()
+{
+    // 19 coils as PDU bytes 0xCD 0x6B 0x05 (see testPackedWordsMatchPduBytes)
+    const quint16 words[2] = {0x6BCD, 0x0005};
+    ModbusReadResult read;
+    read.success = true;
+    read.dataType = ModbusDataType::Coil;
+    read.startAddress = 100;
+    read.bits = ModbusBitBuffer::fromPackedWords(words, 19);
+
+    // Slice starts mid byte and spans both byte boundaries
+    ModbusManager manager;
+    const ModbusReadResult eager = manager.sliceReadResult(read, 105, 13, ModbusDataType::Coil);
+    manager.setEagerDecodeEnabled(false);
+    const ModbusReadResult lazy = manager.sliceReadResult(read, 105, 13, ModbusDataType::Coil);
+
+    // Nothing decoded until the typed view is read
+    QVERIFY(lazy.success);
+    QVERIFY(lazy.processedData.isEmpty());
+    QCOMPARE(eager.processedData.value("bit_count").toInt(), 13);
+
+    const QByteArray eagerBytes = eager.processedData.value("bits").toByteArray();
+    QCOMPARE(eagerBytes.size(), 2);
+    QCOMPARE(lazy.valueCount(), 13);
+    for (int i = 0; i < lazy.valueCount(); ++i) {
+        const bool eagerBit = (static_cast<quint8>(eagerBytes.at(i / 8)) >> (i % 8)) & 1;
+        QCOMPARE(lazy.valueAt(i).toBool(), eagerBit);
+        QCOMPARE(lazy.valueAt(i).toBool(), read.bits.testBit(5 + i));
+    }
+    QVERIFY(!lazy.valueAt(13).isValid());
+}
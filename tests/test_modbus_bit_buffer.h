@@ -0,0 +1,20 @@
+#ifndef TEST_MODBUS_BIT_BUFFER_H
+#define TEST_MODBUS_BIT_BUFFER_H
+
+#include <QtTest/QtTest>
+#include "../include/modbus_bit_buffer.h"
+
+class TestModbusBitBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFromBitValues();
+    void testPackedWordsMatchPduBytes();
+    void testMidAcrossWordBoundary();
+    void testChangeDetection();
+    void testBitReadsStayPacked();
+    void testLazyBitDecodeMatchesEager();
+};
+
+#endif // TEST_MODBUS_BIT_BUFFER_H
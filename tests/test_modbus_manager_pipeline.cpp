@@ -0,0 +1,232 @@
+#include "test_modbus_manager_pipeline.h"
+#include <QSet>
+
+namespace {
+
+const int REQUEST_FRAME_SIZE = 12;  // MBAP header + FC 3 read PDU
+
+// Takes one read request frame off the fake device; false when none is complete
+bool takeRequest(QTcpSocket *device, quint16 *transactionId, quint8 *unitId, quint16 *startAddress)
+{
+    if (device->bytesAvailable() < REQUEST_FRAME_SIZE) {
+        return false;
+    }
+    const QByteArray frame = device->read(REQUEST_FRAME_SIZE);
+    const uchar *bytes = reinterpret_cast<const uchar *>(frame.constData());
+    *transactionId = static_cast<quint16>((bytes[0] << 8) | bytes[1]);
+    *unitId = bytes[6];
+    *startAddress = static_cast<quint16>((bytes[8] << 8) | bytes[9]);
+    return true;
+}
+
+// FC 3 response carrying one register
+void answer(QTcpSocket *device, quint16 transactionId, quint8 unitId, quint8 functionCode, quint16 value)
+{
+    QByteArray frame;
+    frame.append(char(transactionId >> 8));
+    frame.append(char(transactionId & 0xFF));
+    frame.append(QByteArray::fromHex("000000"));
+    frame.append(char(5));  // Unit + FC + byte count + one register
+    frame.append(char(unitId));
+    frame.append(char(functionCode));
+    frame.append(char(2));
+    frame.append(char(value >> 8));
+    frame.append(char(value & 0xFF));
+    device->write(frame);
+    device->flush();
+}
+
+// Exception response: the device is busy (code 0x06)
+void answerBusy(QTcpSocket *device, quint16 transactionId, quint8 unitId, quint8 functionCode)
+{
+    QByteArray frame;
+    frame.append(char(transactionId >> 8));
+    frame.append(char(transactionId & 0xFF));
+    frame.append(QByteArray::fromHex("000000"));
+    frame.append(char(3));  // Unit + FC + exception code
+    frame.append(char(unitId));
+    frame.append(char(functionCode | 0x80));
+    frame.append(char(0x06));
+    device->write(frame);
+    device->flush();
+}
+
+} // namespace
+
+void TestModbusManagerPipeline::init()
+{
+    m_server = new QTcpServer(this);
+    m_device = nullptr;
+    m_manager = new ModbusManager(this);
+    m_manager->initializeClient();
+    m_manager->setNativeEngineEnabled(true);
+    m_results.clear();
+    connect(m_manager, &ModbusManager::readCompleted, this, [this](const ModbusReadResult &result) {
+        m_results.append(result);
+    });
+}
+
+void TestModbusManagerPipeline::cleanup()
+{
+    delete m_manager;
+    m_manager = nullptr;
+    delete m_server;
+    m_server = nullptr;
+}
+
+bool TestModbusManagerPipeline::connectManager(int maxInFlight)
+{
+    if (!m_server->listen(QHostAddress::LocalHost)) {
+        return false;
+    }
+    m_manager->setMaxInFlight(maxInFlight);
+    if (!m_manager->connectToServer("127.0.0.1", m_server->serverPort())) {
+        return false;
+    }
+    QTest::qWaitFor([this]() { return m_server->hasPendingConnections() && m_manager->isConnected(); }, 2000);
+    m_device = m_server->nextPendingConnection();
+    return m_device && m_manager->isConnected();
+}
+
+void TestModbusManagerPipeline::testInFlightWindow()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    QVERIFY(connectManager(2));
+
+    QSet<quint16> transactionIds;
+    for (int i = 0; i < 5; ++i) {
+        const quint16 transactionId = m_manager->readHoldingRegisters(100 + i, 1, ModbusDataType::HoldingRegister);
+        QVERIFY(transactionId != 0);
+        transactionIds.insert(transactionId);
+    }
+    QCOMPARE(transactionIds.size(), 5);  // No ID handed out twice
+
+    // Answer in reverse arrival order; the window never holds more than two
+    QSet<quint16> answered;
+    while (answered.size() < 5) {
+        QTRY_VERIFY_WITH_TIMEOUT(m_device->bytesAvailable() >= REQUEST_FRAME_SIZE, 2000);
+        QTest::qWait(20);
+        QVERIFY(m_manager->inFlightCount() <= 2);
+
+        QList<QPair<quint16, quint16>> requests;
+        quint16 transactionId = 0;
+        quint8 unitId = 0;
+        quint16 startAddress = 0;
+        while (takeRequest(m_device, &transactionId, &unitId, &startAddress)) {
+            QVERIFY(transactionIds.contains(transactionId));
+            QVERIFY(!answered.contains(transactionId));
+            requests.prepend(qMakePair(transactionId, startAddress));
+        }
+        QVERIFY(requests.size() <= 2);
+        for (const auto &request : requests) {
+            answer(m_device, request.first, unitId, 0x03, request.second);
+            answered.insert(request.first);
+        }
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_results.size(), 5, 2000);
+    for (const ModbusReadResult &result : m_results) {
+        QVERIFY(result.success);
+        QVERIFY(transactionIds.contains(result.transactionId));
+        // Each response reached the request it answered
+        QCOMPARE(int(result.rawData.at(0)), result.startAddress);
+    }
+    QCOMPARE(m_manager->inFlightCount(), 0);
+}
+
+void TestModbusManagerPipeline::testConnectionLossFailsEveryTransaction()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    QVERIFY(connectManager(2));
+
+    QSet<quint16> transactionIds;
+    for (int i = 0; i < 4; ++i) {
+        transactionIds.insert(m_manager->readHoldingRegisters(200 + i, 1, ModbusDataType::HoldingRegister));
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(m_manager->inFlightCount(), 2, 2000);
+
+    // Two requests are on the wire and two still queued; all four are answered
+    m_device->abort();
+    QTRY_COMPARE_WITH_TIMEOUT(m_results.size(), 4, 2000);
+
+    QSet<quint16> failed;
+    for (const ModbusReadResult &result : m_results) {
+        QVERIFY(!result.success);
+        QCOMPARE(result.errorType, QModbusDevice::ConnectionError);
+        failed.insert(result.transactionId);
+    }
+    QCOMPARE(failed, transactionIds);
+    QCOMPARE(m_manager->inFlightCount(), 0);
+}
+
+void TestModbusManagerPipeline::testMismatchedResponseFails()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    QVERIFY(connectManager(1));
+
+    const quint16 wrongUnit = m_manager->readHoldingRegisters(300, 1, ModbusDataType::HoldingRegister, 1);
+    quint16 transactionId = 0;
+    quint8 unitId = 0;
+    quint16 startAddress = 0;
+    QTRY_VERIFY_WITH_TIMEOUT(takeRequest(m_device, &transactionId, &unitId, &startAddress), 2000);
+    QCOMPARE(transactionId, wrongUnit);
+    answer(m_device, transactionId, 9, 0x03, 1);
+
+    const quint16 wrongFunction = m_manager->readHoldingRegisters(301, 1, ModbusDataType::HoldingRegister, 1);
+    QTRY_VERIFY_WITH_TIMEOUT(takeRequest(m_device, &transactionId, &unitId, &startAddress), 2000);
+    QCOMPARE(transactionId, wrongFunction);
+    answer(m_device, transactionId, unitId, 0x04, 1);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_results.size(), 2, 2000);
+    QCOMPARE(m_results.at(0).transactionId, wrongUnit);
+    QCOMPARE(m_results.at(1).transactionId, wrongFunction);
+    for (const ModbusReadResult &result : m_results) {
+        QVERIFY(!result.success);
+        QCOMPARE(result.errorType, QModbusDevice::ProtocolError);
+    }
+    QVERIFY(m_manager->isConnected());  // A bad answer fails the request, not the link
+}
+
+
+void TestModbusManagerPipeline::testThrottledUnitDoesNotBlockOthers()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    m_manager->setPacing(10.0, 1);
+    QVERIFY(connectManager(2));
+
+    // Unit 1 answers busy: its rate halves and its bucket is empty
+    m_manager->readHoldingRegisters(400, 1, ModbusDataType::HoldingRegister, 1);
+    quint16 transactionId = 0;
+    quint8 unitId = 0;
+    quint16 startAddress = 0;
+    QTRY_VERIFY_WITH_TIMEOUT(takeRequest(m_device, &transactionId, &unitId, &startAddress), 2000);
+    answerBusy(m_device, transactionId, unitId, 0x03);
+    QTRY_COMPARE_WITH_TIMEOUT(m_results.size(), 1, 2000);
+    QCOMPARE(m_manager->getPacingRate(1), 5.0);
+
+    // Unit 2 queued behind a throttled unit 1 request still goes out first
+    m_manager->readHoldingRegisters(401, 1, ModbusDataType::HoldingRegister, 1);
+    m_manager->readHoldingRegisters(500, 1, ModbusDataType::HoldingRegister, 2);
+    QTRY_VERIFY_WITH_TIMEOUT(takeRequest(m_device, &transactionId, &unitId, &startAddress), 2000);
+    QCOMPARE(int(unitId), 2);
+    QCOMPARE(int(startAddress), 500);
+    answer(m_device, transactionId, unitId, 0x03, startAddress);
+
+    // Unit 1's request follows once its bucket refills
+    QTRY_VERIFY_WITH_TIMEOUT(takeRequest(m_device, &transactionId, &unitId, &startAddress), 2000);
+    QCOMPARE(int(unitId), 1);
+    QCOMPARE(int(startAddress), 401);
+    answer(m_device, transactionId, unitId, 0x03, startAddress);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_results.size(), 3, 2000);
+    QCOMPARE(m_manager->getPacingRate(1), 5.0);
+    QCOMPARE(m_manager->getPacingRate(2), 10.0);
+}
@@ -0,0 +1,33 @@
+#ifndef TEST_MODBUS_MANAGER_PIPELINE_H
+#define TEST_MODBUS_MANAGER_PIPELINE_H
+
+#include <QtTest/QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include "../include/modbusmanager.h"
+#include "../include/modbus_tcp_engine.h"
+
+// Drives ModbusManager's native engine against a loopback fake device
+class TestModbusManagerPipeline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testInFlightWindow();
+    void testConnectionLossFailsEveryTransaction();
+    void testMismatchedResponseFails();
+    void testThrottledUnitDoesNotBlockOthers();
+
+private:
+    bool connectManager(int maxInFlight);
+
+    QTcpServer *m_server;
+    QTcpSocket *m_device;           // Server side of the manager's connection
+    ModbusManager *m_manager;
+    QList<ModbusReadResult> m_results;
+};
+
+#endif // TEST_MODBUS_MANAGER_PIPELINE_H
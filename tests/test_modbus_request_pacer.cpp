@@ -0,0 +1,134 @@
+#include "test_modbus_request_pacer.h"
+
+namespace {
+
+const qint64 START_MS = 1000000;  // Arbitrary epoch; 0 means "never" inside the pacer
+
+// Takes every token available at nowMs; returns how many were sent
+int drain(ModbusRequestPacer &pacer, qint64 nowMs)
+{
+    int sent = 0;
+    while (pacer.msUntilAvailable(nowMs) == 0 && sent < 100) {
+        pacer.consume(nowMs);
+        ++sent;
+    }
+    return sent;
+}
+
+} // namespace
+
+void TestModbusRequestPacer::testTokenRefill()
+{
+    ModbusRequestPacer pacer(10.0, 2);  // One token every 100 ms, bursts of two
+
+    QCOMPARE(drain(pacer, START_MS), 2);
+    QCOMPARE(pacer.msUntilAvailable(START_MS), 100);
+    QCOMPARE(pacer.msUntilAvailable(START_MS + 50), 50);
+    QCOMPARE(pacer.msUntilAvailable(START_MS + 100), 0);
+
+    // A long idle period refills only up to the burst size
+    QCOMPARE(drain(pacer, START_MS + 10000), 2);
+}
+
+void TestModbusRequestPacer::testUnlimitedNeverWaits()
+{
+    ModbusRequestPacer pacer;
+    for (int i = 0; i < 50; ++i) {
+        QCOMPARE(pacer.msUntilAvailable(START_MS), 0);
+        pacer.consume(START_MS);
+    }
+    QVERIFY(!pacer.isThrottled());
+}
+
+void TestModbusRequestPacer::testBusyHalvesRateOncePerWindow()
+{
+    ModbusRequestPacer pacer(20.0, 1);
+
+    QVERIFY(pacer.onDeviceBusy(START_MS, START_MS - 10));
+    QCOMPARE(pacer.currentRate(), 10.0);
+    QVERIFY(pacer.isThrottled());
+    QVERIFY(pacer.msUntilAvailable(START_MS) > 0);  // The cut empties the bucket
+
+    // Replies to requests that were already on the wire at the cut are ignored
+    QVERIFY(!pacer.onDeviceBusy(START_MS + 5, START_MS - 5));
+    QVERIFY(!pacer.onDeviceBusy(START_MS + 5, START_MS));
+    QCOMPARE(pacer.currentRate(), 10.0);
+
+    // A request sent at the new rate and still refused cuts again
+    QVERIFY(pacer.onDeviceBusy(START_MS + 300, START_MS + 200));
+    QCOMPARE(pacer.currentRate(), 5.0);
+
+    // Never below the floor
+    for (int i = 1; i <= 10; ++i) {
+        pacer.onDeviceBusy(START_MS + 1000 * i + 1, START_MS + 1000 * i);
+    }
+    QCOMPARE(pacer.currentRate(), 0.5);
+}
+
+void TestModbusRequestPacer::testBusyWhenUnlimitedStartsFromObservedRate()
+{
+    ModbusRequestPacer pacer;  // Unlimited
+    for (int i = 0; i < 5; ++i) {
+        pacer.consume(START_MS + 100 * i);  // 10 requests/s
+    }
+
+    QVERIFY(pacer.onDeviceBusy(START_MS + 450, START_MS + 400));
+    QCOMPARE(pacer.currentRate(), 5.0);
+    QVERIFY(pacer.isThrottled());
+}
+
+void TestModbusRequestPacer::testAdditiveRecovery()
+{
+    ModbusRequestPacer pacer(20.0, 1);
+    QVERIFY(pacer.onDeviceBusy(START_MS, START_MS - 1));
+    QCOMPARE(pacer.currentRate(), 10.0);
+
+    // Nothing changes during the hold-off after a busy reply
+    pacer.onSuccess(START_MS + 4999);
+    QCOMPARE(pacer.currentRate(), 10.0);
+
+    // Then the rate climbs by a tenth per step, at most one step per second
+    pacer.onSuccess(START_MS + 5000);
+    QCOMPARE(pacer.currentRate(), 11.0);
+    pacer.onSuccess(START_MS + 5500);
+    QCOMPARE(pacer.currentRate(), 11.0);
+    pacer.onSuccess(START_MS + 6000);
+    QCOMPARE(pacer.currentRate(), 12.1);
+
+    // Until the configured rate is restored, never beyond it
+    qint64 now = START_MS + 6000;
+    double previous = pacer.currentRate();
+    while (pacer.isThrottled() && now < START_MS + 60000) {
+        now += 1000;
+        pacer.onSuccess(now);
+        QVERIFY(pacer.currentRate() > previous);
+        previous = pacer.currentRate();
+    }
+    QVERIFY(!pacer.isThrottled());
+    QCOMPARE(pacer.currentRate(), 20.0);
+}
+
+void TestModbusRequestPacer::testNonAdaptiveIgnoresBusy()
+{
+    ModbusRequestPacer pacer(20.0, 1);
+    pacer.setAdaptive(false);
+
+    QVERIFY(!pacer.onDeviceBusy(START_MS, START_MS - 1));
+    QCOMPARE(pacer.currentRate(), 20.0);
+    QVERIFY(!pacer.isThrottled());
+}
+
+void TestModbusRequestPacer::testPacersAreIndependent()
+{
+    // ModbusManager keeps one pacer per unit ID; throttling one leaves the other alone
+    ModbusRequestPacer busyUnit(10.0, 1);
+    ModbusRequestPacer quietUnit(10.0, 1);
+
+    QCOMPARE(drain(busyUnit, START_MS), 1);
+    QVERIFY(busyUnit.onDeviceBusy(START_MS + 10, START_MS));
+    QCOMPARE(busyUnit.currentRate(), 5.0);
+    QVERIFY(busyUnit.msUntilAvailable(START_MS + 10) > 0);
+
+    QCOMPARE(quietUnit.currentRate(), 10.0);
+    QCOMPARE(quietUnit.msUntilAvailable(START_MS + 10), 0);
+}
@@ -0,0 +1,21 @@
+#ifndef TEST_MODBUS_REQUEST_PACER_H
+#define TEST_MODBUS_REQUEST_PACER_H
+
+#include <QtTest/QtTest>
+#include "../include/modbus_request_pacer.h"
+
+class TestModbusRequestPacer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testTokenRefill();
+    void testUnlimitedNeverWaits();
+    void testBusyHalvesRateOncePerWindow();
+    void testBusyWhenUnlimitedStartsFromObservedRate();
+    void testAdditiveRecovery();
+    void testNonAdaptiveIgnoresBusy();
+    void testPacersAreIndependent();
+};
+
+#endif // TEST_MODBUS_REQUEST_PACER_H
@@ -0,0 +1,200 @@
+#include "test_modbus_request_scheduler.h"
+#include <QQueue>
+
+namespace {
+
+const int BENCHMARK_REQUESTS = 10000;
+
+RequestPriority benchmarkPriority(int index)
+{
+    // Mostly normal polls with a sprinkling of writes and heartbeats
+    switch (index % 16) {
+    case 0: return RequestPriority::High;
+    case 1: return RequestPriority::Low;
+    default: return RequestPriority::Normal;
+    }
+}
+
+} // namespace
+
+PriorityModbusRequest TestModbusRequestScheduler::makeRequest(qint64 requestId, RequestPriority priority,
+                                                              qint64 queueTime, qint64 deadline,
+                                                              int unitId, int startAddress)
+{
+    PriorityModbusRequest request;
+    request.requestId = requestId;
+    request.priority = priority;
+    request.queueTime = queueTime;
+    request.request.type = ModbusRequest::ReadHoldingRegisters;
+    request.request.unitId = unitId;
+    request.request.startAddress = startAddress;
+    request.request.count = 1;
+    request.request.deadline = deadline;
+    return request;
+}
+
+void TestModbusRequestScheduler::testPriorityOrder()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.push(makeRequest(1, RequestPriority::Low, 100));
+    scheduler.push(makeRequest(2, RequestPriority::Normal, 101));
+    scheduler.push(makeRequest(3, RequestPriority::Critical, 102));
+    scheduler.push(makeRequest(4, RequestPriority::High, 103));
+    QCOMPARE(scheduler.size(), 4);
+    
+    QCOMPARE(scheduler.pop(0).requestId, qint64(3));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(4));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(2));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(1));
+    QVERIFY(scheduler.isEmpty());
+    QCOMPARE(scheduler.pop(0).requestId, qint64(0));
+}
+
+void TestModbusRequestScheduler::testFifoWithinPriority()
+{
+    // Same queue time everywhere: arrival order decides
+    ModbusRequestScheduler scheduler;
+    for (int i = 1; i <= 5; ++i) {
+        scheduler.push(makeRequest(i, RequestPriority::High, 100, 0, 1, i));
+    }
+    
+    for (int i = 1; i <= 5; ++i) {
+        QCOMPARE(scheduler.pop(0).requestId, qint64(i));
+    }
+}
+
+void TestModbusRequestScheduler::testDeadlineOrderWithinPriority()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.push(makeRequest(1, RequestPriority::Normal, 100, 5000, 1, 10));
+    scheduler.push(makeRequest(2, RequestPriority::Normal, 101, 2000, 1, 20));
+    scheduler.push(makeRequest(3, RequestPriority::Normal, 102, 3000, 1, 30));
+    
+    QCOMPARE(scheduler.pop(0).requestId, qint64(2));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(3));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(1));
+}
+
+void TestModbusRequestScheduler::testSupersededPoll()
+{
+    ModbusRequestScheduler scheduler;
+    PriorityModbusRequest superseded;
+    QVERIFY(!scheduler.push(makeRequest(1, RequestPriority::Normal, 100, 2000), &superseded));
+    QVERIFY(scheduler.push(makeRequest(2, RequestPriority::Normal, 200, 4000), &superseded));
+    QCOMPARE(superseded.requestId, qint64(1));
+    QCOMPARE(scheduler.size(), 1);
+    
+    // Same range without a deadline is not a poll and is never superseded
+    QVERIFY(!scheduler.push(makeRequest(3, RequestPriority::Normal, 300)));
+    QCOMPARE(scheduler.size(), 2);
+    
+    QCOMPARE(scheduler.pop(0).requestId, qint64(3));
+    QCOMPARE(scheduler.pop(0).requestId, qint64(2));
+    QVERIFY(scheduler.isEmpty());
+}
+
+void TestModbusRequestScheduler::testExpiredPollsSkipped()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.push(makeRequest(1, RequestPriority::Normal, 100, 1000, 1, 10));
+    scheduler.push(makeRequest(2, RequestPriority::Normal, 100, 1500, 1, 20));
+    scheduler.push(makeRequest(3, RequestPriority::Normal, 100, 9000, 1, 30));
+    
+    QList<PriorityModbusRequest> expired;
+    QCOMPARE(scheduler.pop(2000, &expired).requestId, qint64(3));
+    QCOMPARE(expired.size(), 2);
+    QCOMPARE(expired.at(0).requestId, qint64(1));
+    QCOMPARE(expired.at(1).requestId, qint64(2));
+    QVERIFY(scheduler.isEmpty());
+}
+
+void TestModbusRequestScheduler::testUnitRoundRobin()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.setUnitFairness(true);
+    
+    // Unit 1 floods the queue before units 2 and 3 get a request in
+    for (int i = 0; i < 4; ++i) {
+        scheduler.push(makeRequest(10 + i, RequestPriority::Normal, 100 + i, 0, 1, i));
+    }
+    scheduler.push(makeRequest(20, RequestPriority::Normal, 200, 0, 2));
+    scheduler.push(makeRequest(30, RequestPriority::Normal, 300, 0, 3));
+    
+    QList<int> units;
+    while (!scheduler.isEmpty()) {
+        units.append(scheduler.pop(0).request.unitId);
+    }
+    QCOMPARE(units, QList<int>({1, 2, 3, 1, 1, 1}));
+}
+
+void TestModbusRequestScheduler::testTakeAllKeepsArrivalOrder()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.push(makeRequest(1, RequestPriority::Low, 100));
+    scheduler.push(makeRequest(2, RequestPriority::Critical, 101));
+    scheduler.push(makeRequest(3, RequestPriority::Normal, 102, 5000));
+    scheduler.push(makeRequest(4, RequestPriority::Normal, 103, 6000));  // Supersedes 3
+    
+    const QList<PriorityModbusRequest> all = scheduler.takeAll();
+    QCOMPARE(all.size(), 3);
+    QCOMPARE(all.at(0).requestId, qint64(1));
+    QCOMPARE(all.at(1).requestId, qint64(2));
+    QCOMPARE(all.at(2).requestId, qint64(4));
+    QVERIFY(scheduler.isEmpty());
+}
+
+void TestModbusRequestScheduler::testHasPriorityAbove()
+{
+    ModbusRequestScheduler scheduler;
+    scheduler.push(makeRequest(1, RequestPriority::High, 100));
+    
+    QVERIFY(scheduler.hasPriorityAbove(RequestPriority::Normal));
+    QVERIFY(!scheduler.hasPriorityAbove(RequestPriority::High));
+    
+    scheduler.pop(0);
+    QVERIFY(!scheduler.hasPriorityAbove(RequestPriority::Low));
+}
+
+void TestModbusRequestScheduler::benchmarkSchedulerPushPop()
+{
+    QList<PriorityModbusRequest> requests;
+    for (int i = 0; i < BENCHMARK_REQUESTS; ++i) {
+        requests.append(makeRequest(i + 1, benchmarkPriority(i), i, 0, 1, i));
+    }
+    
+    QBENCHMARK {
+        ModbusRequestScheduler scheduler;
+        for (const PriorityModbusRequest &request : requests) {
+            scheduler.push(request);
+        }
+        while (!scheduler.isEmpty()) {
+            scheduler.pop(0);
+        }
+    }
+}
+
+void TestModbusRequestScheduler::benchmarkLinearQueuePushPop()
+{
+    // Baseline: the sorted-insert QQueue the worker used before the scheduler
+    QList<PriorityModbusRequest> requests;
+    for (int i = 0; i < BENCHMARK_REQUESTS; ++i) {
+        requests.append(makeRequest(i + 1, benchmarkPriority(i), i, 0, 1, i));
+    }
+    
+    QBENCHMARK {
+        QQueue<PriorityModbusRequest> queue;
+        for (const PriorityModbusRequest &request : requests) {
+            int insertIndex = queue.size();
+            for (int i = 0; i < queue.size(); ++i) {
+                if (static_cast<int>(request.priority) > static_cast<int>(queue.at(i).priority)) {
+                    insertIndex = i;
+                    break;
+                }
+            }
+            queue.insert(insertIndex, request);
+        }
+        while (!queue.isEmpty()) {
+            queue.dequeue();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef TEST_MODBUS_REQUEST_SCHEDULER_H
+#define TEST_MODBUS_REQUEST_SCHEDULER_H
+
+#include <QtTest/QtTest>
+#include "../include/modbus_request_scheduler.h"
+
+class TestModbusRequestScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Ordering tests
+    void testPriorityOrder();
+    void testFifoWithinPriority();
+    void testDeadlineOrderWithinPriority();
+    
+    // Shedding tests
+    void testSupersededPoll();
+    void testExpiredPollsSkipped();
+    
+    // Gateway fairness tests
+    void testUnitRoundRobin();
+    
+    // Queue management tests
+    void testTakeAllKeepsArrivalOrder();
+    void testHasPriorityAbove();
+    
+    // Microbenchmarks (run with -iterations or -tickcounter for stable numbers)
+    void benchmarkSchedulerPushPop();
+    void benchmarkLinearQueuePushPop();
+    
+private:
+    static PriorityModbusRequest makeRequest(qint64 requestId, RequestPriority priority,
+                                             qint64 queueTime, qint64 deadline = 0,
+                                             int unitId = 1, int startAddress = 0);
+};
+
+#endif // TEST_MODBUS_REQUEST_SCHEDULER_H
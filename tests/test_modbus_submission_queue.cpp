@@ -0,0 +1,114 @@
+#include "test_modbus_submission_queue.h"
+#include <QtConcurrent>
+#include <QFuture>
+#include <QSet>
+
+namespace {
+
+PriorityModbusRequest makeRequest(qint64 requestId)
+{
+    PriorityModbusRequest request;
+    request.requestId = requestId;
+    request.request.startAddress = static_cast<int>(requestId % 1000);
+    return request;
+}
+
+} // namespace
+
+void TestModbusSubmissionQueue::testCapacityRoundedToPowerOfTwo()
+{
+    QCOMPARE(ModbusSubmissionQueue(1).capacity(), 2);
+    QCOMPARE(ModbusSubmissionQueue(8).capacity(), 8);
+    QCOMPARE(ModbusSubmissionQueue(100).capacity(), 128);
+}
+
+void TestModbusSubmissionQueue::testFifoOrder()
+{
+    ModbusSubmissionQueue queue(8);
+    for (int i = 1; i <= 5; ++i) {
+        QVERIFY(queue.tryPush(makeRequest(i)));
+    }
+    
+    PriorityModbusRequest request;
+    for (int i = 1; i <= 5; ++i) {
+        QVERIFY(queue.tryPop(request));
+        QCOMPARE(request.requestId, qint64(i));
+    }
+    QVERIFY(!queue.tryPop(request));
+}
+
+void TestModbusSubmissionQueue::testFullQueueRejects()
+{
+    ModbusSubmissionQueue queue(4);
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(queue.tryPush(makeRequest(i)));
+    }
+    QVERIFY(!queue.tryPush(makeRequest(5)));
+    
+    // Popping one frees exactly one slot
+    PriorityModbusRequest request;
+    QVERIFY(queue.tryPop(request));
+    QVERIFY(queue.tryPush(makeRequest(6)));
+    QVERIFY(!queue.tryPush(makeRequest(7)));
+}
+
+void TestModbusSubmissionQueue::testWrapAround()
+{
+    ModbusSubmissionQueue queue(4);
+    PriorityModbusRequest request;
+    
+    // Many laps over the same slots keep order and never report spurious full/empty
+    for (int i = 1; i <= 1000; ++i) {
+        QVERIFY(queue.tryPush(makeRequest(i)));
+        QVERIFY(queue.tryPush(makeRequest(-i)));
+        QVERIFY(queue.tryPop(request));
+        QCOMPARE(request.requestId, qint64(i));
+        QVERIFY(queue.tryPop(request));
+        QCOMPARE(request.requestId, qint64(-i));
+    }
+    QVERIFY(!queue.tryPop(request));
+}
+
+void TestModbusSubmissionQueue::testConcurrentProducers()
+{
+    const int numThreads = 8;
+    const int requestsPerThread = 5000;
+    ModbusSubmissionQueue queue(256);
+    QAtomicInt producersDone(0);
+    
+    QList<QFuture<void>> futures;
+    for (int t = 0; t < numThreads; ++t) {
+        futures.append(QtConcurrent::run([&queue, &producersDone, t, requestsPerThread]() {
+            for (int i = 0; i < requestsPerThread; ++i) {
+                const PriorityModbusRequest request = makeRequest(qint64(t) * requestsPerThread + i + 1);
+                while (!queue.tryPush(request)) {
+                    QThread::yieldCurrentThread();
+                }
+            }
+            producersDone.fetchAndAddOrdered(1);
+        }));
+    }
+    
+    // Single consumer: every request arrives exactly once and per-producer order holds
+    QSet<qint64> seen;
+    QVector<qint64> lastPerProducer(numThreads, 0);
+    PriorityModbusRequest request;
+    while (seen.size() < numThreads * requestsPerThread) {
+        if (!queue.tryPop(request)) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+        QVERIFY(!seen.contains(request.requestId));
+        seen.insert(request.requestId);
+        
+        const int producer = static_cast<int>((request.requestId - 1) / requestsPerThread);
+        QVERIFY(request.requestId > lastPerProducer[producer]);
+        lastPerProducer[producer] = request.requestId;
+    }
+    
+    for (QFuture<void> &future : futures) {
+        future.waitForFinished();
+    }
+    QCOMPARE(producersDone.loadAcquire(), numThreads);
+    QVERIFY(!queue.tryPop(request));
+}
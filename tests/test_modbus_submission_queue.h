@@ -0,0 +1,21 @@
+#ifndef TEST_MODBUS_SUBMISSION_QUEUE_H
+#define TEST_MODBUS_SUBMISSION_QUEUE_H
+
+#include <QtTest/QtTest>
+#include "../include/modbus_submission_queue.h"
+
+class TestModbusSubmissionQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCapacityRoundedToPowerOfTwo();
+    void testFifoOrder();
+    void testFullQueueRejects();
+    void testWrapAround();
+    
+    // Multithreading tests
+    void testConcurrentProducers();
+};
+
+#endif // TEST_MODBUS_SUBMISSION_QUEUE_H
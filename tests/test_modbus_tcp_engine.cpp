@@ -0,0 +1,253 @@
+#include "test_modbus_tcp_engine.h"
+
+namespace {
+
+// MBAP header (protocol 0, length = unit + PDU) followed by the PDU
+QByteArray adu(quint16 transactionId, quint8 unitId, const QByteArray &pdu)
+{
+    QByteArray frame;
+    frame.append(char(transactionId >> 8));
+    frame.append(char(transactionId & 0xFF));
+    frame.append(char(0));
+    frame.append(char(0));
+    frame.append(char((pdu.size() + 1) >> 8));
+    frame.append(char((pdu.size() + 1) & 0xFF));
+    frame.append(char(unitId));
+    frame.append(pdu);
+    return frame;
+}
+
+QByteArray registerPdu(quint8 functionCode, const QVector<quint16> &registers)
+{
+    QByteArray pdu;
+    pdu.append(char(functionCode));
+    pdu.append(char(registers.size() * 2));
+    for (quint16 value : registers) {
+        pdu.append(char(value >> 8));
+        pdu.append(char(value & 0xFF));
+    }
+    return pdu;
+}
+
+void feed(ModbusTcpEngine &engine, const QByteArray &bytes)
+{
+    engine.processReceivedData(bytes.constData(), bytes.size());
+}
+
+ModbusRequest readRequest(ModbusRequest::Type type, ModbusDataType dataType, int count)
+{
+    ModbusRequest request;
+    request.type = type;
+    request.dataType = dataType;
+    request.unitId = 1;
+    request.startAddress = 100;
+    request.count = count;
+    return request;
+}
+
+} // namespace
+
+void TestModbusTcpEngine::testRegisterResponseFraming()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+
+    feed(engine, adu(0x1234, 7, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {0x0102, 0xABCD})));
+
+    QCOMPARE(responses.count(), 1);
+    const QList<QVariant> args = responses.takeFirst();
+    QCOMPARE(args.at(0).value<quint16>(), quint16(0x1234));
+    QCOMPARE(args.at(1).value<quint8>(), quint8(7));
+    QCOMPARE(args.at(2).value<quint8>(), quint8(ModbusTcpEngine::ReadHoldingRegisters));
+    QCOMPARE(args.at(3).toInt(), 4);
+    QCOMPARE(args.at(4).value<QVector<quint16>>(), QVector<quint16>({0x0102, 0xABCD}));
+}
+
+void TestModbusTcpEngine::testMultipleFramesInOneRead()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+
+    QByteArray writeEcho;
+    writeEcho.append(char(ModbusTcpEngine::WriteMultipleRegisters));
+    writeEcho.append(QByteArray::fromHex("00640003"));  // Address 100, quantity 3
+
+    feed(engine, adu(1, 1, registerPdu(ModbusTcpEngine::ReadInputRegisters, {42}))
+                     + adu(2, 1, writeEcho)
+                     + adu(3, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {7, 8})));
+
+    QCOMPARE(responses.count(), 3);
+    QCOMPARE(responses.at(0).at(0).value<quint16>(), quint16(1));
+    QCOMPARE(responses.at(1).at(0).value<quint16>(), quint16(2));
+    QCOMPARE(responses.at(1).at(3).toInt(), 0);
+    QCOMPARE(responses.at(1).at(4).value<QVector<quint16>>(), QVector<quint16>({100, 3}));
+    QCOMPARE(responses.at(2).at(4).value<QVector<quint16>>(), QVector<quint16>({7, 8}));
+}
+
+void TestModbusTcpEngine::testPartialFrameAcrossReads()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+
+    const QByteArray first = adu(10, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {1, 2, 3}));
+    const QByteArray second = adu(11, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {4}));
+
+    // Split inside the MBAP header, then inside the PDU
+    feed(engine, first.left(4));
+    QCOMPARE(responses.count(), 0);
+    feed(engine, first.mid(4, 6));
+    QCOMPARE(responses.count(), 0);
+    feed(engine, first.mid(10) + second.left(9));
+    QCOMPARE(responses.count(), 1);
+    feed(engine, second.mid(9));
+    QCOMPARE(responses.count(), 2);
+
+    QCOMPARE(responses.at(0).at(4).value<QVector<quint16>>(), QVector<quint16>({1, 2, 3}));
+    QCOMPARE(responses.at(1).at(0).value<quint16>(), quint16(11));
+    QCOMPARE(responses.at(1).at(4).value<QVector<quint16>>(), QVector<quint16>({4}));
+}
+
+void TestModbusTcpEngine::testBitResponse()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+
+    // 10 coils in two bytes, packed low byte first into one value
+    QByteArray pdu;
+    pdu.append(char(ModbusTcpEngine::ReadCoils));
+    pdu.append(char(2));
+    pdu.append(char(0xA5));
+    pdu.append(char(0x03));
+    feed(engine, adu(5, 1, pdu));
+
+    QCOMPARE(responses.count(), 1);
+    QCOMPARE(responses.at(0).at(3).toInt(), 2);
+    QCOMPARE(responses.at(0).at(4).value<QVector<quint16>>(), QVector<quint16>({0x03A5}));
+}
+
+void TestModbusTcpEngine::testExceptionFrame()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+    QSignalSpy exceptions(&engine, &ModbusTcpEngine::exceptionReceived);
+
+    QByteArray pdu;
+    pdu.append(char(0x80 | ModbusTcpEngine::ReadHoldingRegisters));
+    pdu.append(char(0x02));  // Illegal data address
+    feed(engine, adu(9, 1, pdu) + adu(10, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {1})));
+
+    QCOMPARE(exceptions.count(), 1);
+    QCOMPARE(exceptions.at(0).at(0).value<quint16>(), quint16(9));
+    QCOMPARE(exceptions.at(0).at(1).value<quint8>(), quint8(ModbusTcpEngine::ReadHoldingRegisters));
+    QCOMPARE(exceptions.at(0).at(2).value<quint8>(), quint8(0x02));
+    QCOMPARE(responses.count(), 1);  // Framing continues after the exception
+}
+
+void TestModbusTcpEngine::testMalformedByteCount()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+    QSignalSpy malformed(&engine, &ModbusTcpEngine::malformedResponse);
+
+    // Byte count claims three registers but the frame carries two
+    QByteArray shortPdu = registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {1, 2});
+    shortPdu[1] = char(6);
+
+    // Read response without a byte count, truncated write echo
+    QByteArray emptyPdu;
+    emptyPdu.append(char(ModbusTcpEngine::ReadCoils));
+    QByteArray shortEcho;
+    shortEcho.append(char(ModbusTcpEngine::WriteSingleRegister));
+    shortEcho.append(QByteArray::fromHex("0064"));
+
+    feed(engine, adu(20, 1, shortPdu) + adu(21, 1, emptyPdu) + adu(22, 1, shortEcho)
+                     + adu(23, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {5})));
+
+    QCOMPARE(malformed.count(), 3);
+    QCOMPARE(malformed.at(0).at(0).value<quint16>(), quint16(20));
+    QCOMPARE(malformed.at(1).at(0).value<quint16>(), quint16(21));
+    QCOMPARE(malformed.at(2).at(0).value<quint16>(), quint16(22));
+
+    // The MBAP length was valid, so the following frame still parses
+    QCOMPARE(responses.count(), 1);
+    QCOMPARE(responses.at(0).at(0).value<quint16>(), quint16(23));
+}
+
+void TestModbusTcpEngine::testInvalidMbapHeader()
+{
+    ModbusTcpEngine engine;
+    QSignalSpy responses(&engine, &ModbusTcpEngine::responseReceived);
+    QSignalSpy errors(&engine, &ModbusTcpEngine::errorOccurred);
+
+    QByteArray frame = adu(30, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {1}));
+    frame[3] = char(1);  // Protocol ID must be 0
+    feed(engine, frame + adu(31, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {2})));
+
+    // Framing is lost: nothing after the bad header is trusted
+    QCOMPARE(errors.count(), 1);
+    QCOMPARE(responses.count(), 0);
+
+    // The receive buffer was reset with the connection
+    feed(engine, adu(32, 1, registerPdu(ModbusTcpEngine::ReadHoldingRegisters, {3})));
+    QCOMPARE(responses.count(), 1);
+    QCOMPARE(responses.at(0).at(0).value<quint16>(), quint16(32));
+}
+
+void TestModbusTcpEngine::testResponseMismatch()
+{
+    const ModbusRequest registers = readRequest(ModbusRequest::ReadHoldingRegisters,
+                                                ModbusDataType::HoldingRegister, 3);
+    QVERIFY(ModbusManager::nativeResponseMismatch(registers, 1, ModbusTcpEngine::ReadHoldingRegisters, 6).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(registers, 1, ModbusTcpEngine::ReadInputRegisters, 6).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(registers, 2, ModbusTcpEngine::ReadHoldingRegisters, 6).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(registers, 1, ModbusTcpEngine::ReadHoldingRegisters, 4).isEmpty());
+
+    // Bit reads are padded to whole bytes
+    const ModbusRequest coils = readRequest(ModbusRequest::ReadCoils, ModbusDataType::Coil, 10);
+    QVERIFY(ModbusManager::nativeResponseMismatch(coils, 1, ModbusTcpEngine::ReadCoils, 2).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(coils, 1, ModbusTcpEngine::ReadCoils, 1).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(coils, 1, ModbusTcpEngine::ReadDiscreteInputs, 2).isEmpty());
+
+    // Writes answer with the single or multiple function code they were sent with
+    ModbusRequest write = readRequest(ModbusRequest::WriteHoldingRegisters, ModbusDataType::HoldingRegister, 1);
+    QVERIFY(ModbusManager::nativeResponseMismatch(write, 1, ModbusTcpEngine::WriteSingleRegister, 0).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(write, 1, ModbusTcpEngine::WriteMultipleRegisters, 0).isEmpty());
+    write.count = 4;
+    QVERIFY(ModbusManager::nativeResponseMismatch(write, 1, ModbusTcpEngine::WriteMultipleRegisters, 0).isEmpty());
+    write.type = ModbusRequest::WriteCoils;
+    QVERIFY(ModbusManager::nativeResponseMismatch(write, 1, ModbusTcpEngine::WriteMultipleCoils, 0).isEmpty());
+    QVERIFY(!ModbusManager::nativeResponseMismatch(write, 3, ModbusTcpEngine::WriteMultipleCoils, 0).isEmpty());
+}
+
+void TestModbusTcpEngine::testConnectByHostName()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    // The lookup runs off the event loop: connectToHost() returns while still resolving
+    ModbusTcpEngine engine;
+    QVERIFY(engine.connectToHost("localhost", server.serverPort(), 2000));
+    QCOMPARE(engine.state(), QModbusDevice::ConnectingState);
+
+    QTRY_VERIFY_WITH_TIMEOUT(engine.isConnected(), 2000);
+    QTRY_VERIFY_WITH_TIMEOUT(server.hasPendingConnections(), 2000);
+    engine.disconnectFromHost();
+    QCOMPARE(engine.state(), QModbusDevice::UnconnectedState);
+}
+
+void TestModbusTcpEngine::testUnresolvableHostFails()
+{
+    if (!ModbusTcpEngine::isSupported()) {
+        QSKIP("Native engine is not available on this platform");
+    }
+    ModbusTcpEngine engine;
+    QSignalSpy errors(&engine, &ModbusTcpEngine::errorOccurred);
+
+    // Reserved TLD (RFC 2606): never resolves; fails by lookup error or by the timeout
+    QVERIFY(engine.connectToHost("modbus-device.invalid", 502, 3000));
+    QTRY_COMPARE_WITH_TIMEOUT(engine.state(), QModbusDevice::UnconnectedState, 5000);
+    QVERIFY(errors.count() >= 1);
+}
@@ -0,0 +1,27 @@
+#ifndef TEST_MODBUS_TCP_ENGINE_H
+#define TEST_MODBUS_TCP_ENGINE_H
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include "../include/modbus_tcp_engine.h"
+#include "../include/modbusmanager.h"
+
+class TestModbusTcpEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRegisterResponseFraming();
+    void testMultipleFramesInOneRead();
+    void testPartialFrameAcrossReads();
+    void testBitResponse();
+    void testExceptionFrame();
+    void testMalformedByteCount();
+    void testInvalidMbapHeader();
+    void testResponseMismatch();
+    void testConnectByHostName();
+    void testUnresolvableHostFails();
+};
+
+#endif // TEST_MODBUS_TCP_ENGINE_H
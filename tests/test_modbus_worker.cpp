@@ -168,6 +168,152 @@ void TestModbusWorker::testClearRequestQueue()
     QVERIFY(newRequestId > 0);
 }
 
+void TestModbusWorker::testCoalescedAdjacentReads()
+{
+    // Loopback fake device; the worker talks to it like any Modbus TCP server
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    delete m_worker;
+    m_worker = new ModbusWorker("127.0.0.1", server.serverPort(), m_testUnitId);
+    m_worker->initializeTimers();
+    m_worker->setHeartbeatEnabled(false);
+    m_worker->startWorker();
+    QTRY_VERIFY_WITH_TIMEOUT(server.hasPendingConnections(), 2000);
+    QTcpSocket *device = server.nextPendingConnection();
+    QVERIFY(device);
+    QTRY_VERIFY_WITH_TIMEOUT(m_worker->isConnected(), 2000);
+    
+    QMap<qint64, ModbusReadResult> results;
+    connect(m_worker, &ModbusWorker::readCompleted, this, [&results](qint64 requestId, const ModbusReadResult &result) {
+        results.insert(requestId, result);
+    });
+    
+    // Two adjacent holding-register reads queued in the same event loop pass
+    ModbusRequest request;
+    request.type = ModbusRequest::ReadHoldingRegisters;
+    request.unitId = m_testUnitId;
+    request.dataType = ModbusDataType::HoldingRegister;
+    request.startAddress = 100;
+    request.count = 2;
+    const qint64 firstId = m_worker->queueReadRequest(request);
+    request.startAddress = 102;
+    const qint64 secondId = m_worker->queueReadRequest(request);
+    
+    // Exactly one FC 3 request covering 100..103 goes out
+    QTRY_VERIFY_WITH_TIMEOUT(device->bytesAvailable() >= 12, 2000);
+    QTest::qWait(50);
+    QCOMPARE(device->bytesAvailable(), qint64(12));
+    const QByteArray frame = device->read(12);
+    const uchar *bytes = reinterpret_cast<const uchar *>(frame.constData());
+    QCOMPARE(int(bytes[7]), 0x03);
+    QCOMPARE((bytes[8] << 8) | bytes[9], 100);
+    QCOMPARE((bytes[10] << 8) | bytes[11], 4);
+    
+    // Registers 100..103 hold 1000..1003
+    QByteArray response = frame.left(4);
+    response.append(char(0));
+    response.append(char(3 + 8));  // Unit + FC + byte count + four registers
+    response.append(frame.at(6));
+    response.append(char(0x03));
+    response.append(char(8));
+    for (quint16 value = 1000; value < 1004; ++value) {
+        response.append(char(value >> 8));
+        response.append(char(value & 0xFF));
+    }
+    device->write(response);
+    device->flush();
+    
+    // Each caller gets its own slice under its own request ID
+    QTRY_COMPARE_WITH_TIMEOUT(results.size(), 2, 2000);
+    QVERIFY(results.value(firstId).success);
+    QCOMPARE(results.value(firstId).startAddress, 100);
+    QCOMPARE(results.value(firstId).rawData.registers(), (QVector<quint16>{1000, 1001}));
+    QVERIFY(results.value(secondId).success);
+    QCOMPARE(results.value(secondId).startAddress, 102);
+    QCOMPARE(results.value(secondId).rawData.registers(), (QVector<quint16>{1002, 1003}));
+    QCOMPARE(device->bytesAvailable(), qint64(0));
+    
+    m_worker->stopWorker();
+}
+
+void TestModbusWorker::testFailedReadsReleasePendingRequests()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    delete m_worker;
+    m_worker = new ModbusWorker("127.0.0.1", server.serverPort(), m_testUnitId);
+    m_worker->initializeTimers();
+    m_worker->setHeartbeatEnabled(false);
+    m_worker->startWorker();
+    QTRY_VERIFY_WITH_TIMEOUT(server.hasPendingConnections(), 2000);
+    QTcpSocket *device = server.nextPendingConnection();
+    QVERIFY(device);
+    QTRY_VERIFY_WITH_TIMEOUT(m_worker->isConnected(), 2000);
+    
+    // Tracked the way ScadaCoreService tracks its reads: every request must end
+    // in readCompleted or requestInterrupted, failed or not
+    const quintptr source = reinterpret_cast<quintptr>(m_worker);
+    PendingRequestTable pending;
+    QMap<qint64, int> terminalSignals;
+    connect(m_worker, &ModbusWorker::readCompleted, this, [&](qint64 requestId, const ModbusReadResult &result) {
+        QVERIFY(!result.success);
+        pending.take(source, requestId);
+        terminalSignals[requestId]++;
+    });
+    connect(m_worker, &ModbusWorker::requestInterrupted, this, [&](qint64 requestId, const QString &) {
+        pending.take(source, requestId);
+        terminalSignals[requestId]++;
+    });
+    
+    // The device refuses every read with "illegal data address"
+    connect(device, &QTcpSocket::readyRead, this, [device]() {
+        while (device->bytesAvailable() >= 12) {
+            const QByteArray frame = device->read(12);
+            QByteArray response = frame.left(4);
+            response.append(char(0));
+            response.append(char(3));
+            response.append(frame.at(6));
+            response.append(char(frame.at(7) | 0x80));
+            response.append(char(0x02));
+            device->write(response);
+        }
+    });
+    
+    auto queueReads = [&](int base) {
+        ModbusRequest request;
+        request.type = ModbusRequest::ReadHoldingRegisters;
+        request.unitId = m_testUnitId;
+        request.dataType = ModbusDataType::HoldingRegister;
+        request.count = 2;
+        for (int address : {base, base + 2, base + 50}) {  // Two coalesce, one goes alone
+            request.startAddress = address;
+            pending.insert(source, m_worker->queueReadRequest(request), PendingRequestTable::Handle(0, 0));
+        }
+    };
+    
+    // Failed reads, plain and coalesced, release their entries round after round
+    for (int round = 0; round < 3; ++round) {
+        queueReads(100 + round * 100);
+        QCOMPARE(pending.size(), 3);
+        QTRY_COMPARE_WITH_TIMEOUT(pending.size(), 0, 2000);
+    }
+    
+    // Reads queued or in flight when the connection drops are released as well
+    disconnect(device, &QTcpSocket::readyRead, this, nullptr);
+    queueReads(1000);
+    QTest::qWait(50);
+    device->abort();
+    QTRY_COMPARE_WITH_TIMEOUT(pending.size(), 0, 5000);
+    
+    // Exactly one terminal signal per request
+    QCOMPARE(terminalSignals.size(), 12);
+    for (int count : terminalSignals) {
+        QCOMPARE(count, 1);
+    }
+    
+    m_worker->stopWorker();
+}
+
 void TestModbusWorker::testStatisticsTracking()
 {
     ModbusWorker::WorkerStatistics initialStats = m_worker->getStatistics();
@@ -4,8 +4,11 @@
 #include <QtTest/QtTest>
 #include <QSignalSpy>
 #include <QTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include "../include/modbus_worker.h"
 #include "../include/modbusmanager.h"
+#include "../include/pending_request_table.h"
 
 class TestModbusWorker : public QObject
 {
@@ -31,6 +34,8 @@ private slots:
     void testQueueWriteRequest();
     void testRequestPriority();
     void testClearRequestQueue();
+    void testCoalescedAdjacentReads();
+    void testFailedReadsReleasePendingRequests();
     
     // Statistics tests
     void testStatisticsTracking();
@@ -90,6 +90,30 @@ void TestModbusWorkerManager::testGetWorker()
     QCOMPARE(worker, createdWorker);
 }
 
+void TestModbusWorkerManager::testGatewayConnectionSharing()
+{
+    m_manager->setGatewayModeEnabled(true);
+    QVERIFY(m_manager->isGatewayModeEnabled());
+    
+    // Unit IDs behind the same gateway share one worker keyed by host:port
+    QString gatewayKey = QString("%1:%2").arg(m_testHost1).arg(m_testPort);
+    QCOMPARE(m_manager->deviceKeyFor(m_testHost1, m_testPort, m_testUnitId1), gatewayKey);
+    QCOMPARE(m_manager->deviceKeyFor(m_testHost1, m_testPort, m_testUnitId2), gatewayKey);
+    
+    ModbusWorker* worker1 = m_manager->getOrCreateWorker(m_testHost1, m_testPort, m_testUnitId1);
+    ModbusWorker* worker2 = m_manager->getOrCreateWorker(m_testHost1, m_testPort, m_testUnitId2);
+    QVERIFY(worker1 != nullptr);
+    QCOMPARE(worker1, worker2);
+    QCOMPARE(m_manager->getWorkerCount(), 1);
+    QVERIFY(worker1->isSharedConnection());
+    QCOMPARE(worker1->getDeviceKey(), gatewayKey);
+    
+    // A different host still gets its own worker
+    ModbusWorker* worker3 = m_manager->getOrCreateWorker(m_testHost2, m_testPort, m_testUnitId1);
+    QVERIFY(worker3 != worker1);
+    QCOMPARE(m_manager->getWorkerCount(), 2);
+}
+
 void TestModbusWorkerManager::testRemoveWorker()
 {
     // Create a worker
@@ -25,6 +25,7 @@ private slots:
     void testRemoveWorker();
     void testRemoveAllWorkers();
     void testGetWorkerCount();
+    void testGatewayConnectionSharing();
     
     // Device management tests
     void testGetActiveDevices();
@@ -0,0 +1,126 @@
+#include "test_pending_request_table.h"
+#include <QRandomGenerator>
+
+namespace {
+
+const quintptr WORKER_A = 0x1000;
+const quintptr WORKER_B = 0x2000;
+
+} // namespace
+
+void TestPendingRequestTable::testInsertAndTake()
+{
+    PendingRequestTable table;
+    table.insert(WORKER_A, 1, PendingRequestTable::Handle(7, 3));
+    QCOMPARE(table.size(), 1);
+
+    PendingRequestTable::Handle handle;
+    QVERIFY(table.take(WORKER_A, 1, &handle));
+    QCOMPARE(handle.pointIndex, quint32(7));
+    QCOMPARE(handle.generation, quint32(3));
+    QCOMPARE(table.size(), 0);
+
+    // Completed requests are gone
+    QVERIFY(!table.take(WORKER_A, 1));
+}
+
+void TestPendingRequestTable::testSameIdFromDifferentSources()
+{
+    // Every worker numbers its requests from 1
+    PendingRequestTable table;
+    table.insert(WORKER_A, 1, PendingRequestTable::Handle(10, 0));
+    table.insert(WORKER_B, 1, PendingRequestTable::Handle(20, 0));
+    QCOMPARE(table.size(), 2);
+
+    PendingRequestTable::Handle handle;
+    QVERIFY(table.take(WORKER_B, 1, &handle));
+    QCOMPARE(handle.pointIndex, quint32(20));
+    QVERIFY(table.take(WORKER_A, 1, &handle));
+    QCOMPARE(handle.pointIndex, quint32(10));
+}
+
+void TestPendingRequestTable::testInsertReplacesHandle()
+{
+    PendingRequestTable table;
+    table.insert(WORKER_A, 5, PendingRequestTable::Handle(1, 0));
+    table.insert(WORKER_A, 5, PendingRequestTable::Handle(2, 0));
+    QCOMPARE(table.size(), 1);
+
+    PendingRequestTable::Handle handle;
+    QVERIFY(table.take(WORKER_A, 5, &handle));
+    QCOMPARE(handle.pointIndex, quint32(2));
+}
+
+void TestPendingRequestTable::testGrowKeepsEntries()
+{
+    PendingRequestTable table(8);
+    const int initialCapacity = table.capacity();
+    for (int i = 1; i <= 1000; ++i) {
+        table.insert(WORKER_A, i, PendingRequestTable::Handle(quint32(i), 0));
+    }
+    QVERIFY(table.capacity() > initialCapacity);
+    QCOMPARE(table.size(), 1000);
+
+    for (int i = 1; i <= 1000; ++i) {
+        PendingRequestTable::Handle handle;
+        QVERIFY(table.take(WORKER_A, i, &handle));
+        QCOMPARE(handle.pointIndex, quint32(i));
+    }
+    QCOMPARE(table.size(), 0);
+}
+
+void TestPendingRequestTable::testRandomChurnMatchesReference()
+{
+    // Interleaved inserts and out-of-order completions exercise backward-shift deletion
+    PendingRequestTable table(16);
+    QHash<QPair<quintptr, qint64>, quint32> reference;
+    QRandomGenerator random(42);
+    qint64 nextId[2] = {1, 1};
+
+    for (int step = 0; step < 20000; ++step) {
+        const int worker = random.bounded(2);
+        const quintptr source = worker == 0 ? WORKER_A : WORKER_B;
+
+        if (reference.size() < 200 && random.bounded(3) != 0) {
+            const qint64 id = nextId[worker]++;
+            const quint32 index = random.generate();
+            table.insert(source, id, PendingRequestTable::Handle(index, 0));
+            reference.insert(qMakePair(source, id), index);
+        } else if (!reference.isEmpty()) {
+            const auto keys = reference.keys();
+            const QPair<quintptr, qint64> key = keys.at(random.bounded(keys.size()));
+            PendingRequestTable::Handle handle;
+            QVERIFY(table.take(key.first, key.second, &handle));
+            QCOMPARE(handle.pointIndex, reference.take(key));
+        }
+        QCOMPARE(table.size(), reference.size());
+    }
+
+    for (auto it = reference.constBegin(); it != reference.constEnd(); ++it) {
+        PendingRequestTable::Handle handle;
+        QVERIFY(table.take(it.key().first, it.key().second, &handle));
+        QCOMPARE(handle.pointIndex, it.value());
+    }
+    QCOMPARE(table.size(), 0);
+}
+
+void TestPendingRequestTable::testRemovePointShiftsLaterHandles()
+{
+    PendingRequestTable table;
+    table.insert(WORKER_A, 1, PendingRequestTable::Handle(2, 11));
+    table.insert(WORKER_A, 2, PendingRequestTable::Handle(5, 12));
+    table.insert(WORKER_B, 1, PendingRequestTable::Handle(9, 13));
+
+    table.removePoint(5);
+    QCOMPARE(table.size(), 3);  // Nothing is dropped; stale handles fail the generation check
+
+    PendingRequestTable::Handle handle;
+    QVERIFY(table.take(WORKER_A, 1, &handle));
+    QCOMPARE(handle.pointIndex, quint32(2));   // Before the removed point: unchanged
+    QVERIFY(table.take(WORKER_A, 2, &handle));
+    QCOMPARE(handle.pointIndex, quint32(5));   // The removed point's own handle
+    QCOMPARE(handle.generation, quint32(12));
+    QVERIFY(table.take(WORKER_B, 1, &handle));
+    QCOMPARE(handle.pointIndex, quint32(8));   // Followed its point down
+    QCOMPARE(handle.generation, quint32(13));
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_PENDING_REQUEST_TABLE_H
+#define TEST_PENDING_REQUEST_TABLE_H
+
+#include <QtTest/QtTest>
+#include "../include/pending_request_table.h"
+
+class TestPendingRequestTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testInsertAndTake();
+    void testSameIdFromDifferentSources();
+    void testInsertReplacesHandle();
+    void testGrowKeepsEntries();
+    void testRemovePointShiftsLaterHandles();
+    void testRandomChurnMatchesReference();
+};
+
+#endif // TEST_PENDING_REQUEST_TABLE_H
@@ -0,0 +1,99 @@
+#include "test_poll_deadline_queue.h"
+
+namespace {
+
+const qint64 START_MS = 1700000000000LL;
+
+} // namespace
+
+void TestPollDeadlineQueue::testEarliestDeadlineFirst()
+{
+    PollDeadlineQueue queue;
+    queue.schedule(3, START_MS + 300);
+    queue.schedule(1, START_MS + 100);
+    queue.schedule(2, START_MS + 100);  // Same deadline as 1: FIFO
+    queue.schedule(0, START_MS + 200);
+    QCOMPARE(queue.size(), 4);
+    
+    QCOMPARE(queue.takeDue(START_MS + 1000), QVector<int>({1, 2, 0, 3}));
+    QVERIFY(queue.isEmpty());
+}
+
+void TestPollDeadlineQueue::testTakeDueOnlyTakesDuePoints()
+{
+    PollDeadlineQueue queue;
+    queue.schedule(0, START_MS);
+    queue.schedule(1, START_MS + 500);
+    
+    QVERIFY(queue.takeDue(START_MS - 1).isEmpty());
+    QCOMPARE(queue.takeDue(START_MS + 499), QVector<int>({0}));
+    QVERIFY(!queue.isScheduled(0));
+    QVERIFY(queue.isScheduled(1));
+    QCOMPARE(queue.takeDue(START_MS + 500), QVector<int>({1}));
+}
+
+void TestPollDeadlineQueue::testRescheduleAndCancel()
+{
+    PollDeadlineQueue queue;
+    queue.schedule(0, START_MS + 100);
+    queue.schedule(1, START_MS + 100);
+    queue.schedule(2, START_MS + 100);
+    
+    queue.schedule(0, START_MS + 900);  // Old entry becomes stale
+    queue.cancel(1);
+    queue.cancel(7);                    // Unknown index is ignored
+    QCOMPARE(queue.size(), 2);
+    
+    QCOMPARE(queue.takeDue(START_MS + 500), QVector<int>({2}));
+    QCOMPARE(queue.takeDue(START_MS + 900), QVector<int>({0}));
+    QVERIFY(queue.isEmpty());
+}
+
+void TestPollDeadlineQueue::testNextDeadline()
+{
+    PollDeadlineQueue queue;
+    QCOMPARE(queue.nextDeadline(), qint64(-1));
+    
+    queue.schedule(0, START_MS + 400);
+    queue.schedule(1, START_MS + 200);
+    QCOMPARE(queue.nextDeadline(), START_MS + 200);
+    
+    queue.cancel(1);  // Stale top is skipped
+    QCOMPARE(queue.nextDeadline(), START_MS + 400);
+    
+    queue.clear();
+    QCOMPARE(queue.nextDeadline(), qint64(-1));
+}
+
+void TestPollDeadlineQueue::testTakeDueBudget()
+{
+    PollDeadlineQueue queue;
+    for (int index = 0; index < 5; ++index) {
+        queue.schedule(index, START_MS + index);
+    }
+    
+    // Earliest deadlines go first; the rest stay due for the next batch
+    QCOMPARE(queue.takeDue(START_MS + 10, 2), QVector<int>({0, 1}));
+    QCOMPARE(queue.size(), 3);
+    QCOMPARE(queue.nextDeadline(), START_MS + 2);
+    QVERIFY(queue.takeDue(START_MS + 10, 0).isEmpty());
+    QCOMPARE(queue.takeDue(START_MS + 10, 10), QVector<int>({2, 3, 4}));
+}
+
+void TestPollDeadlineQueue::testManyReschedules()
+{
+    PollDeadlineQueue queue;
+    for (int round = 0; round < 1000; ++round) {
+        for (int index = 0; index < 10; ++index) {
+            queue.schedule(index, START_MS + round * 10 + (9 - index));
+        }
+    }
+    QCOMPARE(queue.size(), 10);
+    
+    QVector<int> expected;
+    for (int index = 9; index >= 0; --index) {
+        expected.append(index);
+    }
+    QCOMPARE(queue.takeDue(START_MS + 100000), expected);
+    QCOMPARE(queue.nextDeadline(), qint64(-1));
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_POLL_DEADLINE_QUEUE_H
+#define TEST_POLL_DEADLINE_QUEUE_H
+
+#include <QtTest/QtTest>
+#include "../include/poll_deadline_queue.h"
+
+class TestPollDeadlineQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEarliestDeadlineFirst();
+    void testTakeDueOnlyTakesDuePoints();
+    void testRescheduleAndCancel();
+    void testNextDeadline();
+    void testTakeDueBudget();
+    void testManyReschedules();
+};
+
+#endif // TEST_POLL_DEADLINE_QUEUE_H
@@ -0,0 +1,127 @@
+#include "test_poll_plan.h"
+
+namespace {
+
+DataAcquisitionPoint makePoint(ModbusDataType dataType, const QString &registerType = QString())
+{
+    DataAcquisitionPoint point;
+    point.name = "point";
+    point.host = "127.0.0.1";
+    point.port = 502;
+    point.address = 100;
+    point.dataType = dataType;
+    point.tags["unit_id"] = "3";
+    if (!registerType.isEmpty()) {
+        point.tags["register_type"] = registerType;
+    }
+    return point;
+}
+
+DataAcquisitionPoint makeBlock(int blockSize, const QString &registerType, const QString &dataType)
+{
+    DataAcquisitionPoint block = makePoint(ModbusDataType::HoldingRegister, registerType);
+    block.tags["block_type"] = "optimized_read";
+    block.tags["block_size"] = QString::number(blockSize);
+    block.tags["block_start_address"] = QString::number(block.address);
+    block.tags["data_type"] = dataType;
+    return block;
+}
+
+} // namespace
+
+void TestPollPlan::testIndividualHoldingRegisterCounts()
+{
+    PollPlan plan = PollPlan::compile(makePoint(ModbusDataType::Float32, "HOLDING_REGISTER"), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadHoldingRegisters);
+    QVERIFY(plan.dataType == ModbusDataType::Float32);
+    QCOMPARE(plan.count, 2);
+    QCOMPARE(plan.unitId, 3);
+    QCOMPARE(plan.deviceKey, QString("127.0.0.1:502:3"));
+    QVERIFY(!plan.isBlock);
+    
+    plan = PollPlan::compile(makePoint(ModbusDataType::Long64), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadHoldingRegisters);
+    QCOMPARE(plan.count, 4);
+    
+    // Input registers are always read one at a time
+    plan = PollPlan::compile(makePoint(ModbusDataType::Float32, "INPUT_REGISTER"), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadInputRegisters);
+    QCOMPARE(plan.count, 1);
+}
+
+void TestPollPlan::testBlockSizeClamped()
+{
+    PollPlan plan = PollPlan::compile(makeBlock(40, "HOLDING_REGISTER", "Float32"), false);
+    QVERIFY(plan.isBlock);
+    QCOMPARE(plan.count, 40);
+    QVERIFY(plan.dataType == ModbusDataType::HoldingRegister);  // Point type wins over the data_type tag
+    
+    plan = PollPlan::compile(makeBlock(300, "HOLDING_REGISTER", "Int16"), false);
+    QCOMPARE(plan.count, 125);
+    
+    plan = PollPlan::compile(makeBlock(300, "HOLDING_REGISTER", "Int16"), true);
+    QCOMPARE(plan.count, 125);
+}
+
+void TestPollPlan::testRegisterTypeSelectsFunction()
+{
+    PollPlan plan = PollPlan::compile(makePoint(ModbusDataType::HoldingRegister, "COIL"), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadCoils);
+    QVERIFY(plan.dataType == ModbusDataType::Coil);
+    
+    plan = PollPlan::compile(makePoint(ModbusDataType::Coil, "STATUS"), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadCoils);
+    
+    plan = PollPlan::compile(makePoint(ModbusDataType::BOOL, "STATUS"), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadDiscreteInputs);
+    QVERIFY(plan.dataType == ModbusDataType::DiscreteInput);
+    
+    // No register_type: the point's data type decides
+    plan = PollPlan::compile(makePoint(ModbusDataType::BOOL), false);
+    QVERIFY(plan.functionType == ModbusRequest::ReadDiscreteInputs);
+}
+
+void TestPollPlan::testSingleThreadedPlan()
+{
+    // Single-threaded reads keep the point's type and read one register per point
+    PollPlan plan = PollPlan::compile(makePoint(ModbusDataType::Float32, "HOLDING_REGISTER"), true);
+    QVERIFY(plan.functionType == ModbusRequest::ReadHoldingRegisters);
+    QVERIFY(plan.dataType == ModbusDataType::Float32);
+    QCOMPARE(plan.count, 1);
+    
+    plan = PollPlan::compile(makePoint(ModbusDataType::Coil, "STATUS"), true);
+    QVERIFY(plan.functionType == ModbusRequest::ReadDiscreteInputs);
+}
+
+void TestPollPlan::testDispatchRank()
+{
+    DataAcquisitionPoint block = makeBlock(10, "HOLDING_REGISTER", "Int16");
+    block.tags["data_type_priority"] = "2";
+    
+    const int blockRank = PollPlan::compile(block, false).rank;
+    const int int16Rank = PollPlan::compile(makePoint(ModbusDataType::HoldingRegister), false).rank;
+    const int floatRank = PollPlan::compile(makePoint(ModbusDataType::Float32), false).rank;
+    const int doubleRank = PollPlan::compile(makePoint(ModbusDataType::Double64), false).rank;
+    
+    QCOMPARE(blockRank, 2);
+    QVERIFY(blockRank < int16Rank);
+    QVERIFY(int16Rank < floatRank);
+    QVERIFY(floatRank < doubleRank);
+}
+
+void TestPollPlan::testRequestFromPlan()
+{
+    DataAcquisitionPoint point = makePoint(ModbusDataType::Double64, "HOLDING_REGISTER");
+    point.tags["simulation_mode"] = "true";
+    const PollPlan plan = PollPlan::compile(point, false);
+    QVERIFY(plan.simulated);
+    
+    const ModbusRequest request = plan.request(1234);
+    QVERIFY(request.type == ModbusRequest::ReadHoldingRegisters);
+    QCOMPARE(request.startAddress, 100);
+    QCOMPARE(request.count, 4);
+    QCOMPARE(request.unitId, 3);
+    QVERIFY(request.dataType == ModbusDataType::Double64);
+    QCOMPARE(request.requestTime, qint64(1234));
+    QCOMPARE(request.deadline, qint64(0));
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_POLL_PLAN_H
+#define TEST_POLL_PLAN_H
+
+#include <QtTest/QtTest>
+#include "../include/poll_plan.h"
+
+class TestPollPlan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testIndividualHoldingRegisterCounts();
+    void testBlockSizeClamped();
+    void testRegisterTypeSelectsFunction();
+    void testSingleThreadedPlan();
+    void testDispatchRank();
+    void testRequestFromPlan();
+};
+
+#endif // TEST_POLL_PLAN_H
@@ -0,0 +1,100 @@
+#include "test_poll_point_table.h"
+
+namespace {
+
+const qint64 START_MS = 1700000000000LL;
+
+} // namespace
+
+void TestPollPointTable::testAppendSetAndRemove()
+{
+    PollPointTable table;
+    table.append(1000, true);
+    table.append(500, false);
+    table.append(250, true);
+    QCOMPARE(table.size(), 3);
+    QCOMPARE(table.nextDue(0), qint64(0));  // New points are due immediately
+    QVERIFY(!table.isEnabled(1));
+    
+    table.setPoint(1, 750, true);
+    QVERIFY(table.isEnabled(1));
+    QCOMPARE(table.intervalMs(1), 750);
+    
+    table.removeAt(0);
+    QCOMPARE(table.size(), 2);
+    QCOMPARE(table.intervalMs(0), 750);
+    QCOMPARE(table.intervalMs(1), 250);
+    
+    table.clear();
+    QCOMPARE(table.size(), 0);
+}
+
+void TestPollPointTable::testGenerations()
+{
+    PollPointTable table;
+    table.append(1000, true);
+    table.append(1000, true);
+    const quint32 first = table.generation(0);
+    const quint32 second = table.generation(1);
+    QVERIFY(first != second);
+    
+    // Redefining one point leaves the other's generation alone
+    table.setPoint(0, 500, true);
+    const quint32 updated = table.generation(0);
+    QVERIFY(updated != first);
+    QCOMPARE(table.generation(1), second);
+    
+    // A point keeps its generation when earlier points are removed
+    table.removeAt(0);
+    QCOMPARE(table.generation(0), second);
+    
+    // Generations are never handed out again, not even after clear()
+    table.clear();
+    table.append(1000, true);
+    QVERIFY(table.generation(0) != first);
+    QVERIFY(table.generation(0) != second);
+    QVERIFY(table.generation(0) != updated);
+}
+
+void TestPollPointTable::testRescheduleWithoutDrift()
+{
+    PollPointTable table;
+    table.append(1000, true);
+    
+    // First poll starts the cadence at the time it ran
+    QCOMPARE(table.reschedule(0, START_MS, 100), START_MS + 1000);
+    
+    // A late firing keeps the original cadence
+    QCOMPARE(table.reschedule(0, START_MS + 1030, 100), START_MS + 2000);
+    QCOMPARE(table.nextDue(0), START_MS + 2000);
+    
+    // The minimum interval wins over a shorter point interval
+    table.setPoint(0, 50, true);
+    QCOMPARE(table.reschedule(0, START_MS + 2000, 100), START_MS + 2100);
+}
+
+void TestPollPointTable::testRescheduleSkipsMissedSlots()
+{
+    PollPointTable table;
+    table.append(100, true);
+    table.reschedule(0, START_MS, 100);
+    
+    // Stalled for several intervals: the next poll is one interval from now, not a burst of catch-up polls
+    QCOMPARE(table.reschedule(0, START_MS + 550, 100), START_MS + 650);
+}
+
+void TestPollPointTable::testLastPolled()
+{
+    PollPointTable table;
+    table.append(1000, true);
+    table.append(1000, true);
+    QCOMPARE(table.lastPolled(0), qint64(0));  // Never polled
+    
+    table.reschedule(1, START_MS + 40, 100);
+    QCOMPARE(table.lastPolled(0), qint64(0));
+    QCOMPARE(table.lastPolled(1), START_MS + 40);
+    
+    // Follows its point when an earlier one is removed
+    table.removeAt(0);
+    QCOMPARE(table.lastPolled(0), START_MS + 40);
+}
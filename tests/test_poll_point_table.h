@@ -0,0 +1,19 @@
+#ifndef TEST_POLL_POINT_TABLE_H
+#define TEST_POLL_POINT_TABLE_H
+
+#include <QtTest/QtTest>
+#include "../include/poll_point_table.h"
+
+class TestPollPointTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testAppendSetAndRemove();
+    void testGenerations();
+    void testRescheduleWithoutDrift();
+    void testRescheduleSkipsMissedSlots();
+    void testLastPolled();
+};
+
+#endif // TEST_POLL_POINT_TABLE_H
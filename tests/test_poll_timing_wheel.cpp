@@ -0,0 +1,138 @@
+#include "test_poll_timing_wheel.h"
+#include <algorithm>
+
+namespace {
+
+const qint64 TICK_MS = 100;
+const qint64 START_MS = 1700000000000LL;  // Tick aligned epoch ms
+
+QVector<int> sorted(QVector<int> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace
+
+void TestPollTimingWheel::testDueBeforeFirstAdvance()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.schedule(1, 0);
+    wheel.schedule(2, START_MS + 500);
+    QCOMPARE(wheel.size(), 2);
+    
+    QCOMPARE(wheel.advance(START_MS), QVector<int>({1}));
+    QVERIFY(!wheel.isScheduled(1));
+    QVERIFY(wheel.isScheduled(2));
+}
+
+void TestPollTimingWheel::testFiresAtDueTimeNotEarlier()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.advance(START_MS);
+    
+    wheel.schedule(1, START_MS + 250);  // Between ticks: rounds up to 300
+    wheel.schedule(2, START_MS + 1000);
+    
+    QVERIFY(wheel.advance(START_MS + 200).isEmpty());
+    QVERIFY(wheel.advance(START_MS + 299).isEmpty());
+    QCOMPARE(wheel.advance(START_MS + 300), QVector<int>({1}));
+    QVERIFY(wheel.advance(START_MS + 900).isEmpty());
+    QCOMPARE(wheel.advance(START_MS + 1050), QVector<int>({2}));
+    QCOMPARE(wheel.size(), 0);
+}
+
+void TestPollTimingWheel::testCancelAndReschedule()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.advance(START_MS);
+    
+    wheel.schedule(1, START_MS + 200);
+    wheel.schedule(2, START_MS + 200);
+    wheel.cancel(1);
+    wheel.schedule(2, START_MS + 600);  // Moves 2; the old entry is stale
+    
+    QVERIFY(wheel.advance(START_MS + 500).isEmpty());
+    QCOMPARE(wheel.advance(START_MS + 600), QVector<int>({2}));
+    
+    // Scheduling in the past fires on the next advance
+    wheel.schedule(3, START_MS);
+    QCOMPARE(wheel.advance(START_MS + 600), QVector<int>({3}));
+}
+
+void TestPollTimingWheel::testCascadeFromLevelOne()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.advance(START_MS);
+    
+    // 300 ticks and 5000 ticks out: both start on level 1
+    wheel.schedule(1, START_MS + 300 * TICK_MS);
+    wheel.schedule(2, START_MS + 5000 * TICK_MS);
+    
+    QVector<int> fired;
+    qint64 firstFire = 0;
+    for (qint64 now = START_MS; now <= START_MS + 6000 * TICK_MS; now += TICK_MS) {
+        const QVector<int> due = wheel.advance(now);
+        if (!due.isEmpty() && fired.isEmpty()) {
+            firstFire = now;
+        }
+        fired += due;
+    }
+    QCOMPARE(fired, QVector<int>({1, 2}));
+    QCOMPARE(firstFire, START_MS + 300 * TICK_MS);
+}
+
+void TestPollTimingWheel::testOverflowBeyondWheelSpan()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.advance(START_MS);
+    
+    const qint64 due = START_MS + 20000 * TICK_MS;  // Beyond 256 * 64 ticks
+    wheel.schedule(1, due);
+    
+    // Advance in one-second steps so the wheel steps through every tick
+    qint64 firedAt = 0;
+    for (qint64 now = START_MS; now <= due + 1000; now += 1000) {
+        if (!wheel.advance(now).isEmpty()) {
+            firedAt = now;
+            break;
+        }
+    }
+    QCOMPARE(firedAt, due);
+}
+
+void TestPollTimingWheel::testLargeGapRebuild()
+{
+    PollTimingWheel wheel(TICK_MS);
+    wheel.advance(START_MS);
+    
+    wheel.schedule(1, START_MS + 1000);
+    wheel.schedule(2, START_MS + 3600000);
+    wheel.schedule(3, START_MS + 7200000);
+    
+    // One jump of two hours (e.g. after a long disconnect)
+    QCOMPARE(sorted(wheel.advance(START_MS + 7200000)), QVector<int>({1, 2, 3}));
+    QCOMPARE(wheel.size(), 0);
+}
+
+void TestPollTimingWheel::testPeriodicPolling()
+{
+    // Three points at different intervals, driven like the worker poll timer
+    PollTimingWheel wheel(TICK_MS);
+    const qint64 intervals[] = {1000, 2000, 5000};
+    for (int id = 0; id < 3; ++id) {
+        wheel.schedule(id, 0);
+    }
+    
+    int polls[3] = {0, 0, 0};
+    for (qint64 now = START_MS; now < START_MS + 10000; now += 500) {
+        for (int id : wheel.advance(now)) {
+            polls[id]++;
+            wheel.schedule(id, now + intervals[id]);
+        }
+    }
+    
+    QCOMPARE(polls[0], 10);
+    QCOMPARE(polls[1], 5);
+    QCOMPARE(polls[2], 2);
+}
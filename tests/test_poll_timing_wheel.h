@@ -0,0 +1,21 @@
+#ifndef TEST_POLL_TIMING_WHEEL_H
+#define TEST_POLL_TIMING_WHEEL_H
+
+#include <QtTest/QtTest>
+#include "../include/poll_timing_wheel.h"
+
+class TestPollTimingWheel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDueBeforeFirstAdvance();
+    void testFiresAtDueTimeNotEarlier();
+    void testCancelAndReschedule();
+    void testCascadeFromLevelOne();
+    void testOverflowBeyondWheelSpan();
+    void testLargeGapRebuild();
+    void testPeriodicPolling();
+};
+
+#endif // TEST_POLL_TIMING_WHEEL_H
@@ -0,0 +1,225 @@
+#include "test_register_decode_kernels.h"
+#include "../include/modbusmanager.h"
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+typedef RegisterDecodeKernels::Isa Isa;
+
+// A full 125-register read: 62 floats plus a stray register
+const int BLOCK_REGISTERS = 125;
+
+QVector<quint16> randomRegisters(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QVector<quint16> registers(count);
+    for (int i = 0; i < count; ++i) {
+        registers[i] = static_cast<quint16>(random.bounded(0x10000));
+    }
+    return registers;
+}
+
+// Expected bits spelled out from the ABCD value, independent of RegisterWordOrder
+quint32 reordered32(const quint16 *registers, RegisterByteOrder order)
+{
+    const quint32 abcd = (quint32(registers[0]) << 16) | registers[1];
+    switch (order) {
+    case RegisterByteOrder::CDAB:
+        return (abcd << 16) | (abcd >> 16);
+    case RegisterByteOrder::BADC:
+        return ((abcd & 0x00FF00FFu) << 8) | ((abcd >> 8) & 0x00FF00FFu);
+    case RegisterByteOrder::DCBA:
+        return qbswap(abcd);
+    default:
+        return abcd;
+    }
+}
+
+quint64 reordered64(const quint16 *registers, RegisterByteOrder order)
+{
+    const quint64 abcd = (quint64(registers[0]) << 48) | (quint64(registers[1]) << 32) |
+                         (quint64(registers[2]) << 16) | registers[3];
+    switch (order) {
+    case RegisterByteOrder::CDAB:
+        return (quint64(registers[3]) << 48) | (quint64(registers[2]) << 32) |
+               (quint64(registers[1]) << 16) | registers[0];
+    case RegisterByteOrder::BADC:
+        return ((abcd & 0x00FF00FF00FF00FFull) << 8) | ((abcd >> 8) & 0x00FF00FF00FF00FFull);
+    case RegisterByteOrder::DCBA:
+        return qbswap(abcd);
+    default:
+        return abcd;
+    }
+}
+
+bool isFinite(const QVector<quint64> &mask, int index)
+{
+    return (mask.at(index >> 6) >> (index & 63)) & 1;
+}
+
+} // namespace
+
+void TestRegisterDecodeKernels::testFloat32MatchesScalarConversion()
+{
+    const QVector<quint16> registers = randomRegisters(BLOCK_REGISTERS, 1);
+    QVector<float> values(BLOCK_REGISTERS / 2);
+    QCOMPARE(RegisterDecodeKernels::decodeFloat32(registers.constData(), registers.size(), values.data()),
+             BLOCK_REGISTERS / 2);
+
+    for (int i = 0; i < values.size(); ++i) {
+        const float expected = ModbusManager::registersToFloat32(registers[2 * i], registers[2 * i + 1]);
+        QVERIFY(std::memcmp(&expected, &values[i], sizeof(float)) == 0);
+    }
+
+    const quint16 doubleRegisters[4] = {0x4000, 0x0000, 0x0000, 0x0000};
+    double doubleValue = 0.0;
+    QCOMPARE(RegisterDecodeKernels::decodeDouble64(doubleRegisters, 4, &doubleValue), 1);
+    QCOMPARE(doubleValue, 2.0);
+
+    const quint16 longRegisters[2] = {0xFFFF, 0xFFFE};
+    qint32 longValue = 0;
+    QCOMPARE(RegisterDecodeKernels::decodeInt32(longRegisters, 2, &longValue), 1);
+    QCOMPARE(longValue, -2);
+}
+
+void TestRegisterDecodeKernels::testFiniteMaskFlagsNaNAndInf()
+{
+    // Twelve floats so the vector body and the scalar tail both see specials
+    QVector<quint16> registers(24, 0x3F80);  // 1.00195...
+    registers[2] = 0x7F80; registers[3] = 0x0000;    // +Inf at 1
+    registers[10] = 0x7FC0; registers[11] = 0x0000;  // NaN at 5
+    registers[22] = 0xFF80; registers[23] = 0x0000;  // -Inf at 11
+
+    for (int isa = 0; isa <= int(Isa::Avx2); ++isa) {
+        if (!RegisterDecodeKernels::isSupported(Isa(isa))) {
+            continue;
+        }
+        QVector<float> values(12);
+        QVector<quint64> mask(1, ~quint64(0));
+        RegisterDecodeKernels::decodeFloat32(Isa(isa), registers.constData(), registers.size(), values.data(), mask.data());
+        for (int i = 0; i < values.size(); ++i) {
+            QCOMPARE(isFinite(mask, i), i != 1 && i != 5 && i != 11);
+        }
+        // Bits past the last value stay clear
+        QCOMPARE(mask.at(0) >> 12, quint64(0));
+    }
+
+    QVector<quint16> doubleRegisters(16, 0x3FF0);
+    doubleRegisters[4] = 0x7FF0; doubleRegisters[5] = 0; doubleRegisters[6] = 0; doubleRegisters[7] = 0;
+    QVector<double> doubles(4);
+    QVector<quint64> mask(1);
+    RegisterDecodeKernels::decodeDouble64(doubleRegisters.constData(), doubleRegisters.size(), doubles.data(), mask.data());
+    QCOMPARE(mask.at(0), quint64(0xD));
+}
+
+void TestRegisterDecodeKernels::testEveryIsaMatchesScalar()
+{
+    for (int count = 0; count <= BLOCK_REGISTERS; ++count) {
+        const QVector<quint16> registers = randomRegisters(count, 100 + count);
+        QVector<float> expectedFloats(64), floats(64);
+        QVector<qint32> expectedLongs(64), longs(64);
+        QVector<double> expectedDoubles(32), doubles(32);
+        QVector<quint64> expectedMask(1), mask(1);
+
+        const int floatCount = RegisterDecodeKernels::decodeFloat32(Isa::Scalar, registers.constData(), count,
+                                                                    expectedFloats.data(), expectedMask.data());
+        RegisterDecodeKernels::decodeInt32(Isa::Scalar, registers.constData(), count, expectedLongs.data());
+        QVector<quint64> expectedDoubleMask(1), doubleMask(1);
+        const int doubleCount = RegisterDecodeKernels::decodeDouble64(Isa::Scalar, registers.constData(), count,
+                                                                      expectedDoubles.data(), expectedDoubleMask.data());
+
+        for (int isa = int(Isa::Sse41); isa <= int(Isa::Avx2); ++isa) {
+            if (!RegisterDecodeKernels::isSupported(Isa(isa))) {
+                continue;
+            }
+            QCOMPARE(RegisterDecodeKernels::decodeFloat32(Isa(isa), registers.constData(), count, floats.data(), mask.data()),
+                     floatCount);
+            QVERIFY(std::memcmp(floats.constData(), expectedFloats.constData(), floatCount * sizeof(float)) == 0);
+            QCOMPARE(mask, expectedMask);
+
+            RegisterDecodeKernels::decodeInt32(Isa(isa), registers.constData(), count, longs.data());
+            QVERIFY(std::memcmp(longs.constData(), expectedLongs.constData(), floatCount * sizeof(qint32)) == 0);
+
+            QCOMPARE(RegisterDecodeKernels::decodeDouble64(Isa(isa), registers.constData(), count, doubles.data(), doubleMask.data()),
+                     doubleCount);
+            QVERIFY(std::memcmp(doubles.constData(), expectedDoubles.constData(), doubleCount * sizeof(double)) == 0);
+            QCOMPARE(doubleMask, expectedDoubleMask);
+        }
+    }
+}
+
+void TestRegisterDecodeKernels::testByteOrdersReorderBytes()
+{
+    const QVector<quint16> registers = randomRegisters(BLOCK_REGISTERS, 11);
+    for (int order = 0; order < 4; ++order) {
+        const RegisterByteOrder byteOrder = RegisterByteOrder(order);
+        for (int isa = 0; isa <= int(Isa::Avx2); ++isa) {
+            if (!RegisterDecodeKernels::isSupported(Isa(isa))) {
+                continue;
+            }
+            QVector<float> floats(64);
+            QVector<qint32> longs(64);
+            QVector<double> doubles(32);
+            QVector<quint64> floatMask(1), doubleMask(1);
+            RegisterDecodeKernels::decodeFloat32(Isa(isa), registers.constData(), registers.size(), floats.data(),
+                                                 floatMask.data(), byteOrder);
+            RegisterDecodeKernels::decodeInt32(Isa(isa), registers.constData(), registers.size(), longs.data(), byteOrder);
+            RegisterDecodeKernels::decodeDouble64(Isa(isa), registers.constData(), registers.size(), doubles.data(),
+                                                  doubleMask.data(), byteOrder);
+
+            for (int i = 0; i < BLOCK_REGISTERS / 2; ++i) {
+                const quint32 expected = reordered32(registers.constData() + 2 * i, byteOrder);
+                quint32 bits;
+                std::memcpy(&bits, &floats[i], sizeof(float));
+                QCOMPARE(bits, expected);
+                QCOMPARE(quint32(longs[i]), expected);
+                QCOMPARE(isFinite(floatMask, i), (expected & 0x7F800000u) != 0x7F800000u);
+            }
+            for (int i = 0; i < BLOCK_REGISTERS / 4; ++i) {
+                quint64 bits;
+                std::memcpy(&bits, &doubles[i], sizeof(double));
+                QCOMPARE(bits, reordered64(registers.constData() + 4 * i, byteOrder));
+            }
+        }
+    }
+}
+
+void TestRegisterDecodeKernels::testOddCountIgnoresTrailingRegister()
+{
+    const quint16 registers[3] = {0x3FC0, 0x0000, 0x4120};
+    float values[2] = {0.0f, -1.0f};
+    QCOMPARE(RegisterDecodeKernels::decodeFloat32(registers, 3, values), 1);
+    QCOMPARE(values[0], 1.5f);
+    QCOMPARE(values[1], -1.0f);
+}
+
+void TestRegisterDecodeKernels::benchmarkFloat32PerValue()
+{
+    const QVector<quint16> registers = randomRegisters(BLOCK_REGISTERS, 7);
+    QVector<float> values(BLOCK_REGISTERS / 2);
+    int finite = 0;
+    QBENCHMARK {
+        finite = 0;
+        for (int i = 0; i < values.size(); ++i) {
+            values[i] = ModbusManager::registersToFloat32(registers[2 * i], registers[2 * i + 1]);
+            if (!ModbusManager::isFloat32NaN(values[i]) && !ModbusManager::isFloat32Inf(values[i])) {
+                ++finite;
+            }
+        }
+    }
+    QVERIFY(finite > 0);
+}
+
+void TestRegisterDecodeKernels::benchmarkFloat32Batch()
+{
+    qDebug() << "Decode kernel:" << RegisterDecodeKernels::isaName(RegisterDecodeKernels::activeIsa());
+    const QVector<quint16> registers = randomRegisters(BLOCK_REGISTERS, 7);
+    QVector<float> values(BLOCK_REGISTERS / 2);
+    QVector<quint64> mask(1);
+    QBENCHMARK {
+        RegisterDecodeKernels::decodeFloat32(registers.constData(), registers.size(), values.data(), mask.data());
+    }
+    QVERIFY(mask.at(0) != 0);
+}
@@ -0,0 +1,21 @@
+#ifndef TEST_REGISTER_DECODE_KERNELS_H
+#define TEST_REGISTER_DECODE_KERNELS_H
+
+#include <QtTest/QtTest>
+#include "../include/register_decode_kernels.h"
+
+class TestRegisterDecodeKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFloat32MatchesScalarConversion();
+    void testFiniteMaskFlagsNaNAndInf();
+    void testEveryIsaMatchesScalar();
+    void testByteOrdersReorderBytes();
+    void testOddCountIgnoresTrailingRegister();
+    void benchmarkFloat32PerValue();
+    void benchmarkFloat32Batch();
+};
+
+#endif // TEST_REGISTER_DECODE_KERNELS_H
@@ -0,0 +1,178 @@
+#include "test_report_by_exception_filter.h"
+
+namespace {
+
+ReportDeadband deadband(double absolute, double percent, int maxSilenceMs)
+{
+    ReportDeadband band;
+    band.absolute = absolute;
+    band.percent = percent;
+    band.maxSilenceMs = maxSilenceMs;
+    return band;
+}
+
+} // namespace
+
+void TestReportByExceptionFilter::testDeadbandFromString()
+{
+    bool ok = false;
+    ReportDeadband band = ReportDeadband::fromString("0.5:2:60000", &ok);
+    QVERIFY(ok);
+    QCOMPARE(band.absolute, 0.5);
+    QCOMPARE(band.percent, 2.0);
+    QCOMPARE(band.maxSilenceMs, 60000);
+
+    // Round trip through the block tag form
+    band = ReportDeadband::fromString(band.toString(), &ok);
+    QVERIFY(ok);
+    QCOMPARE(band.absolute, 0.5);
+    QCOMPARE(band.maxSilenceMs, 60000);
+
+    // Missing fields are 0
+    band = ReportDeadband::fromString("1.5", &ok);
+    QVERIFY(ok);
+    QCOMPARE(band.absolute, 1.5);
+    QCOMPARE(band.percent, 0.0);
+    QVERIFY(ReportDeadband::fromString("", &ok).isEnabled() == false);
+    QVERIFY(ok);
+
+    // Garbage and negative bands disable filtering
+    QVERIFY(!ReportDeadband::fromString("abc:1:0", &ok).isEnabled());
+    QVERIFY(!ok);
+    QVERIFY(!ReportDeadband::fromString("-1:0:0", &ok).isEnabled());
+    QVERIFY(!ok);
+    QVERIFY(!ReportDeadband::fromString("1:1:1:1", &ok).isEnabled());
+    QVERIFY(!ok);
+}
+
+void TestReportByExceptionFilter::testUntrackedPointsAlwaysReport()
+{
+    ReportByExceptionFilter filter;
+    QVERIFY(filter.shouldReport("FLOW", 1.0, 1000));
+    QVERIFY(filter.shouldReport("FLOW", 1.0, 2000));
+
+    // A disabled band does not track the point
+    filter.setDeadband("FLOW", ReportDeadband());
+    QCOMPARE(filter.size(), 0);
+    QVERIFY(filter.shouldReport("FLOW", 1.0, 3000));
+
+    QCOMPARE(filter.metrics().reported, qint64(3));
+    QCOMPARE(filter.metrics().suppressed, qint64(0));
+}
+
+void TestReportByExceptionFilter::testAbsoluteDeadband()
+{
+    ReportByExceptionFilter filter;
+    filter.setDeadband("PRESSURE", deadband(0.5, 0, 0));
+    QVERIFY(filter.isTracked("PRESSURE"));
+
+    QVERIFY(filter.shouldReport("PRESSURE", 10.0, 1000));   // First sample
+    QVERIFY(!filter.shouldReport("PRESSURE", 10.3, 2000));
+    QVERIFY(!filter.shouldReport("PRESSURE", 10.5, 3000));  // Exactly on the band
+    // Measured from the last report, so slow drift is still reported
+    QVERIFY(filter.shouldReport("PRESSURE", 10.6, 4000));
+    QVERIFY(!filter.shouldReport("PRESSURE", 10.2, 5000));
+    QVERIFY(filter.shouldReport("PRESSURE", 10.0, 6000));
+
+    // Integer registers use the same band
+    filter.setDeadband("LEVEL", deadband(0, 0, 60000));
+    QVERIFY(filter.shouldReport("LEVEL", quint16(100), 1000));
+    QVERIFY(!filter.shouldReport("LEVEL", quint16(100), 2000));
+    QVERIFY(filter.shouldReport("LEVEL", quint16(101), 3000));  // Zero band: any change
+
+    // NaN reports once when it appears and once when it clears
+    QVERIFY(filter.shouldReport("PRESSURE", qQNaN(), 7000));
+    QVERIFY(!filter.shouldReport("PRESSURE", qQNaN(), 8000));
+    QVERIFY(filter.shouldReport("PRESSURE", 10.0, 9000));
+
+    QCOMPARE(filter.metrics().trackedPoints, 2);
+    QCOMPARE(filter.metrics().reported, qint64(7));
+    QCOMPARE(filter.metrics().suppressed, qint64(5));
+}
+
+void TestReportByExceptionFilter::testPercentDeadband()
+{
+    ReportByExceptionFilter filter;
+    filter.setDeadband("FLOW", deadband(0.1, 1.0, 0));
+
+    QVERIFY(filter.shouldReport("FLOW", 1000.0, 1000));
+    QVERIFY(!filter.shouldReport("FLOW", 1009.0, 2000));  // 1% of 1000 is 10
+    QVERIFY(filter.shouldReport("FLOW", 989.0, 3000));
+
+    // Near zero the absolute band takes over
+    QVERIFY(filter.shouldReport("FLOW", 0.0, 4000));
+    QVERIFY(!filter.shouldReport("FLOW", 0.05, 5000));
+    QVERIFY(filter.shouldReport("FLOW", 0.2, 6000));
+}
+
+void TestReportByExceptionFilter::testHeartbeat()
+{
+    ReportByExceptionFilter filter;
+    filter.setDeadband("TEMP", deadband(1.0, 0, 60000));
+
+    QVERIFY(filter.shouldReport("TEMP", 20.0, 0));
+    QVERIFY(!filter.shouldReport("TEMP", 20.0, 59999));
+    QVERIFY(filter.shouldReport("TEMP", 20.0, 60000));   // Max silence reached
+    QVERIFY(!filter.shouldReport("TEMP", 20.5, 61000));  // Heartbeat restarted the silence
+    QVERIFY(filter.shouldReport("TEMP", 20.5, 120000));
+
+    // A clock step backwards reports instead of going silent until it catches up
+    QVERIFY(filter.shouldReport("TEMP", 20.5, 1000));
+
+    // Changing the band keeps the reference value
+    filter.setDeadband("TEMP", deadband(0, 0, 1000));
+    QVERIFY(!filter.shouldReport("TEMP", 20.5, 1500));
+    QVERIFY(filter.shouldReport("TEMP", 20.6, 1600));
+}
+
+void TestReportByExceptionFilter::testBooleanAndOpaqueValues()
+{
+    ReportByExceptionFilter filter;
+
+    // Booleans ignore the analog band
+    filter.setDeadband("PUMP_RUNNING", deadband(5.0, 0, 0));
+    QVERIFY(filter.shouldReport("PUMP_RUNNING", false, 1000));
+    QVERIFY(!filter.shouldReport("PUMP_RUNNING", false, 2000));
+    QVERIFY(filter.shouldReport("PUMP_RUNNING", true, 3000));
+
+    // A change of value type is reported
+    QVERIFY(filter.shouldReport("PUMP_RUNNING", 1, 4000));
+
+    filter.setDeadband("MODE", deadband(0, 0, 60000));
+    QVERIFY(filter.shouldReport("MODE", QString("AUTO"), 1000));
+    QVERIFY(!filter.shouldReport("MODE", QString("AUTO"), 2000));
+    QVERIFY(filter.shouldReport("MODE", QString("MANUAL"), 3000));
+
+    // Invalid values are left for the sink to reject
+    QVERIFY(filter.shouldReport("MODE", QVariant(), 4000));
+    QVERIFY(!filter.shouldReport("MODE", QString("MANUAL"), 5000));
+}
+
+void TestReportByExceptionFilter::testRemoveKeepsOtherSlots()
+{
+    ReportByExceptionFilter filter;
+    const QStringList names = {"A", "B", "C", "D"};
+    for (int i = 0; i < names.size(); ++i) {
+        filter.setDeadband(names.at(i), deadband(1.0, 0, 0));
+        QVERIFY(filter.shouldReport(names.at(i), 10.0 * i, 1000));
+    }
+    filter.setDeadband("E", deadband(0, 0, 60000));
+    QVERIFY(filter.shouldReport("E", QString("on"), 1000));
+
+    // Removing moves the last slot into the hole
+    filter.remove("B");
+    QCOMPARE(filter.size(), 4);
+    QVERIFY(!filter.isTracked("B"));
+    QVERIFY(filter.shouldReport("B", 10.0, 2000));
+
+    QVERIFY(!filter.shouldReport("A", 0.5, 2000));
+    QVERIFY(!filter.shouldReport("C", 20.5, 2000));
+    QVERIFY(!filter.shouldReport("D", 30.5, 2000));
+    QVERIFY(!filter.shouldReport("E", QString("on"), 2000));
+    QVERIFY(filter.shouldReport("E", QString("off"), 3000));
+
+    filter.clear();
+    QCOMPARE(filter.size(), 0);
+    QVERIFY(filter.shouldReport("A", 0.5, 4000));
+    QVERIFY(filter.metrics().suppressed > 0);  // Metrics survive clear()
+}
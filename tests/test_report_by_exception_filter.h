@@ -0,0 +1,21 @@
+#ifndef TEST_REPORT_BY_EXCEPTION_FILTER_H
+#define TEST_REPORT_BY_EXCEPTION_FILTER_H
+
+#include <QtTest/QtTest>
+#include "../include/report_by_exception_filter.h"
+
+class TestReportByExceptionFilter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDeadbandFromString();
+    void testUntrackedPointsAlwaysReport();
+    void testAbsoluteDeadband();
+    void testPercentDeadband();
+    void testHeartbeat();
+    void testBooleanAndOpaqueValues();
+    void testRemoveKeepsOtherSlots();
+};
+
+#endif // TEST_REPORT_BY_EXCEPTION_FILTER_H
@@ -0,0 +1,118 @@
+#include "test_single_flight_table.h"
+
+namespace {
+
+const quint64 KEY = 0x0301000000640005ULL;  // FC 3, unit 1, address 100, count 5
+
+PriorityModbusRequest poll(qint64 requestId, RequestPriority priority = RequestPriority::Normal)
+{
+    PriorityModbusRequest request;
+    request.requestId = requestId;
+    request.priority = priority;
+    request.request.type = ModbusRequest::ReadHoldingRegisters;
+    request.request.unitId = 1;
+    request.request.startAddress = 100;
+    request.request.count = 5;
+    return request;
+}
+
+} // namespace
+
+void TestSingleFlightTable::testJoinDispatchedLeader()
+{
+    SingleFlightTable table;
+    table.lead(KEY, 1, RequestPriority::Normal);
+    table.markDispatched(1);
+
+    QVERIFY(table.join(KEY, poll(2)));
+    QVERIFY(table.join(KEY, poll(3, RequestPriority::Low)));
+    QVERIFY(!table.join(KEY + 1, poll(4)));  // Different range
+
+    const QList<PriorityModbusRequest> followers = table.take(1);
+    QCOMPARE(followers.size(), 2);
+    QCOMPARE(followers.at(0).requestId, qint64(2));
+    QCOMPARE(followers.at(1).requestId, qint64(3));
+    QCOMPARE(table.size(), 0);
+
+    // The key is free again: the next duplicate finds nothing to join
+    QVERIFY(!table.join(KEY, poll(5)));
+}
+
+void TestSingleFlightTable::testQueuedLeaderIsNotJoined()
+{
+    // A leader still waiting in the queue is superseded by the scheduler instead
+    SingleFlightTable table;
+    table.lead(KEY, 1, RequestPriority::Normal);
+    QVERIFY(!table.join(KEY, poll(2)));
+
+    // The newer poll leads; the superseded one is dropped without followers
+    table.lead(KEY, 2, RequestPriority::Normal);
+    QVERIFY(table.take(1).isEmpty());
+    QVERIFY(table.isLeader(2));
+
+    table.markDispatched(2);
+    QVERIFY(table.join(KEY, poll(3)));
+    QCOMPARE(table.take(2).size(), 1);
+}
+
+void TestSingleFlightTable::testExpiredLeaderReleasesNoFollowers()
+{
+    // Polls arriving while a stale leader waits in the queue lead on their own,
+    // so shedding the stale leader interrupts nobody else
+    SingleFlightTable table;
+    table.lead(KEY, 1, RequestPriority::Normal);
+    QVERIFY(!table.join(KEY, poll(2)));
+    table.lead(KEY, 2, RequestPriority::Normal);
+
+    QVERIFY(table.take(1).isEmpty());  // Deadline expired in the queue
+    QVERIFY(table.isLeader(2));
+
+    // The fresh poll still collects duplicates once it is sent
+    table.markDispatched(2);
+    QVERIFY(table.join(KEY, poll(3)));
+    QCOMPARE(table.take(2).size(), 1);
+}
+
+void TestSingleFlightTable::testHigherPriorityDoesNotWait()
+{
+    SingleFlightTable table;
+    table.lead(KEY, 1, RequestPriority::Normal);
+    table.markDispatched(1);
+
+    // More urgent than the read on the wire: it becomes a leader of its own
+    QVERIFY(!table.join(KEY, poll(2, RequestPriority::High)));
+    table.lead(KEY, 2, RequestPriority::High);
+    QCOMPARE(table.size(), 2);
+
+    // Until the urgent read is sent, duplicates wait in the queue
+    QVERIFY(!table.join(KEY, poll(3)));
+    table.markDispatched(2);
+    QVERIFY(table.join(KEY, poll(4)));
+    QVERIFY(table.join(KEY, poll(5, RequestPriority::High)));
+    QVERIFY(!table.join(KEY, poll(6, RequestPriority::Critical)));
+
+    QVERIFY(table.take(1).isEmpty());
+    QCOMPARE(table.take(2).size(), 2);
+}
+
+void TestSingleFlightTable::testNewLeaderKeepsOldFollowers()
+{
+    SingleFlightTable table;
+    table.lead(KEY, 1, RequestPriority::Normal);
+    table.markDispatched(1);
+    QVERIFY(table.join(KEY, poll(2)));
+
+    table.lead(KEY, 3, RequestPriority::High);
+    table.markDispatched(3);
+    QVERIFY(table.join(KEY, poll(4)));
+
+    // Each leader answers only the duplicates that joined it
+    QCOMPARE(table.take(1).size(), 1);
+    QVERIFY(table.isLeader(3));
+    QCOMPARE(table.take(3).at(0).requestId, qint64(4));
+
+    table.lead(KEY, 5, RequestPriority::Normal);
+    table.clear();
+    QCOMPARE(table.size(), 0);
+    QVERIFY(!table.isLeader(5));
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_SINGLE_FLIGHT_TABLE_H
+#define TEST_SINGLE_FLIGHT_TABLE_H
+
+#include <QtTest/QtTest>
+#include "../include/single_flight_table.h"
+
+class TestSingleFlightTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testJoinDispatchedLeader();
+    void testQueuedLeaderIsNotJoined();
+    void testExpiredLeaderReleasesNoFollowers();
+    void testHigherPriorityDoesNotWait();
+    void testNewLeaderKeepsOldFollowers();
+};
+
+#endif // TEST_SINGLE_FLIGHT_TABLE_H
@@ -12,16 +12,65 @@ TARGET = ModbusDriverTests
 SOURCES += \
     main.cpp \
     test_modbus_worker.cpp \
-    test_modbus_worker_manager.cpp
+    test_modbus_worker_manager.cpp \
+    test_modbus_request_scheduler.cpp \
+    test_modbus_submission_queue.cpp \
+    test_poll_timing_wheel.cpp \
+    test_poll_deadline_queue.cpp \
+    test_poll_plan.cpp \
+    test_poll_point_table.cpp \
+    test_consistent_hash_ring.cpp \
+    test_bounded_stage_queue.cpp \
+    test_pending_request_table.cpp \
+    test_block_decode_plan.cpp \
+    test_register_decode_kernels.cpp \
+    test_modbus_bit_buffer.cpp \
+    test_report_by_exception_filter.cpp \
+    test_single_flight_table.cpp \
+    test_modbus_tcp_engine.cpp \
+    test_modbus_manager_pipeline.cpp \
+    test_modbus_request_pacer.cpp
 
 # Test header files (these will generate MOC files automatically)
 HEADERS += \
     test_modbus_worker.h \
-    test_modbus_worker_manager.h
+    test_modbus_worker_manager.h \
+    test_modbus_request_scheduler.h \
+    test_modbus_submission_queue.h \
+    test_poll_timing_wheel.h \
+    test_poll_deadline_queue.h \
+    test_poll_plan.h \
+    test_poll_point_table.h \
+    test_consistent_hash_ring.h \
+    test_bounded_stage_queue.h \
+    test_pending_request_table.h \
+    test_block_decode_plan.h \
+    test_register_decode_kernels.h \
+    test_modbus_bit_buffer.h \
+    test_report_by_exception_filter.h \
+    test_single_flight_table.h \
+    test_modbus_tcp_engine.h \
+    test_modbus_manager_pipeline.h \
+    test_modbus_request_pacer.h
 
 # Include the main project source files for testing
 SOURCES += \
     ../src/modbusmanager.cpp \
+    ../src/modbus_tcp_engine.cpp \
+    ../src/modbus_request_pacer.cpp \
+    ../src/modbus_request_scheduler.cpp \
+    ../src/modbus_submission_queue.cpp \
+    ../src/poll_timing_wheel.cpp \
+    ../src/poll_deadline_queue.cpp \
+    ../src/poll_plan.cpp \
+    ../src/poll_point_table.cpp \
+    ../src/consistent_hash_ring.cpp \
+    ../src/pending_request_table.cpp \
+    ../src/block_decode_plan.cpp \
+    ../src/register_decode_kernels.cpp \
+    ../src/modbus_bit_buffer.cpp \
+    ../src/report_by_exception_filter.cpp \
+    ../src/single_flight_table.cpp \
     ../src/modbus_worker.cpp \
     ../src/modbus_worker_manager.cpp \
     ../src/scada_core_service.cpp \
@@ -30,6 +79,23 @@ SOURCES += \
 # Include the main project header files
 HEADERS += \
     ../include/modbusmanager.h \
+    ../include/modbus_tcp_engine.h \
+    ../include/modbus_request_pacer.h \
+    ../include/modbus_request_scheduler.h \
+    ../include/modbus_submission_queue.h \
+    ../include/poll_timing_wheel.h \
+    ../include/poll_deadline_queue.h \
+    ../include/poll_plan.h \
+    ../include/poll_point_table.h \
+    ../include/consistent_hash_ring.h \
+    ../include/bounded_stage_queue.h \
+    ../include/pending_request_table.h \
+    ../include/block_decode_plan.h \
+    ../include/register_byte_order.h \
+    ../include/register_decode_kernels.h \
+    ../include/modbus_bit_buffer.h \
+    ../include/report_by_exception_filter.h \
+    ../include/single_flight_table.h \
     ../include/modbus_worker.h \
     ../include/scada_core_service.h \
     ../include/connection_resilience_manager.h